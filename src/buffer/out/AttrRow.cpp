@@ -128,6 +128,16 @@ ATTR_ROW::const_iterator ATTR_ROW::cend() const noexcept
     return _data.cend();
 }
 
+// Routine Description:
+// - Gives access to the underlying run length encoded attributes, for callers
+//   that can process an entire run at once instead of going cell by cell.
+// Return Value:
+// - The attribute runs of this row, in column order.
+const ATTR_ROW::run_container& ATTR_ROW::Runs() const noexcept
+{
+    return _data.runs();
+}
+
 bool operator==(const ATTR_ROW& a, const ATTR_ROW& b) noexcept
 {
     return a._data == b._data;
@@ -29,6 +29,7 @@ class ATTR_ROW final
 
 public:
     using const_iterator = rle_vector::const_iterator;
+    using run_container = rle_vector::container;
 
     ATTR_ROW(uint16_t width, TextAttribute attr);
 
@@ -54,6 +55,8 @@ public:
     const_iterator cbegin() const noexcept;
     const_iterator cend() const noexcept;
 
+    const run_container& Runs() const noexcept;
+
     friend bool operator==(const ATTR_ROW& a, const ATTR_ROW& b) noexcept;
     friend class ROW;
 
@@ -43,6 +43,7 @@ size_t CharRow::size() const noexcept
 // - <none>
 void CharRow::Reset() noexcept
 {
+    _InvalidateCaches();
     for (auto& cell : _data)
     {
         cell.Reset();
@@ -59,6 +60,7 @@ void CharRow::Reset() noexcept
 {
     try
     {
+        _InvalidateCaches();
         const value_type insertVals;
         _data.resize(newSize, insertVals);
     }
@@ -69,6 +71,7 @@ void CharRow::Reset() noexcept
 
 typename CharRow::iterator CharRow::begin() noexcept
 {
+    _InvalidateCaches();
     return _data.begin();
 }
 
@@ -79,6 +82,7 @@ typename CharRow::const_iterator CharRow::cbegin() const noexcept
 
 typename CharRow::iterator CharRow::end() noexcept
 {
+    _InvalidateCaches();
     return _data.end();
 }
 
@@ -121,6 +125,7 @@ size_t CharRow::MeasureRight() const
 
 void CharRow::ClearCell(const size_t column)
 {
+    _InvalidateCaches();
     _data.at(column).Reset();
 }
 
@@ -163,6 +168,8 @@ const DbcsAttribute& CharRow::DbcsAttrAt(const size_t column) const
 // Note: will throw exception if column is out of bounds
 DbcsAttribute& CharRow::DbcsAttrAt(const size_t column)
 {
+    // The caller may be about to turn a glyph into a trailing half, or back.
+    _InvalidateCaches();
     return _data.at(column).DbcsAttr();
 }
 
@@ -175,6 +182,7 @@ DbcsAttribute& CharRow::DbcsAttrAt(const size_t column)
 // Note: will throw exception if column is out of bounds
 void CharRow::ClearGlyph(const size_t column)
 {
+    _InvalidateCaches();
     _data.at(column).EraseChars();
 }
 
@@ -201,6 +209,8 @@ const CharRow::reference CharRow::GlyphAt(const size_t column) const
 CharRow::reference CharRow::GlyphAt(const size_t column)
 {
     THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    // The caller may be about to write through the reference.
+    _InvalidateCaches();
     return { *this, column };
 }
 
@@ -208,19 +218,105 @@ std::wstring CharRow::GetText() const
 {
     std::wstring wstr;
     wstr.reserve(_data.size());
+    AppendText(wstr, 0, _data.size());
+    return wstr;
+}
+
+// Routine Description:
+// - Gets the text of the whole row, skipping the trailing halves of wide
+//   glyphs. The text is built on first use and cached until the row is
+//   modified, so scanning unchanged rows doesn't allocate.
+// Arguments:
+// - <none>
+// Return Value:
+// - the text of the row. The view is only valid until the row is modified.
+std::wstring_view CharRow::GetTextView() const
+{
+    if (!_textValid)
+    {
+        _UpdateText();
+    }
+    return _text;
+}
+
+// Routine Description:
+// - Gets the offset in the text of the row at which the given column starts.
+//   The trailing half of a wide glyph starts right after the glyph, so the
+//   text of the columns [left, right] is [GetTextOffset(left), GetTextOffset(right + 1)).
+// Arguments:
+// - column - the column. May be one past the last column.
+// Return Value:
+// - the offset into GetTextView()
+// - Note: will throw exception if column is out of bounds
+size_t CharRow::GetTextOffset(const size_t column) const
+{
+    THROW_HR_IF(E_INVALIDARG, column > _data.size());
+
+    if (!_textValid)
+    {
+        _UpdateText();
+    }
+    return _textOffsets.at(column);
+}
+
+// Routine Description:
+// - Appends the text of the columns [begin, end) to a string, skipping the
+//   trailing halves of wide glyphs, the same text GetTextView and
+//   GetTextOffset would give.
+// - This is for callers that read each row once, like copying a selection or
+//   a screen reader reading the whole buffer. It uses the cached text if there
+//   is one, but doesn't build it, so that all the rows read that way don't
+//   keep a second copy of their text until they're modified.
+// Arguments:
+// - text - the string to append to
+// - begin - the first column
+// - end - one past the last column
+// Return Value:
+// - <none>
+// - Note: will throw exception if a column is out of bounds
+void CharRow::AppendText(std::wstring& text, const size_t begin, const size_t end) const
+{
+    THROW_HR_IF(E_INVALIDARG, begin > end || end > _data.size());
+
+    if (_textValid)
+    {
+        const auto textBegin = _textOffsets.at(begin);
+        text.append(std::wstring_view{ _text }.substr(textBegin, _textOffsets.at(end) - textBegin));
+        return;
+    }
+
+    for (auto i = begin; i < end; ++i)
+    {
+        if (!DbcsAttrAt(i).IsTrailing())
+        {
+            text.append(std::wstring_view{ GlyphAt(i) });
+        }
+    }
+}
+
+// Routine Description:
+// - Builds the cached text of the row and the offset of each column in it.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CharRow::_UpdateText() const
+{
+    _text.clear();
+    _text.reserve(_data.size());
+    _textOffsets.resize(_data.size() + 1);
 
     for (size_t i = 0; i < _data.size(); ++i)
     {
-        const auto glyph = GlyphAt(i);
+        _textOffsets.at(i) = gsl::narrow<uint16_t>(_text.size());
         if (!DbcsAttrAt(i).IsTrailing())
         {
-            for (const auto wch : glyph)
-            {
-                wstr.push_back(wch);
-            }
+            _text.append(std::wstring_view{ GlyphAt(i) });
         }
     }
-    return wstr;
+    _textOffsets.at(_data.size()) = gsl::narrow<uint16_t>(_text.size());
+
+    _textValid = true;
 }
 
 // Method Description:
@@ -250,6 +346,144 @@ const DelimiterClass CharRow::DelimiterClassAt(const size_t column, const std::w
     }
 }
 
+// Method Description:
+// - get delimiter class for a position in the char row, using (and if needed
+//   building) the cached classes of the whole row
+// - used for double click selection and uia word navigation
+// Arguments:
+// - column: column to get text data for
+// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// - wordDelimitersId: identifies wordDelimiters, see TextBuffer::_GetWordDelimitersId
+// Return Value:
+// - the delimiter class for the given char
+const DelimiterClass CharRow::DelimiterClassAt(const size_t column, const std::wstring_view wordDelimiters, const uint32_t wordDelimitersId) const
+{
+    THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+
+    if (_wordClassesId != wordDelimitersId)
+    {
+        _UpdateWordClasses(wordDelimiters, wordDelimitersId);
+    }
+
+    const auto words = _wordClasses.size() / 2;
+    const auto bit = 1u << (column % 32);
+    if (_wordClasses.at(column / 32) & bit)
+    {
+        return DelimiterClass::RegularChar;
+    }
+    else if (_wordClasses.at(words + column / 32) & bit)
+    {
+        return DelimiterClass::DelimiterChar;
+    }
+    else
+    {
+        return DelimiterClass::ControlChar;
+    }
+}
+
+// Method Description:
+// - Finds the nearest cell, starting at the given column and moving in the
+//   given direction, that either is or isn't a RegularChar. This scans the
+//   cached classes of the row 32 cells at a time.
+// Arguments:
+// - column: the column to start searching at (inclusive)
+// - forward: true to search towards the right, false to search towards the left
+// - regularChar: true to find a RegularChar, false to find any other class
+// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// - wordDelimitersId: identifies wordDelimiters, see TextBuffer::_GetWordDelimitersId
+// Return Value:
+// - the column of the cell found, or nullopt if there is none in this row
+std::optional<size_t> CharRow::FindWordClass(const size_t column, const bool forward, const bool regularChar, const std::wstring_view wordDelimiters, const uint32_t wordDelimitersId) const
+{
+    THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+
+    if (_wordClassesId != wordDelimitersId)
+    {
+        _UpdateWordClasses(wordDelimiters, wordDelimitersId);
+    }
+
+    // Searching for anything but a RegularChar is a search for a cleared bit.
+    const uint32_t flip = regularChar ? 0 : ~0u;
+    const auto words = _wordClasses.size() / 2;
+    auto index = column / 32;
+    unsigned long bit;
+
+    if (forward)
+    {
+        auto word = (_wordClasses.at(index) ^ flip) & (~0u << (column % 32));
+        while (!_BitScanForward(&bit, word))
+        {
+            if (++index == words)
+            {
+                return std::nullopt;
+            }
+            word = _wordClasses.at(index) ^ flip;
+        }
+
+        // The padding bits past the end of the row are cleared, so searching
+        // for a cleared bit might have found one of those.
+        const size_t found = index * 32 + bit;
+        return found < _data.size() ? std::optional{ found } : std::nullopt;
+    }
+    else
+    {
+        auto word = (_wordClasses.at(index) ^ flip) & (~0u >> (31 - column % 32));
+        while (!_BitScanReverse(&bit, word))
+        {
+            if (index-- == 0)
+            {
+                return std::nullopt;
+            }
+            word = _wordClasses.at(index) ^ flip;
+        }
+        return index * 32 + bit;
+    }
+}
+
+// Method Description:
+// - Computes the delimiter class of every cell of the row and caches it.
+// Arguments:
+// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// - wordDelimitersId: identifies wordDelimiters, see TextBuffer::_GetWordDelimitersId
+// Return Value:
+// - <none>
+void CharRow::_UpdateWordClasses(const std::wstring_view wordDelimiters, const uint32_t wordDelimitersId) const
+{
+    const auto words = (_data.size() + 31) / 32;
+    _wordClasses.assign(words * 2, 0);
+
+    for (size_t column = 0; column < _data.size(); ++column)
+    {
+        const auto bit = 1u << (column % 32);
+        switch (DelimiterClassAt(column, wordDelimiters))
+        {
+        case DelimiterClass::RegularChar:
+            _wordClasses.at(column / 32) |= bit;
+            break;
+        case DelimiterClass::DelimiterChar:
+            _wordClasses.at(words + column / 32) |= bit;
+            break;
+        default:
+            break;
+        }
+    }
+
+    _wordClassesId = wordDelimitersId;
+}
+
+// Method Description:
+// - Discards the cached text and delimiter classes. This needs to be called
+//   whenever the glyphs of the row may change.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CharRow::_InvalidateCaches() noexcept
+{
+    _textValid = false;
+    _wordClassesId = 0;
+}
+
 UnicodeStorage& CharRow::GetUnicodeStorage() noexcept
 {
     return _pParent->GetUnicodeStorage();
@@ -66,11 +66,18 @@ public:
     void ClearGlyph(const size_t column);
 
     const DelimiterClass DelimiterClassAt(const size_t column, const std::wstring_view wordDelimiters) const;
+    const DelimiterClass DelimiterClassAt(const size_t column, const std::wstring_view wordDelimiters, const uint32_t wordDelimitersId) const;
+    std::optional<size_t> FindWordClass(const size_t column, const bool forward, const bool regularChar, const std::wstring_view wordDelimiters, const uint32_t wordDelimitersId) const;
 
     // working with glyphs
     const reference GlyphAt(const size_t column) const;
     reference GlyphAt(const size_t column);
 
+    // working with the text of the whole row
+    std::wstring_view GetTextView() const;
+    size_t GetTextOffset(const size_t column) const;
+    void AppendText(std::wstring& text, const size_t begin, const size_t end) const;
+
     // iterators
     iterator begin() noexcept;
     const_iterator cbegin() const noexcept;
@@ -94,12 +101,37 @@ private:
     void ClearCell(const size_t column);
     std::wstring GetText() const;
 
+    void _UpdateText() const;
+    void _UpdateWordClasses(const std::wstring_view wordDelimiters, const uint32_t wordDelimitersId) const;
+    void _InvalidateCaches() noexcept;
+
 protected:
     // storage for glyph data and dbcs attributes
     boost::container::small_vector<value_type, 120> _data;
 
     // ROW that this CharRow belongs to
     ROW* _pParent;
+
+    // The delimiter classes of all cells, cached for word navigation. The
+    // first half holds a bit per cell that is set for a RegularChar, the second
+    // half a bit per cell that is set for a DelimiterChar. They're valid as
+    // long as the row isn't modified and the same delimiters are used, which
+    // is what _wordClassesId tracks (0 means invalid).
+    mutable std::vector<uint32_t> _wordClasses;
+    mutable uint32_t _wordClassesId{ 0 };
+
+    // The text of the row, with the trailing halves of wide glyphs skipped,
+    // cached for scanning. _textOffsets holds the offset into _text at which
+    // each column (and one past the last column) starts. They're valid as
+    // long as the row isn't modified, which is what _textValid tracks.
+    // They're only built for callers that scan the row over and over, see
+    // GetTextView. Callers that read a row once use AppendText.
+    // A row is at most SHRT_MAX columns wide and the parser stores at most a
+    // surrogate pair per glyph, so the offsets fit into 16 bits. _UpdateText
+    // checks that anyway.
+    mutable std::wstring _text;
+    mutable std::vector<uint16_t> _textOffsets;
+    mutable bool _textValid{ false };
 };
 
 template<typename InputIt1, typename InputIt2>
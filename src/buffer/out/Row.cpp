@@ -196,3 +196,107 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
 
     return it;
 }
+
+// Routine Description:
+// - Copies a span of legacy CHAR_INFO cells into this row in one go.
+// - This is the bulk counterpart of WriteCells for WriteConsoleOutput: instead of
+//   building an OutputCellView per cell, the glyphs are stored directly and the
+//   attributes are committed once per run of identical values.
+// - Only plain single-width UCS-2 text is handled here. If any cell carries
+//   lead/trailing byte flags or a surrogate, nothing is written and the caller
+//   is expected to fall back to WriteCells, which knows how to deal with those.
+// Arguments:
+// - cells - the cells to write
+// - index - the column to start writing at
+// Return Value:
+// - true if the cells were written, false if the caller needs to use WriteCells instead.
+bool ROW::WriteCharInfos(const gsl::span<const CHAR_INFO> cells, const size_t index)
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+    THROW_HR_IF(E_INVALIDARG, cells.size() > _charRow.size() - index);
+
+    if (cells.empty())
+    {
+        return true;
+    }
+
+    const auto needsSlowPath = std::any_of(cells.begin(), cells.end(), [](const CHAR_INFO& ci) noexcept {
+        return WI_IsAnyFlagSet(ci.Attributes, COMMON_LVB_SBCSDBCS) ||
+               IS_HIGH_SURROGATE(ci.Char.UnicodeChar) ||
+               IS_LOW_SURROGATE(ci.Char.UnicodeChar);
+    });
+    if (needsSlowPath)
+    {
+        return false;
+    }
+
+    auto outIt = _charRow.begin() + index;
+    auto runStart = gsl::narrow<uint16_t>(index);
+    auto currentIndex = runStart;
+    auto runAttributes = cells.front().Attributes;
+
+    for (const auto& ci : cells)
+    {
+        // Replacing the whole cell resets its DbcsAttribute, which clears the
+        // glyph stored flag. Any UnicodeStorage entry for this column is no
+        // longer used after that, just like when GlyphAt() = ... stores a
+        // single character. The entry is left in the storage and is
+        // overwritten the next time a glyph is stored at this column.
+        *outIt = CharRowCell{ ci.Char.UnicodeChar, DbcsAttribute{} };
+        ++outIt;
+
+        if (ci.Attributes != runAttributes)
+        {
+            _attrRow.Replace(runStart, currentIndex, TextAttribute{ runAttributes });
+            runAttributes = ci.Attributes;
+            runStart = currentIndex;
+        }
+
+        ++currentIndex;
+    }
+
+    _attrRow.Replace(runStart, currentIndex, TextAttribute{ runAttributes });
+    return true;
+}
+
+// Routine Description:
+// - Copies a span of cells out of this row as legacy CHAR_INFOs.
+// - The legacy attributes are computed once per attribute run
+//   rather than once per cell.
+// Arguments:
+// - cells - the buffer to fill. Must not extend past the end of the row.
+// - index - the column to start reading at
+void ROW::ReadCharInfos(const gsl::span<CHAR_INFO> cells, const size_t index) const
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+    THROW_HR_IF(E_INVALIDARG, cells.size() > _charRow.size() - index);
+
+    auto outIt = cells.begin();
+    auto column = index;
+    size_t runEnd = 0;
+
+    for (const auto& run : _attrRow.Runs())
+    {
+        runEnd += run.length;
+        if (runEnd <= column)
+        {
+            continue;
+        }
+
+        const auto legacyAttributes = run.value.GetLegacyAttributes();
+        for (; column < runEnd && outIt < cells.end(); ++column, ++outIt)
+        {
+            const auto& cell = _charRow._data[column];
+            const auto& dbcsAttr = cell.DbcsAttr();
+
+            outIt->Char.UnicodeChar = dbcsAttr.IsGlyphStored() ? Utf16ToUcs2(_charRow.GlyphAt(column)) : cell.Char();
+            outIt->Attributes = legacyAttributes;
+            outIt->Attributes |= dbcsAttr.GeneratePublicApiAttributeFormat();
+        }
+
+        if (outIt == cells.end())
+        {
+            break;
+        }
+    }
+}
@@ -59,12 +59,16 @@ public:
 
     void ClearColumn(const size_t column);
     std::wstring GetText() const { return _charRow.GetText(); }
+    std::wstring_view GetTextView() const { return _charRow.GetTextView(); }
 
     UnicodeStorage& GetUnicodeStorage() noexcept;
     const UnicodeStorage& GetUnicodeStorage() const noexcept;
 
     OutputCellIterator WriteCells(OutputCellIterator it, const size_t index, const std::optional<bool> wrap = std::nullopt, std::optional<size_t> limitRight = std::nullopt);
 
+    bool WriteCharInfos(const gsl::span<const CHAR_INFO> cells, const size_t index);
+    void ReadCharInfos(const gsl::span<CHAR_INFO> cells, const size_t index) const;
+
 #ifdef UNIT_TESTING
     friend constexpr bool operator==(const ROW& a, const ROW& b) noexcept;
     friend class RowTests;
@@ -391,6 +391,46 @@ OutputCellIterator TextBuffer::WriteLine(const OutputCellIterator givenIt,
     return newIt;
 }
 
+// Routine Description:
+// - Writes one line of legacy CHAR_INFO cells to the output buffer, bypassing OutputCellIterator.
+// - See ROW::WriteCharInfos for which cells qualify for this.
+// Arguments:
+// - cells - The cells to write. They must fit into the row starting at target.
+// - target - Coordinate targeted within output buffer
+// Return Value:
+// - true if the cells were written.
+// - false if nothing was written and the caller should use WriteLine instead.
+bool TextBuffer::WriteCharInfoLine(const gsl::span<const CHAR_INFO> cells, const COORD target)
+{
+    if (!GetSize().IsInBounds(target))
+    {
+        return false;
+    }
+
+    ROW& row = GetRowByOffset(target.Y);
+    if (!row.WriteCharInfos(cells, target.X))
+    {
+        return false;
+    }
+
+    const Viewport paint = Viewport::FromDimensions(target, { gsl::narrow<SHORT>(cells.size()), 1 });
+    _NotifyPaint(paint);
+
+    return true;
+}
+
+// Routine Description:
+// - Reads one line of the output buffer into legacy CHAR_INFO cells, bypassing TextBufferCellIterator.
+// Arguments:
+// - cells - The cells to fill. They must fit into the row starting at source.
+// - source - Coordinate to start reading at
+void TextBuffer::ReadCharInfoLine(const gsl::span<CHAR_INFO> cells, const COORD source) const
+{
+    THROW_HR_IF(E_INVALIDARG, !GetSize().IsInBounds(source));
+
+    GetRowByOffset(source.Y).ReadCharInfos(cells, source.X);
+}
+
 //Routine Description:
 // - Inserts one codepoint into the buffer at the current cursor position and advances the cursor as appropriate.
 //Arguments:
@@ -1047,7 +1087,58 @@ Microsoft::Console::Render::IRenderTarget& TextBuffer::GetRenderTarget() noexcep
 // - the delimiter class for the given char
 const DelimiterClass TextBuffer::_GetDelimiterClassAt(const COORD pos, const std::wstring_view wordDelimiters) const
 {
-    return GetRowByOffset(pos.Y).GetCharRow().DelimiterClassAt(pos.X, wordDelimiters);
+    return GetRowByOffset(pos.Y).GetCharRow().DelimiterClassAt(pos.X, wordDelimiters, _GetWordDelimitersId(wordDelimiters));
+}
+
+// Method Description:
+// - Gets the id that rows cache their delimiter classes under for the given
+//   delimiters. Ids are unique across the process, so that rows copied
+//   between buffers can't mistake one set of delimiters for another.
+// Arguments:
+// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// Return Value:
+// - the (non-zero) id of the delimiters
+uint32_t TextBuffer::_GetWordDelimitersId(const std::wstring_view wordDelimiters) const
+{
+    static std::atomic<uint32_t> s_lastWordDelimitersId{ 0 };
+
+    if (_wordDelimitersId == 0 || wordDelimiters != _wordDelimiters)
+    {
+        _wordDelimiters = wordDelimiters;
+        _wordDelimitersId = ++s_lastWordDelimitersId;
+    }
+    return _wordDelimitersId;
+}
+
+// Method Description:
+// - Moves pos to the nearest cell, starting at pos itself and walking the
+//   buffer in the given direction across row boundaries, that either is or
+//   isn't a RegularChar. Whole rows are skipped using the cached delimiter
+//   classes of each row.
+// Arguments:
+// - pos: the position to start searching at (inclusive). Updated to the cell found.
+// - forward: true to search towards the end of the buffer, false to search towards the origin
+// - regularChar: true to find a RegularChar, false to find any other class
+// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// Return Value:
+// - true if a cell was found. Otherwise pos is left unchanged.
+bool TextBuffer::_FindWordClass(COORD& pos, const bool forward, const bool regularChar, const std::wstring_view wordDelimiters) const
+{
+    const auto bufferSize = GetSize();
+    const auto wordDelimitersId = _GetWordDelimitersId(wordDelimiters);
+
+    size_t column = pos.X;
+    for (int row = pos.Y; row >= bufferSize.Top() && row <= bufferSize.BottomInclusive(); row += forward ? 1 : -1)
+    {
+        const auto& charRow = GetRowByOffset(row).GetCharRow();
+        if (const auto found = charRow.FindWordClass(column, forward, regularChar, wordDelimiters, wordDelimitersId))
+        {
+            pos = { gsl::narrow<SHORT>(*found), gsl::narrow<SHORT>(row) };
+            return true;
+        }
+        column = forward ? bufferSize.Left() : bufferSize.RightInclusive();
+    }
+    return false;
 }
 
 // Method Description:
@@ -1109,37 +1200,25 @@ const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const
 {
     COORD result = target;
     const auto bufferSize = GetSize();
-    bool stayAtOrigin = false;
 
     // ignore left boundary. Continue until readable text found
-    while (_GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+    if (!_FindWordClass(result, false, true, wordDelimiters))
     {
-        if (!bufferSize.DecrementInBounds(result))
-        {
-            // first char in buffer is a DelimiterChar or ControlChar
-            // we can't move any further back
-            stayAtOrigin = true;
-            break;
-        }
+        // there's nothing but DelimiterChars or ControlChars before us
+        // we can't move any further back
+        return bufferSize.Origin();
     }
 
     // make sure we expand to the left boundary or the beginning of the word
-    while (_GetDelimiterClassAt(result, wordDelimiters) == DelimiterClass::RegularChar)
+    if (!_FindWordClass(result, false, false, wordDelimiters))
     {
-        if (!bufferSize.DecrementInBounds(result))
-        {
-            // first char in buffer is a RegularChar
-            // we can't move any further back
-            break;
-        }
+        // the word starts at the first char in the buffer
+        // we can't move any further back
+        return bufferSize.Origin();
     }
 
     // move off of delimiter and onto word start
-    if (!stayAtOrigin && _GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
-    {
-        bufferSize.IncrementInBounds(result);
-    }
-
+    bufferSize.IncrementInBounds(result);
     return result;
 }
 
@@ -1231,12 +1310,10 @@ const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const st
     }
 
     // ignore right boundary. Continue through readable text found
-    while (_GetDelimiterClassAt(result, wordDelimiters) == DelimiterClass::RegularChar)
+    if (!_FindWordClass(result, true, false, wordDelimiters))
     {
-        if (!bufferSize.IncrementInBounds(result, true))
-        {
-            break;
-        }
+        // the readable text runs up to the end of the buffer
+        return bufferSize.EndExclusive();
     }
 
     // we are already on/past the last RegularChar
@@ -1246,15 +1323,10 @@ const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const st
     }
 
     // make sure we expand to the beginning of the NEXT word
-    while (_GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+    if (!_FindWordClass(result, true, true, wordDelimiters))
     {
-        if (!bufferSize.IncrementInBounds(result, true))
-        {
-            // we are at the EndInclusive COORD
-            // this signifies that we must include the last char in the buffer
-            // but the position of the COORD points to nothing
-            break;
-        }
+        // there's no readable text left in the buffer
+        return bufferSize.EndExclusive();
     }
 
     return result;
@@ -1519,35 +1591,54 @@ const std::vector<SMALL_RECT> TextBuffer::GetTextRects(COORD start, COORD end, b
     textRects.reserve(textRectSize);
     for (auto row = higherCoord.Y; row <= lowerCoord.Y; row++)
     {
-        SMALL_RECT textRow;
+        textRects.emplace_back(_GetTextRect(row, higherCoord, lowerCoord, blockSelection, bufferCoordinates));
+    }
 
-        textRow.Top = row;
-        textRow.Bottom = row;
+    return textRects;
+}
 
-        if (blockSelection || higherCoord.Y == lowerCoord.Y)
-        {
-            // set the left and right margin to the left-/right-most respectively
-            textRow.Left = std::min(higherCoord.X, lowerCoord.X);
-            textRow.Right = std::max(higherCoord.X, lowerCoord.X);
-        }
-        else
-        {
-            textRow.Left = (row == higherCoord.Y) ? higherCoord.X : bufferSize.Left();
-            textRow.Right = (row == lowerCoord.Y) ? lowerCoord.X : bufferSize.RightInclusive();
-        }
+// Method Description:
+// - Computes the region of a single row that is covered by the range between
+//   the given (ordered) coordinates. This is one entry of GetTextRects.
+// Arguments:
+// - row: the row to compute the region of
+// - higherCoord: the physically higher end of the range
+// - lowerCoord: the physically lower end of the range
+// - blockSelection: when enabled, the range is rectangular
+// - bufferCoordinates: when enabled, treat the coordinates as relative to
+//                      the buffer rather than the screen.
+// Return Value:
+// - the inclusive region of the row covered by the range
+SMALL_RECT TextBuffer::_GetTextRect(const SHORT row, const COORD higherCoord, const COORD lowerCoord, const bool blockSelection, const bool bufferCoordinates) const
+{
+    const auto bufferSize = GetSize();
 
-        // If we were passed screen coordinates, convert the given range into
-        // equivalent buffer offsets, taking line rendition into account.
-        if (!bufferCoordinates)
-        {
-            textRow = ScreenToBufferLine(textRow, GetLineRendition(row));
-        }
+    SMALL_RECT textRow;
+
+    textRow.Top = row;
+    textRow.Bottom = row;
+
+    if (blockSelection || higherCoord.Y == lowerCoord.Y)
+    {
+        // set the left and right margin to the left-/right-most respectively
+        textRow.Left = std::min(higherCoord.X, lowerCoord.X);
+        textRow.Right = std::max(higherCoord.X, lowerCoord.X);
+    }
+    else
+    {
+        textRow.Left = (row == higherCoord.Y) ? higherCoord.X : bufferSize.Left();
+        textRow.Right = (row == lowerCoord.Y) ? lowerCoord.X : bufferSize.RightInclusive();
+    }
 
-        _ExpandTextRow(textRow);
-        textRects.emplace_back(textRow);
+    // If we were passed screen coordinates, convert the given range into
+    // equivalent buffer offsets, taking line rendition into account.
+    if (!bufferCoordinates)
+    {
+        textRow = ScreenToBufferLine(textRow, GetLineRendition(row));
     }
 
-    return textRects;
+    _ExpandTextRow(textRow);
+    return textRow;
 }
 
 // Method Description:
@@ -1592,8 +1683,433 @@ void TextBuffer::_ExpandTextRow(SMALL_RECT& textRow) const
     }
 }
 
+namespace
+{
+    using TextRun = TextBuffer::TextRun;
+    using AttributeColorsFunction = std::function<std::pair<COLORREF, COLORREF>(const TextAttribute&)>;
+
+    // Routine Description:
+    // - Appends the text of the given columns of a row, skipping the trailing
+    //   halves of wide glyphs. When runs are requested, the runs of the text
+    //   are appended too, looking up the colors only once per attribute run.
+    // Arguments:
+    // - row - the row to read from
+    // - left - the first column to read (inclusive)
+    // - right - the last column to read (inclusive)
+    // - text - the string to append the text to
+    // - runs - if not null, the runs to append the runs of the text to
+    // - GetAttributeColors - function used to map TextAttribute to RGB COLORREFs
+    // Return Value:
+    // - <none>
+    void _AppendRowText(const ROW& row,
+                        const size_t left,
+                        const size_t right,
+                        std::wstring& text,
+                        std::vector<TextRun>* const runs,
+                        const AttributeColorsFunction& GetAttributeColors)
+    {
+        const auto& charRow = row.GetCharRow();
+
+        size_t runBegin = 0;
+        for (const auto& attrRun : row.GetAttrRow().Runs())
+        {
+            const size_t runEnd = runBegin + attrRun.length;
+            const auto begin = std::max(runBegin, left);
+            const auto end = std::min(runEnd, right + 1);
+            runBegin = runEnd;
+
+            if (begin < end)
+            {
+                const auto textBegin = text.size();
+                charRow.AppendText(text, begin, end);
+                const auto length = text.size() - textBegin;
+
+                if (runs && length != 0)
+                {
+                    const auto [foreground, background] = GetAttributeColors(attrRun.value);
+                    const auto flags = attrRun.value.GetExtendedAttributes();
+                    if (!runs->empty() && runs->back().foreground == foreground && runs->back().background == background && runs->back().flags == flags)
+                    {
+                        runs->back().length += length;
+                    }
+                    else
+                    {
+                        runs->push_back({ length, foreground, background, flags });
+                    }
+                }
+            }
+
+            if (runEnd > right)
+            {
+                break;
+            }
+        }
+    }
+
+    // Routine Description:
+    // - Removes the spaces at the end of a row's text, and shortens its runs
+    //   to match.
+    // Arguments:
+    // - text - the text to trim
+    // - runs - if not null, the runs of the text
+    // Return Value:
+    // - <none>
+    void _TrimTrailingWhitespace(std::wstring& text, std::vector<TextRun>* const runs)
+    {
+        const auto lastNonSpace = text.find_last_not_of(UNICODE_SPACE);
+        text.resize(lastNonSpace == std::wstring::npos ? 0 : lastNonSpace + 1);
+
+        if (runs)
+        {
+            size_t offset = 0;
+            auto it = runs->begin();
+            while (it != runs->end() && offset < text.size())
+            {
+                offset += it->length;
+                ++it;
+            }
+            runs->erase(it, runs->end());
+
+            if (offset > text.size())
+            {
+                runs->back().length -= offset - text.size();
+            }
+        }
+    }
+
+    // Routine Description:
+    // - Calls func with each run of a row's text and the text it covers, up to
+    //   the first line break. \r and \n don't have color attributes and aren't
+    //   HTML nor RTF friendly, so rich text formats use their own line breaks.
+    // Arguments:
+    // - text - the text of the row
+    // - runs - the runs of the text
+    // - func - called with the text of the run and the run
+    // Return Value:
+    // - <none>
+    template<typename TFunc>
+    void _ForEachRichTextRun(const std::wstring_view text, const std::vector<TextRun>& runs, TFunc func)
+    {
+        const auto richLength = std::min(text.find_first_of(L"\r\n"), text.size());
+
+        size_t offset = 0;
+        for (const auto& run : runs)
+        {
+            if (offset >= richLength)
+            {
+                break;
+            }
+
+            func(text.substr(offset, std::min(run.length, richLength - offset)), run);
+            offset += run.length;
+        }
+    }
+
+    // Routine Description:
+    // - Appends the UTF-8 encoding of the given text to a string, replacing
+    //   the ASCII characters that the format requires to be escaped.
+    // Arguments:
+    // - out - the string to append to
+    // - text - the text to encode
+    // - escape - returns the escape sequence for an ASCII character, or an
+    //   empty string if the character can be used as is
+    // Return Value:
+    // - <none>
+    template<typename TEscape>
+    void _AppendUtf8(std::string& out, const std::wstring_view text, TEscape escape)
+    {
+        size_t begin = 0;
+        while (begin < text.size())
+        {
+            if (text.at(begin) < 0x80)
+            {
+                const auto ch = gsl::narrow_cast<char>(text.at(begin));
+                const std::string_view escaped = escape(ch);
+                if (escaped.empty())
+                {
+                    out.push_back(ch);
+                }
+                else
+                {
+                    out.append(escaped);
+                }
+                begin++;
+                continue;
+            }
+
+            // Convert the whole stretch of non-ASCII text at once, straight
+            // into the output. Each UTF-16 code unit takes at most 3 bytes.
+            auto end = begin + 1;
+            while (end < text.size() && text.at(end) >= 0x80)
+            {
+                end++;
+            }
+
+            const auto chunk = text.substr(begin, end - begin);
+            const auto chunkLength = gsl::narrow<int>(chunk.size());
+            const auto capacity = base::CheckMul(chunkLength, 3).ValueOrDie();
+            const auto offset = out.size();
+            out.resize(offset + capacity);
+            const auto written = WideCharToMultiByte(CP_UTF8, 0, chunk.data(), chunkLength, out.data() + offset, capacity, nullptr, nullptr);
+            THROW_LAST_ERROR_IF(written == 0);
+            out.resize(offset + written);
+
+            begin = end;
+        }
+    }
+
+    std::string_view _EscapeNothing(const char) noexcept
+    {
+        return {};
+    }
+
+    std::string_view _EscapeHTML(const char ch) noexcept
+    {
+        switch (ch)
+        {
+        case '<':
+            return "&lt;";
+        case '>':
+            return "&gt;";
+        case '&':
+            return "&amp;";
+        default:
+            return {};
+        }
+    }
+
+    std::string_view _EscapeRTF(const char ch) noexcept
+    {
+        switch (ch)
+        {
+        case '\\':
+            return "\\\\";
+        case '{':
+            return "\\{";
+        case '}':
+            return "\\}";
+        default:
+            return {};
+        }
+    }
+
+    // Writes a CF_HTML document into a string, one row at a time.
+    class HTMLWriter
+    {
+    public:
+        HTMLWriter(std::string& out,
+                   const int fontHeightPoints,
+                   const std::wstring_view fontFaceName,
+                   const COLORREF backgroundColor) :
+            _out{ out }
+        {
+            // The CF_HTML header holds the byte offsets of the parts of the
+            // document, which are only known at the very end. Its size is
+            // fixed though, so we leave room for it and fill it in in Finish.
+            _out.append(ClipboardHeaderSize, '0');
+
+            // First we have to add some standard
+            // HTML boiler plate required for CF_HTML
+            // as part of the HTML Clipboard format
+            _out.append(HtmlHeader);
+            _out.append("<!--StartFragment -->");
+
+            // apply global style in div element
+            _out.append("<DIV STYLE=\"display:inline-block;white-space:pre;background-color:");
+            _out.append(Utils::ColorToHexString(backgroundColor));
+            _out.append(";font-family:'");
+            _AppendUtf8(_out, fontFaceName, _EscapeNothing);
+            // even with different font, add monospace as fallback
+            _out.append("',monospace;font-size:");
+            _out.append(std::to_string(fontHeightPoints));
+            // note: MS Word doesn't support padding (in this way at least)
+            _out.append("pt;padding:4px;\">"); // todo: customizable padding
+        }
+
+        void AppendRow(const std::wstring_view text, const std::vector<TextRun>& runs)
+        {
+            if (_hasRows)
+            {
+                _out.append("<BR>");
+            }
+            _hasRows = true;
+
+            _ForEachRichTextRun(text, runs, [&](const std::wstring_view runText, const TextRun& run) {
+                if (!_colors.has_value() || _colors->first != run.foreground || _colors->second != run.background)
+                {
+                    if (_colors.has_value())
+                    {
+                        _out.append("</SPAN>");
+                    }
+
+                    _out.append("<SPAN STYLE=\"color:");
+                    _out.append(Utils::ColorToHexString(run.foreground));
+                    _out.append(";background-color:");
+                    _out.append(Utils::ColorToHexString(run.background));
+                    _out.append(";\">");
+                    _colors = { run.foreground, run.background };
+                }
+
+                _AppendUtf8(_out, runText, _EscapeHTML);
+            });
+        }
+
+        void Finish()
+        {
+            if (_colors.has_value())
+            {
+                // last opened span wasn't closed in AppendRow, so close it now
+                _out.append("</SPAN>");
+            }
+
+            _out.append("</DIV>");
+            _out.append("<!--EndFragment -->");
+            _out.append(HtmlFooter);
+
+            // these values are byte offsets from start of clipboard
+            const size_t htmlStartPos = ClipboardHeaderSize;
+            const size_t htmlEndPos = _out.size();
+            const size_t fragStartPos = ClipboardHeaderSize + HtmlHeader.size();
+            const size_t fragEndPos = htmlEndPos - HtmlFooter.size();
+
+            // header required by HTML 0.9 format
+            std::string clipHeader;
+            const auto appendOffset = [&](const std::string_view name, const size_t value) {
+                const auto digits = std::to_string(value);
+                clipHeader.append(name);
+                clipHeader.append(digits.size() < 10 ? 10 - digits.size() : 0, '0');
+                clipHeader.append(digits);
+                clipHeader.append("\r\n");
+            };
+            clipHeader.append("Version:0.9\r\n");
+            appendOffset("StartHTML:", htmlStartPos);
+            appendOffset("EndHTML:", htmlEndPos);
+            appendOffset("StartFragment:", fragStartPos);
+            appendOffset("EndFragment:", fragEndPos);
+            appendOffset("StartSelection:", fragStartPos);
+            appendOffset("EndSelection:", fragEndPos);
+
+            THROW_HR_IF(E_UNEXPECTED, clipHeader.size() != ClipboardHeaderSize);
+            _out.replace(0, ClipboardHeaderSize, clipHeader);
+        }
+
+    private:
+        // once filled with values, there will be exactly 157 bytes in the clipboard header
+        static constexpr size_t ClipboardHeaderSize = 157;
+        static constexpr std::string_view HtmlHeader = "<!DOCTYPE><HTML><HEAD></HEAD><BODY>";
+        static constexpr std::string_view HtmlFooter = "</BODY></HTML>";
+
+        std::string& _out;
+        std::optional<std::pair<COLORREF, COLORREF>> _colors;
+        bool _hasRows{ false };
+    };
+
+    // Writes an RTF document into a string, one row at a time.
+    // RTF 1.5 Spec: https://www.biblioscape.com/rtf15_spec.htm
+    class RTFWriter
+    {
+    public:
+        RTFWriter(std::string& out,
+                  const int fontHeightPoints,
+                  const std::wstring_view fontFaceName,
+                  const COLORREF backgroundColor) :
+            _out{ out },
+            _fontFaceName{ fontFaceName }
+        {
+            // The color table is only complete at the very end, so the
+            // content goes first and the header is put in front of it in Finish.
+            _GetColorIndex(backgroundColor);
+
+            _out.append("\\viewkind4\\uc4");
+
+            // paragraph styles
+            // \fs specifies font size in half-points i.e. \fs20 results in a font size
+            // of 10 pts. That's why, font size is multiplied by 2 here.
+            _out.append("\\pard\\slmult1\\f0\\fs");
+            _out.append(std::to_string(2 * fontHeightPoints));
+            _out.append("\\highlight1 ");
+        }
+
+        void AppendRow(const std::wstring_view text, const std::vector<TextRun>& runs)
+        {
+            if (_hasRows)
+            {
+                _out.append("\\line "); // new line
+            }
+            _hasRows = true;
+
+            _ForEachRichTextRun(text, runs, [&](const std::wstring_view runText, const TextRun& run) {
+                if (!_colors.has_value() || _colors->first != run.foreground || _colors->second != run.background)
+                {
+                    const auto bkColorIndex = _GetColorIndex(run.background);
+                    const auto fgColorIndex = _GetColorIndex(run.foreground);
+                    _out.append("\\highlight").append(std::to_string(bkColorIndex));
+                    _out.append("\\cf").append(std::to_string(fgColorIndex));
+                    _out.push_back(' ');
+                    _colors = { run.foreground, run.background };
+                }
+
+                _AppendUtf8(_out, runText, _EscapeRTF);
+            });
+        }
+
+        void Finish()
+        {
+            // Standard RTF header.
+            // This is similar to the header generated by WordPad.
+            // \ansi - specifies that the ANSI char set is used in the current doc
+            // \ansicpg1252 - represents the ANSI code page which is used to perform the Unicode to ANSI conversion when writing RTF text
+            // \deff0 - specifies that the default font for the document is the one at index 0 in the font table
+            // \nouicompat - ?
+            std::string header = "{\\rtf1\\ansi\\ansicpg1252\\deff0\\nouicompat";
+
+            // font table
+            header.append("{\\fonttbl{\\f0\\fmodern\\fcharset0 ");
+            _AppendUtf8(header, _fontFaceName, _EscapeNothing);
+            header.append(";}}");
+
+            // RTF color table
+            header.append("{\\colortbl ;");
+            header.append(_colorTable);
+            header.append("}");
+
+            _out.insert(0, header);
+
+            // end rtf
+            _out.push_back('}');
+        }
+
+    private:
+        // Returns the index of the color in the color table, adding it if needed.
+        int _GetColorIndex(const COLORREF color)
+        {
+            // leave 0 for the default color and start from 1.
+            const auto [it, inserted] = _colorMap.emplace(color, gsl::narrow<int>(_colorMap.size() + 1));
+            if (inserted)
+            {
+                _colorTable.append("\\red").append(std::to_string(GetRValue(color)));
+                _colorTable.append("\\green").append(std::to_string(GetGValue(color)));
+                _colorTable.append("\\blue").append(std::to_string(GetBValue(color)));
+                _colorTable.push_back(';');
+            }
+            return it->second;
+        }
+
+        std::string& _out;
+        std::wstring_view _fontFaceName;
+        // keys are colors represented by COLORREF
+        // values are indices of the corresponding colors in the color table
+        std::unordered_map<COLORREF, int> _colorMap;
+        std::string _colorTable;
+        std::optional<std::pair<COLORREF, COLORREF>> _colors;
+        bool _hasRows{ false };
+    };
+}
+
 // Routine Description:
 // - Retrieves the text data from the selected region and presents it in a clipboard-ready format (given little post-processing).
+// - The colors are collected per run of text with the same attributes, so
+//   GetAttributeColors is called once per run rather than once per cell.
 // Arguments:
 // - includeCRLF - inject CRLF pairs to the end of each line
 // - trimTrailingWhitespace - remove the trailing whitespace at the end of each line
@@ -1601,7 +2117,7 @@ void TextBuffer::_ExpandTextRow(SMALL_RECT& textRow) const
 // - GetAttributeColors - function used to map TextAttribute to RGB COLORREFs. If null, only extract the text.
 // - formatWrappedRows - if set we will apply formatting (CRLF inclusion and whitespace trimming) on wrapped rows
 // Return Value:
-// - The text, background color, and foreground color data of the selected region of the text buffer.
+// - The text and the runs of colors of the selected region of the text buffer.
 const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
                                                    const bool trimTrailingWhitespace,
                                                    const std::vector<SMALL_RECT>& selectionRects,
@@ -1616,111 +2132,118 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
     data.text.reserve(rows);
     if (copyTextColor)
     {
-        data.FgAttr.reserve(rows);
-        data.BkAttr.reserve(rows);
+        data.runs.reserve(rows);
     }
 
     // for each row in the selection
-    for (UINT i = 0; i < rows; i++)
+    for (size_t i = 0; i < rows; i++)
     {
-        const UINT iRow = selectionRects.at(i).Top;
-
-        const Viewport highlight = Viewport::FromInclusive(selectionRects.at(i));
+        const auto& selectionRect = selectionRects.at(i);
+        const auto& row = GetRowByOffset(selectionRect.Top);
 
-        // retrieve the data from the screen buffer
-        auto it = GetCellDataAt(highlight.Origin(), highlight);
-
-        // allocate a string buffer
         std::wstring selectionText;
-        std::vector<COLORREF> selectionFgAttr;
-        std::vector<COLORREF> selectionBkAttr;
+        std::vector<TextRun> selectionRuns;
 
         // preallocate to avoid reallocs
-        selectionText.reserve(gsl::narrow<size_t>(highlight.Width()) + 2); // + 2 for \r\n if we munged it
-        if (copyTextColor)
-        {
-            selectionFgAttr.reserve(gsl::narrow<size_t>(highlight.Width()) + 2);
-            selectionBkAttr.reserve(gsl::narrow<size_t>(highlight.Width()) + 2);
-        }
+        selectionText.reserve(gsl::narrow<size_t>(selectionRect.Right - selectionRect.Left + 1) + 2); // + 2 for \r\n if we munged it
 
         // copy char data into the string buffer, skipping trailing bytes
-        while (it)
-        {
-            const auto& cell = *it;
-
-            if (!cell.DbcsAttr().IsTrailing())
-            {
-                selectionText.append(cell.Chars());
-
-                if (copyTextColor)
-                {
-                    const auto cellData = cell.TextAttr();
-                    const auto [CellFgAttr, CellBkAttr] = GetAttributeColors(cellData);
-                    for (const wchar_t wch : cell.Chars())
-                    {
-                        selectionFgAttr.push_back(CellFgAttr);
-                        selectionBkAttr.push_back(CellBkAttr);
-                    }
-                }
-            }
-#pragma warning(suppress : 26444)
-            // TODO GH 2675: figure out why there's custom construction/destruction happening here
-            it++;
-        }
+        _AppendRowText(row,
+                       gsl::narrow<size_t>(selectionRect.Left),
+                       gsl::narrow<size_t>(selectionRect.Right),
+                       selectionText,
+                       copyTextColor ? &selectionRuns : nullptr,
+                       GetAttributeColors);
 
         // We apply formatting to rows if the row was NOT wrapped or formatting of wrapped rows is allowed
-        const bool shouldFormatRow = formatWrappedRows || !GetRowByOffset(iRow).WasWrapForced();
+        const bool shouldFormatRow = formatWrappedRows || !row.WasWrapForced();
 
-        if (trimTrailingWhitespace)
+        if (trimTrailingWhitespace && shouldFormatRow)
         {
-            if (shouldFormatRow)
-            {
-                // remove the spaces at the end (aka trim the trailing whitespace)
-                while (!selectionText.empty() && selectionText.back() == UNICODE_SPACE)
-                {
-                    selectionText.pop_back();
-                    if (copyTextColor)
-                    {
-                        selectionFgAttr.pop_back();
-                        selectionBkAttr.pop_back();
-                    }
-                }
-            }
+            // remove the spaces at the end (aka trim the trailing whitespace)
+            _TrimTrailingWhitespace(selectionText, copyTextColor ? &selectionRuns : nullptr);
         }
 
         // apply CR/LF to the end of the final string, unless we're the last line.
         // a.k.a if we're earlier than the bottom, then apply CR/LF.
-        if (includeCRLF && i < selectionRects.size() - 1)
+        if (includeCRLF && i < rows - 1 && shouldFormatRow)
         {
-            if (shouldFormatRow)
-            {
-                // then we can assume a CR/LF is proper
-                selectionText.push_back(UNICODE_CARRIAGERETURN);
-                selectionText.push_back(UNICODE_LINEFEED);
+            // then we can assume a CR/LF is proper
+            selectionText.push_back(UNICODE_CARRIAGERETURN);
+            selectionText.push_back(UNICODE_LINEFEED);
 
-                if (copyTextColor)
-                {
-                    // cant see CR/LF so just use black FG & BK
-                    COLORREF const Blackness = RGB(0x00, 0x00, 0x00);
-                    selectionFgAttr.push_back(Blackness);
-                    selectionFgAttr.push_back(Blackness);
-                    selectionBkAttr.push_back(Blackness);
-                    selectionBkAttr.push_back(Blackness);
-                }
+            if (copyTextColor)
+            {
+                // cant see CR/LF so just use black FG & BK
+                COLORREF const Blackness = RGB(0x00, 0x00, 0x00);
+                selectionRuns.push_back({ 2, Blackness, Blackness, ExtendedAttributes::Normal });
             }
         }
 
         data.text.emplace_back(std::move(selectionText));
         if (copyTextColor)
         {
-            data.FgAttr.emplace_back(std::move(selectionFgAttr));
-            data.BkAttr.emplace_back(std::move(selectionBkAttr));
+            data.runs.emplace_back(std::move(selectionRuns));
         }
     }
 
     return data;
 }
 
+// Routine Description:
+// - Retrieves the plain text of the range between the given coordinates, like
+//   GetText(true, false, GetTextRects(...)) would, but streams it straight out
+//   of the rows into a single string, and stops once maxLength characters have
+//   been produced. This keeps requests for the beginning of a huge range (like
+//   the ones screen readers make) from materializing the whole range.
+// Arguments:
+// - start: one end of the range (inclusive)
+// - end: the other end of the range (inclusive)
+// - blockSelection: when enabled, the range is rectangular
+// - bufferCoordinates: when enabled, treat the coordinates as relative to
+//                      the buffer rather than the screen.
+// - maxLength: the maximum number of characters to return
+// Return Value:
+// - the text of the range, with CR/LF between rows that weren't wrapped
+std::wstring TextBuffer::GetPlainText(const COORD start, const COORD end, const bool blockSelection, const bool bufferCoordinates, const size_t maxLength) const
+{
+    std::wstring text;
+
+    const auto bufferSize = GetSize();
+    const auto [higherCoord, lowerCoord] = bufferSize.CompareInBounds(start, end) <= 0 ?
+                                               std::make_tuple(start, end) :
+                                               std::make_tuple(end, start);
+
+    const size_t rowCount = base::ClampedNumeric<size_t>(1) + lowerCoord.Y - higherCoord.Y;
+    text.reserve(std::min<size_t>(maxLength, base::ClampMul(rowCount, base::ClampAdd(bufferSize.Width(), 2))));
+
+    for (auto row = higherCoord.Y; row <= lowerCoord.Y && text.size() < maxLength; row++)
+    {
+        const auto textRow = _GetTextRect(row, higherCoord, lowerCoord, blockSelection, bufferCoordinates);
+        const auto& bufferRow = GetRowByOffset(row);
+        const auto& charRow = bufferRow.GetCharRow();
+
+        // copy char data into the string, skipping trailing bytes.
+        // This may go past maxLength, which is taken care of below.
+        charRow.AppendText(text, gsl::narrow_cast<size_t>(textRow.Left), gsl::narrow_cast<size_t>(textRow.Right) + 1);
+
+        // apply CR/LF to the end of every row but the last, unless it wrapped.
+        if (row < lowerCoord.Y && !bufferRow.WasWrapForced())
+        {
+            text.push_back(UNICODE_CARRIAGERETURN);
+            text.push_back(UNICODE_LINEFEED);
+        }
+    }
+
+    // The last row or line break may have taken us past the limit.
+    if (text.size() > maxLength)
+    {
+        text.resize(maxLength);
+    }
+
+    return text;
+}
+
 // Routine Description:
 // - Generates a CF_HTML compliant structure based on the passed in text and color data
 // Arguments:
@@ -1737,171 +2260,14 @@ std::string TextBuffer::GenHTML(const TextAndColor& rows,
 {
     try
     {
-        std::ostringstream htmlBuilder;
-
-        // First we have to add some standard
-        // HTML boiler plate required for CF_HTML
-        // as part of the HTML Clipboard format
-        const std::string htmlHeader =
-            "<!DOCTYPE><HTML><HEAD></HEAD><BODY>";
-        htmlBuilder << htmlHeader;
-
-        htmlBuilder << "<!--StartFragment -->";
-
-        // apply global style in div element
-        {
-            htmlBuilder << "<DIV STYLE=\"";
-            htmlBuilder << "display:inline-block;";
-            htmlBuilder << "white-space:pre;";
-
-            htmlBuilder << "background-color:";
-            htmlBuilder << Utils::ColorToHexString(backgroundColor);
-            htmlBuilder << ";";
-
-            htmlBuilder << "font-family:";
-            htmlBuilder << "'";
-            htmlBuilder << ConvertToA(CP_UTF8, fontFaceName);
-            htmlBuilder << "',";
-            // even with different font, add monospace as fallback
-            htmlBuilder << "monospace;";
-
-            htmlBuilder << "font-size:";
-            htmlBuilder << fontHeightPoints;
-            htmlBuilder << "pt;";
-
-            // note: MS Word doesn't support padding (in this way at least)
-            htmlBuilder << "padding:";
-            htmlBuilder << 4; // todo: customizable padding
-            htmlBuilder << "px;";
-
-            htmlBuilder << "\">";
-        }
-
-        // copy text and info color from buffer
-        bool hasWrittenAnyText = false;
-        std::optional<COLORREF> fgColor = std::nullopt;
-        std::optional<COLORREF> bkColor = std::nullopt;
+        std::string html;
+        HTMLWriter writer{ html, fontHeightPoints, fontFaceName, backgroundColor };
         for (size_t row = 0; row < rows.text.size(); row++)
         {
-            size_t startOffset = 0;
-
-            if (row != 0)
-            {
-                htmlBuilder << "<BR>";
-            }
-
-            for (size_t col = 0; col < rows.text.at(row).length(); col++)
-            {
-                const auto writeAccumulatedChars = [&](bool includeCurrent) {
-                    if (col >= startOffset)
-                    {
-                        const auto unescapedText = ConvertToA(CP_UTF8, std::wstring_view(rows.text.at(row)).substr(startOffset, col - startOffset + includeCurrent));
-                        for (const auto c : unescapedText)
-                        {
-                            switch (c)
-                            {
-                            case '<':
-                                htmlBuilder << "&lt;";
-                                break;
-                            case '>':
-                                htmlBuilder << "&gt;";
-                                break;
-                            case '&':
-                                htmlBuilder << "&amp;";
-                                break;
-                            default:
-                                htmlBuilder << c;
-                            }
-                        }
-
-                        startOffset = col;
-                    }
-                };
-
-                if (rows.text.at(row).at(col) == '\r' || rows.text.at(row).at(col) == '\n')
-                {
-                    // do not include \r nor \n as they don't have color attributes
-                    // and are not HTML friendly. For line break use '<BR>' instead.
-                    writeAccumulatedChars(false);
-                    break;
-                }
-
-                bool colorChanged = false;
-                if (!fgColor.has_value() || rows.FgAttr.at(row).at(col) != fgColor.value())
-                {
-                    fgColor = rows.FgAttr.at(row).at(col);
-                    colorChanged = true;
-                }
-
-                if (!bkColor.has_value() || rows.BkAttr.at(row).at(col) != bkColor.value())
-                {
-                    bkColor = rows.BkAttr.at(row).at(col);
-                    colorChanged = true;
-                }
-
-                if (colorChanged)
-                {
-                    writeAccumulatedChars(false);
-
-                    if (hasWrittenAnyText)
-                    {
-                        htmlBuilder << "</SPAN>";
-                    }
-
-                    htmlBuilder << "<SPAN STYLE=\"";
-                    htmlBuilder << "color:";
-                    htmlBuilder << Utils::ColorToHexString(fgColor.value());
-                    htmlBuilder << ";";
-                    htmlBuilder << "background-color:";
-                    htmlBuilder << Utils::ColorToHexString(bkColor.value());
-                    htmlBuilder << ";";
-                    htmlBuilder << "\">";
-                }
-
-                hasWrittenAnyText = true;
-
-                // if this is the last character in the row, flush the whole row
-                if (col == rows.text.at(row).length() - 1)
-                {
-                    writeAccumulatedChars(true);
-                }
-            }
-        }
-
-        if (hasWrittenAnyText)
-        {
-            // last opened span wasn't closed in loop above, so close it now
-            htmlBuilder << "</SPAN>";
+            writer.AppendRow(rows.text.at(row), rows.runs.at(row));
         }
-
-        htmlBuilder << "</DIV>";
-
-        htmlBuilder << "<!--EndFragment -->";
-
-        constexpr std::string_view HtmlFooter = "</BODY></HTML>";
-        htmlBuilder << HtmlFooter;
-
-        // once filled with values, there will be exactly 157 bytes in the clipboard header
-        constexpr size_t ClipboardHeaderSize = 157;
-
-        // these values are byte offsets from start of clipboard
-        const size_t htmlStartPos = ClipboardHeaderSize;
-        const size_t htmlEndPos = ClipboardHeaderSize + gsl::narrow<size_t>(htmlBuilder.tellp());
-        const size_t fragStartPos = ClipboardHeaderSize + gsl::narrow<size_t>(htmlHeader.length());
-        const size_t fragEndPos = htmlEndPos - HtmlFooter.length();
-
-        // header required by HTML 0.9 format
-        std::ostringstream clipHeaderBuilder;
-        clipHeaderBuilder << "Version:0.9\r\n";
-        clipHeaderBuilder << std::setfill('0');
-        clipHeaderBuilder << "StartHTML:" << std::setw(10) << htmlStartPos << "\r\n";
-        clipHeaderBuilder << "EndHTML:" << std::setw(10) << htmlEndPos << "\r\n";
-        clipHeaderBuilder << "StartFragment:" << std::setw(10) << fragStartPos << "\r\n";
-        clipHeaderBuilder << "EndFragment:" << std::setw(10) << fragEndPos << "\r\n";
-        clipHeaderBuilder << "StartSelection:" << std::setw(10) << fragStartPos << "\r\n";
-        clipHeaderBuilder << "EndSelection:" << std::setw(10) << fragEndPos << "\r\n";
-
-        return clipHeaderBuilder.str() + htmlBuilder.str();
+        writer.Finish();
+        return html;
     }
     catch (...)
     {
@@ -1918,181 +2284,138 @@ std::string TextBuffer::GenHTML(const TextAndColor& rows,
 // - backgroundColor - default background color for characters, also used in padding
 // - fontHeightPoints - the unscaled font height
 // - fontFaceName - the name of the font used
-// - htmlTitle - value used in title tag of html header. Used to name the application
 // Return Value:
 // - string containing the generated RTF
 std::string TextBuffer::GenRTF(const TextAndColor& rows, const int fontHeightPoints, const std::wstring_view fontFaceName, const COLORREF backgroundColor)
 {
     try
     {
-        std::ostringstream rtfBuilder;
-
-        // start rtf
-        rtfBuilder << "{";
-
-        // Standard RTF header.
-        // This is similar to the header generated by WordPad.
-        // \ansi - specifies that the ANSI char set is used in the current doc
-        // \ansicpg1252 - represents the ANSI code page which is used to perform the Unicode to ANSI conversion when writing RTF text
-        // \deff0 - specifies that the default font for the document is the one at index 0 in the font table
-        // \nouicompat - ?
-        rtfBuilder << "\\rtf1\\ansi\\ansicpg1252\\deff0\\nouicompat";
-
-        // font table
-        rtfBuilder << "{\\fonttbl{\\f0\\fmodern\\fcharset0 " << ConvertToA(CP_UTF8, fontFaceName) << ";}}";
-
-        // map to keep track of colors:
-        // keys are colors represented by COLORREF
-        // values are indices of the corresponding colors in the color table
-        std::unordered_map<COLORREF, int> colorMap;
-        int nextColorIndex = 1; // leave 0 for the default color and start from 1.
-
-        // RTF color table
-        std::ostringstream colorTableBuilder;
-        colorTableBuilder << "{\\colortbl ;";
-        colorTableBuilder << "\\red" << static_cast<int>(GetRValue(backgroundColor))
-                          << "\\green" << static_cast<int>(GetGValue(backgroundColor))
-                          << "\\blue" << static_cast<int>(GetBValue(backgroundColor))
-                          << ";";
-        colorMap[backgroundColor] = nextColorIndex++;
-
-        // content
-        std::ostringstream contentBuilder;
-        contentBuilder << "\\viewkind4\\uc4";
-
-        // paragraph styles
-        // \fs specifies font size in half-points i.e. \fs20 results in a font size
-        // of 10 pts. That's why, font size is multiplied by 2 here.
-        contentBuilder << "\\pard\\slmult1\\f0\\fs" << std::to_string(2 * fontHeightPoints)
-                       << "\\highlight1"
-                       << " ";
-
-        std::optional<COLORREF> fgColor = std::nullopt;
-        std::optional<COLORREF> bkColor = std::nullopt;
-        for (size_t row = 0; row < rows.text.size(); ++row)
+        std::string rtf;
+        RTFWriter writer{ rtf, fontHeightPoints, fontFaceName, backgroundColor };
+        for (size_t row = 0; row < rows.text.size(); row++)
         {
-            size_t startOffset = 0;
-
-            if (row != 0)
-            {
-                contentBuilder << "\\line "; // new line
-            }
-
-            for (size_t col = 0; col < rows.text.at(row).length(); ++col)
-            {
-                const auto writeAccumulatedChars = [&](bool includeCurrent) {
-                    if (col >= startOffset)
-                    {
-                        const auto unescapedText = ConvertToA(CP_UTF8, std::wstring_view(rows.text.at(row)).substr(startOffset, col - startOffset + includeCurrent));
-                        for (const auto c : unescapedText)
-                        {
-                            switch (c)
-                            {
-                            case '\\':
-                            case '{':
-                            case '}':
-                                contentBuilder << "\\" << c;
-                                break;
-                            default:
-                                contentBuilder << c;
-                            }
-                        }
+            writer.AppendRow(rows.text.at(row), rows.runs.at(row));
+        }
+        writer.Finish();
+        return rtf;
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return {};
+    }
+}
 
-                        startOffset = col;
-                    }
-                };
+// Routine Description:
+// - Serializes the selected region of the buffer into plain text and,
+//   optionally, CF_HTML and RTF documents, in a single pass over the rows.
+// - This produces the same output as GetText followed by GenHTML and GenRTF,
+//   but writes straight into the growing output strings. Only a single row
+//   is held in between, so copying huge selections doesn't build the text
+//   and runs of every row first.
+// - It only reads from the buffer, so it may run on any thread, as long as
+//   the caller keeps the buffer from being modified in the meantime.
+// Arguments:
+// - includeCRLF - inject CRLF pairs to the end of each line
+// - trimTrailingWhitespace - remove the trailing whitespace at the end of each line
+// - selectionRects - the rectangular regions from which the data will be extracted from the buffer
+// - GetAttributeColors - function used to map TextAttribute to RGB COLORREFs.
+//   If null, neither HTML nor RTF will be generated.
+// - formatWrappedRows - if set we will apply formatting (CRLF inclusion and whitespace trimming) on wrapped rows
+// - includeHTML - generate the CF_HTML document
+// - includeRTF - generate the RTF document
+// - fontHeightPoints - the unscaled font height
+// - fontFaceName - the name of the font used
+// - backgroundColor - default background color for characters, also used in padding
+// Return Value:
+// - The text of the selected region, and the requested rich text documents.
+// Note: may throw exception
+TextBuffer::ClipboardData TextBuffer::SerializeSelection(const bool includeCRLF,
+                                                         const bool trimTrailingWhitespace,
+                                                         const std::vector<SMALL_RECT>& selectionRects,
+                                                         std::function<std::pair<COLORREF, COLORREF>(const TextAttribute&)> GetAttributeColors,
+                                                         const bool formatWrappedRows,
+                                                         const bool includeHTML,
+                                                         const bool includeRTF,
+                                                         const int fontHeightPoints,
+                                                         const std::wstring_view fontFaceName,
+                                                         const COLORREF backgroundColor) const
+{
+    ClipboardData data;
 
-                if (rows.text.at(row).at(col) == '\r' || rows.text.at(row).at(col) == '\n')
-                {
-                    // do not include \r nor \n as they don't have color attributes.
-                    // For line break use \line instead.
-                    writeAccumulatedChars(false);
-                    break;
-                }
+    // preallocate the text to reduce reallocs
+    const size_t rows = selectionRects.size();
+    data.text.reserve(base::ClampMul(rows, base::ClampAdd(GetSize().Width(), 2))); // + 2 for \r\n if we munged it
 
-                bool colorChanged = false;
-                if (!fgColor.has_value() || rows.FgAttr.at(row).at(col) != fgColor.value())
-                {
-                    fgColor = rows.FgAttr.at(row).at(col);
-                    colorChanged = true;
-                }
+    std::optional<HTMLWriter> html;
+    if (includeHTML && GetAttributeColors != nullptr)
+    {
+        html.emplace(data.html, fontHeightPoints, fontFaceName, backgroundColor);
+    }
 
-                if (!bkColor.has_value() || rows.BkAttr.at(row).at(col) != bkColor.value())
-                {
-                    bkColor = rows.BkAttr.at(row).at(col);
-                    colorChanged = true;
-                }
+    std::optional<RTFWriter> rtf;
+    if (includeRTF && GetAttributeColors != nullptr)
+    {
+        rtf.emplace(data.rtf, fontHeightPoints, fontFaceName, backgroundColor);
+    }
 
-                if (colorChanged)
-                {
-                    writeAccumulatedChars(false);
+    // The text and runs of the current row. These are reused for every row.
+    std::wstring rowText;
+    std::vector<TextRun> rowRuns;
 
-                    int bkColorIndex = 0;
-                    if (colorMap.find(bkColor.value()) != colorMap.end())
-                    {
-                        // color already exists in the map, just retrieve the index
-                        bkColorIndex = colorMap[bkColor.value()];
-                    }
-                    else
-                    {
-                        // color not present in the map, so add it
-                        colorTableBuilder << "\\red" << static_cast<int>(GetRValue(bkColor.value()))
-                                          << "\\green" << static_cast<int>(GetGValue(bkColor.value()))
-                                          << "\\blue" << static_cast<int>(GetBValue(bkColor.value()))
-                                          << ";";
-                        colorMap[bkColor.value()] = nextColorIndex;
-                        bkColorIndex = nextColorIndex++;
-                    }
+    for (size_t i = 0; i < rows; i++)
+    {
+        const auto& selectionRect = selectionRects.at(i);
+        const auto& row = GetRowByOffset(selectionRect.Top);
 
-                    int fgColorIndex = 0;
-                    if (colorMap.find(fgColor.value()) != colorMap.end())
-                    {
-                        // color already exists in the map, just retrieve the index
-                        fgColorIndex = colorMap[fgColor.value()];
-                    }
-                    else
-                    {
-                        // color not present in the map, so add it
-                        colorTableBuilder << "\\red" << static_cast<int>(GetRValue(fgColor.value()))
-                                          << "\\green" << static_cast<int>(GetGValue(fgColor.value()))
-                                          << "\\blue" << static_cast<int>(GetBValue(fgColor.value()))
-                                          << ";";
-                        colorMap[fgColor.value()] = nextColorIndex;
-                        fgColorIndex = nextColorIndex++;
-                    }
+        rowText.clear();
+        rowRuns.clear();
+        _AppendRowText(row,
+                       gsl::narrow<size_t>(selectionRect.Left),
+                       gsl::narrow<size_t>(selectionRect.Right),
+                       rowText,
+                       html || rtf ? &rowRuns : nullptr,
+                       GetAttributeColors);
 
-                    contentBuilder << "\\highlight" << bkColorIndex
-                                   << "\\cf" << fgColorIndex
-                                   << " ";
-                }
+        // We apply formatting to rows if the row was NOT wrapped or formatting of wrapped rows is allowed
+        const bool shouldFormatRow = formatWrappedRows || !row.WasWrapForced();
 
-                // if this is the last character in the row, flush the whole row
-                if (col == rows.text.at(row).length() - 1)
-                {
-                    writeAccumulatedChars(true);
-                }
-            }
+        if (trimTrailingWhitespace && shouldFormatRow)
+        {
+            // remove the spaces at the end (aka trim the trailing whitespace)
+            _TrimTrailingWhitespace(rowText, &rowRuns);
         }
 
-        // end colortbl
-        colorTableBuilder << "}";
-
-        // add color table to the final RTF
-        rtfBuilder << colorTableBuilder.str();
+        if (html)
+        {
+            html->AppendRow(rowText, rowRuns);
+        }
+        if (rtf)
+        {
+            rtf->AppendRow(rowText, rowRuns);
+        }
 
-        // add the text content to the final RTF
-        rtfBuilder << contentBuilder.str();
+        data.text.append(rowText);
 
-        // end rtf
-        rtfBuilder << "}";
+        // apply CR/LF to the end of the final string, unless we're the last line.
+        // a.k.a if we're earlier than the bottom, then apply CR/LF.
+        if (includeCRLF && i < rows - 1 && shouldFormatRow)
+        {
+            data.text.push_back(UNICODE_CARRIAGERETURN);
+            data.text.push_back(UNICODE_LINEFEED);
+        }
+    }
 
-        return rtfBuilder.str();
+    if (html)
+    {
+        html->Finish();
     }
-    catch (...)
+    if (rtf)
     {
-        LOG_HR(wil::ResultFromCaughtException());
-        return {};
+        rtf->Finish();
     }
+
+    return data;
 }
 
 // Function Description:
@@ -2511,11 +2834,12 @@ PointTree TextBuffer::GetPatterns(const size_t firstRow, const size_t lastRow) c
     concatAll.reserve(rowSize * (lastRow - firstRow + 1));
 
     // to deal with text that spans multiple lines, we will first concatenate
-    // all the text into one string and find the patterns in that string
+    // all the text into one string and find the patterns in that string.
+    // The rows cache their text, so this doesn't need to rebuild the text of
+    // the rows that haven't changed since the last time.
     for (auto i = firstRow; i <= lastRow; ++i)
     {
-        auto& row = GetRowByOffset(i);
-        concatAll += row.GetText();
+        concatAll += GetRowByOffset(i).GetTextView();
     }
 
     // for each pattern we know of, iterate through the string
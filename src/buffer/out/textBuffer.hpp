@@ -97,6 +97,9 @@ public:
                                  const std::optional<bool> setWrap = std::nullopt,
                                  const std::optional<size_t> limitRight = std::nullopt);
 
+    bool WriteCharInfoLine(const gsl::span<const CHAR_INFO> cells, const COORD target);
+    void ReadCharInfoLine(const gsl::span<CHAR_INFO> cells, const COORD source) const;
+
     bool InsertCharacter(const wchar_t wch, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool InsertCharacter(const std::wstring_view chars, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool IncrementCursor();
@@ -160,12 +163,23 @@ public:
     std::wstring GetCustomIdFromId(uint16_t id) const;
     void CopyHyperlinkMaps(const TextBuffer& OtherBuffer);
 
+    // A stretch of text with the same colors and extended attributes throughout.
+    class TextRun
+    {
+    public:
+        size_t length;
+        COLORREF foreground;
+        COLORREF background;
+        ExtendedAttributes flags;
+    };
+
     class TextAndColor
     {
     public:
         std::vector<std::wstring> text;
-        std::vector<std::vector<COLORREF>> FgAttr;
-        std::vector<std::vector<COLORREF>> BkAttr;
+        // The runs of each row of text. Their lengths add up to the length of
+        // that row's text, line breaks included.
+        std::vector<std::vector<TextRun>> runs;
     };
 
     const TextAndColor GetText(const bool includeCRLF,
@@ -174,6 +188,12 @@ public:
                                std::function<std::pair<COLORREF, COLORREF>(const TextAttribute&)> GetAttributeColors = nullptr,
                                const bool formatWrappedRows = false) const;
 
+    std::wstring GetPlainText(const COORD start,
+                              const COORD end,
+                              const bool blockSelection,
+                              const bool bufferCoordinates,
+                              const size_t maxLength = std::numeric_limits<size_t>::max()) const;
+
     static std::string GenHTML(const TextAndColor& rows,
                                const int fontHeightPoints,
                                const std::wstring_view fontFaceName,
@@ -184,6 +204,25 @@ public:
                               const std::wstring_view fontFaceName,
                               const COLORREF backgroundColor);
 
+    class ClipboardData
+    {
+    public:
+        std::wstring text;
+        std::string html;
+        std::string rtf;
+    };
+
+    ClipboardData SerializeSelection(const bool includeCRLF,
+                                     const bool trimTrailingWhitespace,
+                                     const std::vector<SMALL_RECT>& selectionRects,
+                                     std::function<std::pair<COLORREF, COLORREF>(const TextAttribute&)> GetAttributeColors,
+                                     const bool formatWrappedRows,
+                                     const bool includeHTML,
+                                     const bool includeRTF,
+                                     const int fontHeightPoints,
+                                     const std::wstring_view fontFaceName,
+                                     const COLORREF backgroundColor) const;
+
     struct PositionInformation
     {
         short mutableViewportTop{ 0 };
@@ -237,9 +276,12 @@ private:
     ROW& _GetFirstRow();
     ROW& _GetPrevRowNoWrap(const ROW& row);
 
+    SMALL_RECT _GetTextRect(const SHORT row, const COORD higherCoord, const COORD lowerCoord, const bool blockSelection, const bool bufferCoordinates) const;
     void _ExpandTextRow(SMALL_RECT& selectionRow) const;
 
+    uint32_t _GetWordDelimitersId(const std::wstring_view wordDelimiters) const;
     const DelimiterClass _GetDelimiterClassAt(const COORD pos, const std::wstring_view wordDelimiters) const;
+    bool _FindWordClass(COORD& pos, const bool forward, const bool regularChar, const std::wstring_view wordDelimiters) const;
     const COORD _GetWordStartForAccessibility(const COORD target, const std::wstring_view wordDelimiters) const;
     const COORD _GetWordStartForSelection(const COORD target, const std::wstring_view wordDelimiters) const;
     const COORD _GetWordEndForAccessibility(const COORD target, const std::wstring_view wordDelimiters, const COORD lastCharPos) const;
@@ -250,6 +292,11 @@ private:
     std::unordered_map<size_t, std::wstring> _idsAndPatterns;
     size_t _currentPatternId;
 
+    // The last set of word delimiters used for word navigation, and the
+    // process-wide unique id the rows cache their delimiter classes under.
+    mutable std::wstring _wordDelimiters;
+    mutable uint32_t _wordDelimitersId{ 0 };
+
 #ifdef UNIT_TESTING
     friend class TextBufferTests;
     friend class UiaTextRangeTests;
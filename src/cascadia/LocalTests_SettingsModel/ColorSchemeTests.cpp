@@ -35,6 +35,7 @@ namespace SettingsModelLocalTests
         TEST_METHOD(CanLayerColorScheme);
         TEST_METHOD(LayerColorSchemeProperties);
         TEST_METHOD(LayerColorSchemesOnArray);
+        TEST_METHOD(LayerManyColorSchemes);
         TEST_METHOD(UpdateSchemeReferences);
 
         TEST_CLASS_SETUP(ClassSetup)
@@ -368,4 +369,47 @@ namespace SettingsModelLocalTests
             VERIFY_IS_TRUE(prof.DefaultAppearance().HasColorSchemeName());
         }
     }
+
+    void ColorSchemeTests::LayerManyColorSchemes()
+    {
+        // Enough schemes to get them parsed on the thread pool. Make sure the
+        // result is still the same as layering them one after another.
+        static constexpr uint32_t schemeCount = 500;
+
+        Json::Value schemesJson{ Json::ValueType::arrayValue };
+        for (uint32_t i = 0; i < schemeCount; ++i)
+        {
+            Json::Value schemeJson{ Json::ValueType::objectValue };
+            schemeJson["name"] = fmt::format("scheme{}", i);
+            schemeJson["foreground"] = fmt::format("#0000{:02X}", i % 256);
+            schemeJson["background"] = "#010101";
+            schemesJson.append(schemeJson);
+        }
+
+        // A scheme that appears twice is layered on its first appearance.
+        schemesJson.append(VerifyParseSucceeded(R"({ "name": "scheme5", "background": "#020202" })"));
+        // A scheme that already exists is layered, not replaced.
+        schemesJson.append(VerifyParseSucceeded(R"({ "name": "existing", "foreground": "#030303" })"));
+
+        auto settings = winrt::make_self<CascadiaSettings>();
+        settings->_LayerOrCreateColorScheme(VerifyParseSucceeded(R"({ "name": "existing", "foreground": "#040404", "background": "#050505" })"));
+
+        settings->_LayerOrCreateColorSchemes(schemesJson);
+
+        const auto schemes = settings->_globals->ColorSchemes();
+        VERIFY_ARE_EQUAL(schemeCount + 1, schemes.Size());
+
+        for (uint32_t i = 0; i < schemeCount; ++i)
+        {
+            const auto name = fmt::format(L"scheme{}", i);
+            VERIFY_IS_TRUE(schemes.HasKey(name));
+            const auto scheme = winrt::get_self<ColorScheme>(schemes.Lookup(name));
+            VERIFY_ARE_EQUAL(ARGB(0, 0, 0, i % 256), scheme->_Foreground);
+            VERIFY_ARE_EQUAL(i == 5 ? ARGB(0, 2, 2, 2) : ARGB(0, 1, 1, 1), scheme->_Background);
+        }
+
+        const auto existing = winrt::get_self<ColorScheme>(schemes.Lookup(L"existing"));
+        VERIFY_ARE_EQUAL(ARGB(0, 3, 3, 3), existing->_Foreground);
+        VERIFY_ARE_EQUAL(ARGB(0, 5, 5, 5), existing->_Background);
+    }
 }
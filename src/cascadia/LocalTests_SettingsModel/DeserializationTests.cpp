@@ -87,6 +87,7 @@ namespace SettingsModelLocalTests
         TEST_METHOD(TestCloneInheritanceTree);
 
         TEST_METHOD(TestValidDefaults);
+        TEST_METHOD(TestDefaultsAreIndependentCopies);
 
         TEST_METHOD(TestInheritedCommand);
 
@@ -2764,6 +2765,33 @@ namespace SettingsModelLocalTests
         VERIFY_ARE_EQUAL(settings.AllProfiles().Size(), 2u);
     }
 
+    void DeserializationTests::TestDefaultsAreIndependentCopies()
+    {
+        // LoadDefaults only parses defaults.json once and hands out copies
+        // afterwards. Make sure modifying one of them doesn't leak into the
+        // next one.
+
+        const auto settings0{ CascadiaSettings::LoadDefaults() };
+        const auto settings1{ CascadiaSettings::LoadDefaults() };
+
+        VERIFY_ARE_EQUAL(settings0.AllProfiles().Size(), settings1.AllProfiles().Size());
+        VERIFY_ARE_EQUAL(settings0.ActiveProfiles().Size(), settings1.ActiveProfiles().Size());
+        VERIFY_ARE_EQUAL(settings0.GlobalSettings().ColorSchemes().Size(), settings1.GlobalSettings().ColorSchemes().Size());
+        VERIFY_ARE_EQUAL(settings0.GlobalSettings().DefaultProfile(), settings1.GlobalSettings().DefaultProfile());
+        VERIFY_IS_TRUE(OriginTag::InBox == settings1.AllProfiles().GetAt(0).Origin());
+
+        const auto originalName{ settings1.AllProfiles().GetAt(0).Name() };
+        const auto originalWidth{ settings1.GlobalSettings().InitialCols() };
+        settings0.AllProfiles().GetAt(0).Name(L"changed");
+        settings0.GlobalSettings().InitialCols(originalWidth + 1);
+
+        const auto settings2{ CascadiaSettings::LoadDefaults() };
+        VERIFY_ARE_EQUAL(originalName, settings1.AllProfiles().GetAt(0).Name());
+        VERIFY_ARE_EQUAL(originalName, settings2.AllProfiles().GetAt(0).Name());
+        VERIFY_ARE_EQUAL(originalWidth, settings1.GlobalSettings().InitialCols());
+        VERIFY_ARE_EQUAL(originalWidth, settings2.GlobalSettings().InitialCols());
+    }
+
     void DeserializationTests::TestInheritedCommand()
     {
         // Test unbinding a command's key chord or name that originated in another layer.
@@ -38,6 +38,7 @@ namespace SettingsModelLocalTests
         TEST_METHOD(ManyKeysSameAction);
         TEST_METHOD(LayerKeybindings);
         TEST_METHOD(UnbindKeybindings);
+        TEST_METHOD(FreezeKeybindings);
 
         TEST_METHOD(TestArbitraryArgs);
         TEST_METHOD(TestSplitPaneArgs);
@@ -180,6 +181,50 @@ namespace SettingsModelLocalTests
         VERIFY_IS_NULL(actionMap->GetActionByKeyChord({ KeyModifiers::Ctrl, static_cast<int32_t>('c') }));
     }
 
+    void KeyBindingsTests::FreezeKeybindings()
+    {
+        const std::string bindings0String{ R"([
+            { "command": "copy", "keys": ["ctrl+c"] },
+            { "command": "paste", "keys": ["ctrl+v"] },
+            { "command": "newTab", "keys": ["ctrl+t"] }
+        ])" };
+        const std::string bindings1String{ R"([
+            { "command": "paste", "keys": ["ctrl+c"] },
+            { "command": "unbound", "keys": ["ctrl+t"] }
+        ])" };
+        const std::string bindings2String{ R"([ { "command": "closePane", "keys": ["ctrl+w"] } ])" };
+
+        const auto bindings0Json = VerifyParseSucceeded(bindings0String);
+        const auto bindings1Json = VerifyParseSucceeded(bindings1String);
+        const auto bindings2Json = VerifyParseSucceeded(bindings2String);
+
+        auto parent = winrt::make_self<implementation::ActionMap>();
+        parent->LayerJson(bindings0Json);
+        auto actionMap = parent->CreateChild();
+        actionMap->LayerJson(bindings1Json);
+
+        actionMap->Freeze();
+        VERIFY_IS_TRUE(actionMap->Frozen());
+        VERIFY_ARE_EQUAL(3u, actionMap->_ResolvedKeyChords.size());
+
+        Log::Comment(L"A frozen ActionMap should resolve key chords like its layers do");
+        const auto getAction = [&](const int32_t vkey) {
+            const auto cmd{ actionMap->GetActionByKeyChord({ KeyModifiers::Ctrl, vkey }) };
+            return cmd ? cmd.ActionAndArgs().Action() : ShortcutAction::Invalid;
+        };
+        VERIFY_ARE_EQUAL(ShortcutAction::PasteText, getAction(static_cast<int32_t>('C')));
+        VERIFY_ARE_EQUAL(ShortcutAction::PasteText, getAction(static_cast<int32_t>('V')));
+        VERIFY_ARE_EQUAL(ShortcutAction::Invalid, getAction(static_cast<int32_t>('T')));
+        VERIFY_ARE_EQUAL(ShortcutAction::Invalid, getAction(static_cast<int32_t>('W')));
+        VERIFY_IS_NULL(actionMap->GetActionByKeyChord({ KeyModifiers::Alt, static_cast<int32_t>('C') }));
+
+        Log::Comment(L"Adding an action should thaw the ActionMap");
+        actionMap->LayerJson(bindings2Json);
+        VERIFY_IS_FALSE(actionMap->Frozen());
+        VERIFY_ARE_EQUAL(ShortcutAction::ClosePane, getAction(static_cast<int32_t>('W')));
+        VERIFY_ARE_EQUAL(ShortcutAction::PasteText, getAction(static_cast<int32_t>('C')));
+    }
+
     void KeyBindingsTests::TestArbitraryArgs()
     {
         const std::string bindings0String{ R"([
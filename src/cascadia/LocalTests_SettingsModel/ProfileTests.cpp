@@ -37,6 +37,7 @@ namespace SettingsModelLocalTests
         TEST_METHOD(LayerProfileIcon);
         TEST_METHOD(LayerProfilesOnArray);
         TEST_METHOD(DuplicateProfileTest);
+        TEST_METHOD(FreezeProfile);
 
         TEST_CLASS_SETUP(ClassSetup)
         {
@@ -326,4 +327,51 @@ namespace SettingsModelLocalTests
         const auto duplicatedJson = winrt::get_self<implementation::Profile>(duplicatedProfile)->ToJson();
         VERIFY_ARE_EQUAL(profile0Json, duplicatedJson);
     }
+
+    void ProfileTests::FreezeProfile()
+    {
+        const std::string parentString{ R"({
+            "name" : "parent",
+            "fontFace" : "Cascadia Mono",
+            "historySize" : 1234,
+            "colorScheme" : "Vintage"
+        })" };
+        const std::string childString{ R"({
+            "name" : "child",
+            "fontSize" : 14
+        })" };
+
+        const auto parent = implementation::Profile::FromJson(VerifyParseSucceeded(parentString));
+        auto child{ parent->CreateChild() };
+        child->LayerJson(VerifyParseSucceeded(childString));
+
+        child->Freeze();
+        VERIFY_IS_TRUE(child->Frozen());
+        VERIFY_ARE_EQUAL(L"child", child->Name());
+        VERIFY_ARE_EQUAL(L"Cascadia Mono", child->FontFace());
+        VERIFY_ARE_EQUAL(14, child->FontSize());
+        VERIFY_ARE_EQUAL(1234, child->HistorySize());
+        VERIFY_ARE_EQUAL(L"Vintage", child->DefaultAppearance().ColorSchemeName());
+
+        Log::Comment(L"A frozen profile doesn't observe changes to its parents...");
+        parent->FontFace(L"Consolas");
+        parent->DefaultAppearance().ColorSchemeName(L"Campbell");
+        VERIFY_ARE_EQUAL(L"Cascadia Mono", child->FontFace());
+        VERIFY_ARE_EQUAL(L"Vintage", child->DefaultAppearance().ColorSchemeName());
+
+        Log::Comment(L"...but its own values can still be changed.");
+        child->HistorySize(42);
+        VERIFY_ARE_EQUAL(42, child->HistorySize());
+        child->ClearHistorySize();
+        VERIFY_ARE_EQUAL(1234, child->HistorySize());
+        child->ClearFontSize();
+        VERIFY_ARE_EQUAL(DEFAULT_FONT_SIZE, child->FontSize());
+
+        Log::Comment(L"Changing the parents of a profile thaws it.");
+        child->ClearParents();
+        implementation::Profile::InsertParentHelper(child, parent);
+        VERIFY_IS_FALSE(child->Frozen());
+        VERIFY_ARE_EQUAL(L"Consolas", child->FontFace());
+        VERIFY_ARE_EQUAL(L"Campbell", child->DefaultAppearance().ColorSchemeName());
+    }
 }
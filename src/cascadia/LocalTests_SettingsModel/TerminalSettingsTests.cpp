@@ -42,6 +42,8 @@ namespace SettingsModelLocalTests
 
         TEST_METHOD(TestLayerProfileOnColorScheme);
 
+        TEST_METHOD(TestEquivalentSettings);
+
         TEST_CLASS_SETUP(ClassSetup)
         {
             return true;
@@ -554,4 +556,101 @@ namespace SettingsModelLocalTests
         VERIFY_ARE_EQUAL(ARGB(0, 0x45, 0x67, 0x89), terminalSettings4->CursorColor()); // from profile (no color scheme)
         VERIFY_ARE_EQUAL(DEFAULT_CURSOR_COLOR, terminalSettings5->CursorColor()); // default
     }
+
+    void TerminalSettingsTests::TestEquivalentSettings()
+    {
+        const std::string settings0String{ R"(
+        {
+            "defaultProfile": "{6239a42c-1111-49a3-80bd-e8fdd045185c}",
+            "profiles": [
+                {
+                    "name" : "profile0",
+                    "guid": "{6239a42c-1111-49a3-80bd-e8fdd045185c}",
+                    "tabColor": "#123456",
+                    "unfocusedAppearance": { "cursorShape": "filledBox" }
+                },
+                {
+                    "name" : "profile1",
+                    "guid": "{6239a42c-2222-49a3-80bd-e8fdd045185c}",
+                    "fontSize": 12
+                },
+                {
+                    "name" : "profile2",
+                    "guid": "{6239a42c-3333-49a3-80bd-e8fdd045185c}",
+                    "tabTitle": "Title"
+                }
+            ]
+        })" };
+        // Same as above, with profile0's unfocused appearance, profile1's font size and profile2's tab title changed.
+        const std::string settings1String{ R"(
+        {
+            "defaultProfile": "{6239a42c-1111-49a3-80bd-e8fdd045185c}",
+            "profiles": [
+                {
+                    "name" : "profile0",
+                    "guid": "{6239a42c-1111-49a3-80bd-e8fdd045185c}",
+                    "tabColor": "#123456",
+                    "unfocusedAppearance": { "cursorShape": "underscore" }
+                },
+                {
+                    "name" : "profile1",
+                    "guid": "{6239a42c-2222-49a3-80bd-e8fdd045185c}",
+                    "fontSize": 14
+                },
+                {
+                    "name" : "profile2",
+                    "guid": "{6239a42c-3333-49a3-80bd-e8fdd045185c}",
+                    "tabTitle": "Another title"
+                }
+            ]
+        })" };
+
+        const CascadiaSettings settings0{ til::u8u16(settings0String) };
+        const CascadiaSettings settings0Again{ til::u8u16(settings0String) };
+        const CascadiaSettings settings1{ til::u8u16(settings1String) };
+
+        const auto guid0 = ::Microsoft::Console::Utils::GuidFromString(L"{6239a42c-1111-49a3-80bd-e8fdd045185c}");
+        const auto guid1 = ::Microsoft::Console::Utils::GuidFromString(L"{6239a42c-2222-49a3-80bd-e8fdd045185c}");
+        const auto guid2 = ::Microsoft::Console::Utils::GuidFromString(L"{6239a42c-3333-49a3-80bd-e8fdd045185c}");
+
+        Log::Comment(L"Settings created from equal settings should be equivalent, even though they are different objects");
+        for (const auto& guid : { guid0, guid1, guid2 })
+        {
+            const auto a{ TerminalSettings::CreateWithProfileByID(settings0, guid, nullptr) };
+            const auto b{ TerminalSettings::CreateWithProfileByID(settings0Again, guid, nullptr) };
+            VERIFY_IS_TRUE(TerminalSettings::Equivalent(a.DefaultSettings(), b.DefaultSettings()));
+            VERIFY_IS_TRUE(TerminalSettings::Equivalent(a.UnfocusedSettings(), b.UnfocusedSettings()));
+        }
+
+        Log::Comment(L"A change to the unfocused appearance should only affect the unfocused settings");
+        {
+            const auto a{ TerminalSettings::CreateWithProfileByID(settings0, guid0, nullptr) };
+            const auto b{ TerminalSettings::CreateWithProfileByID(settings1, guid0, nullptr) };
+            VERIFY_IS_TRUE(TerminalSettings::Equivalent(a.DefaultSettings(), b.DefaultSettings()));
+            VERIFY_IS_FALSE(TerminalSettings::Equivalent(a.UnfocusedSettings(), b.UnfocusedSettings()));
+        }
+
+        Log::Comment(L"A changed font size should be detected");
+        {
+            const auto a{ TerminalSettings::CreateWithProfileByID(settings0, guid1, nullptr) };
+            const auto b{ TerminalSettings::CreateWithProfileByID(settings1, guid1, nullptr) };
+            VERIFY_IS_FALSE(TerminalSettings::Equivalent(a.DefaultSettings(), b.DefaultSettings()));
+        }
+
+        Log::Comment(L"A changed tab title should be detected, since it's the starting title of the terminal");
+        {
+            const auto a{ TerminalSettings::CreateWithProfileByID(settings0, guid2, nullptr) };
+            const auto b{ TerminalSettings::CreateWithProfileByID(settings1, guid2, nullptr) };
+            VERIFY_IS_FALSE(TerminalSettings::Equivalent(a.DefaultSettings(), b.DefaultSettings()));
+        }
+
+        Log::Comment(L"Null settings are only equivalent to null settings");
+        {
+            const auto a{ TerminalSettings::CreateWithProfileByID(settings0, guid1, nullptr) };
+            VERIFY_IS_NULL(a.UnfocusedSettings());
+            VERIFY_IS_TRUE(TerminalSettings::Equivalent(nullptr, nullptr));
+            VERIFY_IS_FALSE(TerminalSettings::Equivalent(a.DefaultSettings(), nullptr));
+            VERIFY_IS_FALSE(TerminalSettings::Equivalent(nullptr, a.DefaultSettings()));
+        }
+    }
 }
@@ -116,48 +116,42 @@ namespace TerminalAppLocalTests
             {
                 Log::Comment(L"Testing weight of command with no filter");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
-                filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
-                auto weight = filteredCommand->_computeWeight();
+                auto weight = filteredCommand->_matchFilter().weight;
                 VERIFY_ARE_EQUAL(weight, 0);
             }
             {
                 Log::Comment(L"Testing weight of command with empty filter");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
                 filteredCommand->_Filter = L"";
-                filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
-                auto weight = filteredCommand->_computeWeight();
+                auto weight = filteredCommand->_matchFilter().weight;
                 VERIFY_ARE_EQUAL(weight, 0);
             }
             {
                 Log::Comment(L"Testing weight of command with filter equals to the string");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
                 filteredCommand->_Filter = L"AAAAAABBBBBBCCC";
-                filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
-                auto weight = filteredCommand->_computeWeight();
+                auto weight = filteredCommand->_matchFilter().weight;
                 VERIFY_ARE_EQUAL(weight, 30); // 1 point for the first char and 2 points for the 14 consequent ones + 1 point for the beginning of the word
             }
             {
                 Log::Comment(L"Testing weight of command with filter with first character matching");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
                 filteredCommand->_Filter = L"A";
-                filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
-                auto weight = filteredCommand->_computeWeight();
+                auto weight = filteredCommand->_matchFilter().weight;
                 VERIFY_ARE_EQUAL(weight, 2); // 1 point for the first char match + 1 point for the beginning of the word
             }
             {
                 Log::Comment(L"Testing weight of command with filter with other case");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
                 filteredCommand->_Filter = L"a";
-                filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
-                auto weight = filteredCommand->_computeWeight();
+                auto weight = filteredCommand->_matchFilter().weight;
                 VERIFY_ARE_EQUAL(weight, 2); // 1 point for the first char match + 1 point for the beginning of the word
             }
             {
                 Log::Comment(L"Testing weight of command with filter matching several characters");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
                 filteredCommand->_Filter = L"ab";
-                filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
-                auto weight = filteredCommand->_computeWeight();
+                auto weight = filteredCommand->_matchFilter().weight;
                 VERIFY_ARE_EQUAL(weight, 3); // 1 point for the first char match + 1 point for the beginning of the word + 1 point for the match of "b"
             }
         });
@@ -182,13 +176,11 @@ namespace TerminalAppLocalTests
                 Log::Comment(L"Testing comparison of commands with empty filter");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
                 filteredCommand->_Filter = L"";
-                filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
-                filteredCommand->_Weight = filteredCommand->_computeWeight();
+                filteredCommand->_Weight = filteredCommand->_matchFilter().weight;
 
                 const auto filteredCommand2 = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem2);
                 filteredCommand2->_Filter = L"";
-                filteredCommand2->_HighlightedName = filteredCommand2->_computeHighlightedName();
-                filteredCommand2->_Weight = filteredCommand2->_computeWeight();
+                filteredCommand2->_Weight = filteredCommand2->_matchFilter().weight;
 
                 VERIFY_ARE_EQUAL(filteredCommand->Weight(), filteredCommand2->Weight());
                 VERIFY_IS_TRUE(winrt::TerminalApp::implementation::FilteredCommand::Compare(*filteredCommand, *filteredCommand2));
@@ -197,13 +189,11 @@ namespace TerminalAppLocalTests
                 Log::Comment(L"Testing comparison of commands with different weights");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
                 filteredCommand->_Filter = L"B";
-                filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
-                filteredCommand->_Weight = filteredCommand->_computeWeight();
+                filteredCommand->_Weight = filteredCommand->_matchFilter().weight;
 
                 const auto filteredCommand2 = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem2);
                 filteredCommand2->_Filter = L"B";
-                filteredCommand2->_HighlightedName = filteredCommand2->_computeHighlightedName();
-                filteredCommand2->_Weight = filteredCommand2->_computeWeight();
+                filteredCommand2->_Weight = filteredCommand2->_matchFilter().weight;
 
                 VERIFY_IS_TRUE(filteredCommand->Weight() < filteredCommand2->Weight()); // Second command gets more points due to the beginning of the word
                 VERIFY_IS_FALSE(winrt::TerminalApp::implementation::FilteredCommand::Compare(*filteredCommand, *filteredCommand2));
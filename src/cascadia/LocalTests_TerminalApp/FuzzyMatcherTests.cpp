@@ -0,0 +1,191 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "../TerminalApp/FuzzyMatcher.h"
+
+#include <array>
+#include <chrono>
+
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+using namespace WEX::Common;
+using namespace winrt::TerminalApp;
+
+namespace TerminalAppLocalTests
+{
+    class FuzzyMatcherTests
+    {
+        BEGIN_TEST_CLASS(FuzzyMatcherTests)
+            TEST_CLASS_PROPERTY(L"RunAs", L"UAP")
+            TEST_CLASS_PROPERTY(L"UAP:AppXManifest", L"TestHostAppXManifest.xml")
+        END_TEST_CLASS()
+
+        TEST_METHOD(VerifyExtend);
+        TEST_METHOD(VerifyFilter);
+        TEST_METHOD(VerifyWeight);
+        TEST_METHOD(VerifyRefinedFilter);
+
+        BEGIN_TEST_METHOD(FilterThroughput)
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD()
+
+    private:
+        static std::vector<std::wstring> _makeNames(const size_t count);
+        static void _verifyIndices(const std::vector<size_t>& expected, const std::vector<FuzzyMatcher::Match>& matches);
+    };
+
+    std::vector<std::wstring> FuzzyMatcherTests::_makeNames(const size_t count)
+    {
+        static constexpr std::array<std::wstring_view, 8> verbs{ L"New", L"Close", L"Split", L"Set", L"Open", L"Move", L"Switch to", L"Toggle" };
+        static constexpr std::array<std::wstring_view, 8> nouns{ L"Tab", L"Pane", L"Color Scheme", L"Profile", L"Settings", L"Window", L"Focus Mode", L"Command Palette" };
+
+        std::vector<std::wstring> names;
+        names.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            names.emplace_back(fmt::format(L"{} {}, profile: Profile {}", verbs.at(i % verbs.size()), nouns.at((i / verbs.size()) % nouns.size()), i));
+        }
+        return names;
+    }
+
+    void FuzzyMatcherTests::_verifyIndices(const std::vector<size_t>& expected, const std::vector<FuzzyMatcher::Match>& matches)
+    {
+        VERIFY_ARE_EQUAL(expected.size(), matches.size());
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            VERIFY_ARE_EQUAL(expected.at(i), matches.at(i).index);
+        }
+    }
+
+    void FuzzyMatcherTests::VerifyExtend()
+    {
+        const auto name{ FuzzyMatcher::Fold(L"close all tabs after this") };
+
+        Log::Comment(L"Each character matches its first appearance after the previous match");
+        FuzzyMatcher::Match match{};
+        VERIFY_IS_TRUE(FuzzyMatcher::Extend(name, FuzzyMatcher::Fold(L"CLTS"), match));
+        VERIFY_ARE_EQUAL(4u, match.positions.size());
+        VERIFY_ARE_EQUAL(0u, match.positions.at(0));
+        VERIFY_ARE_EQUAL(1u, match.positions.at(1));
+        VERIFY_ARE_EQUAL(10u, match.positions.at(2));
+        VERIFY_ARE_EQUAL(13u, match.positions.at(3));
+        VERIFY_ARE_EQUAL(7, match.weight);
+
+        Log::Comment(L"Extending a match resumes after its last position");
+        VERIFY_IS_TRUE(FuzzyMatcher::Extend(name, L"a", match));
+        VERIFY_ARE_EQUAL(5u, match.positions.size());
+        VERIFY_ARE_EQUAL(15u, match.positions.at(4));
+        VERIFY_ARE_EQUAL(9, match.weight);
+
+        Log::Comment(L"An empty filter matches without positions");
+        FuzzyMatcher::Match empty{};
+        VERIFY_IS_TRUE(FuzzyMatcher::Extend(L"close", L"", empty));
+        VERIFY_ARE_EQUAL(0u, empty.positions.size());
+        VERIFY_ARE_EQUAL(0, empty.weight);
+
+        Log::Comment(L"Characters out of order don't match");
+        FuzzyMatcher::Match outOfOrder{};
+        VERIFY_IS_FALSE(FuzzyMatcher::Extend(L"close", L"ec", outOfOrder));
+    }
+
+    void FuzzyMatcherTests::VerifyFilter()
+    {
+        FuzzyMatcher matcher;
+        matcher.SetNames({ L"New Tab", L"Close Tab", L"Close Pane", L"[-] Split Horizontal", L"[ | ] Split Vertical", L"Open Settings" });
+        VERIFY_ARE_EQUAL(6u, matcher.Size());
+
+        _verifyIndices({ 0, 1, 2, 3, 4, 5 }, matcher.Filter(L""));
+        _verifyIndices({ 0, 1 }, matcher.Filter(L"tab"));
+        _verifyIndices({ 4 }, matcher.Filter(L"sv"));
+        _verifyIndices({ 2, 3, 4, 5 }, matcher.Filter(L"P"));
+        _verifyIndices({}, matcher.Filter(L"xyz"));
+    }
+
+    void FuzzyMatcherTests::VerifyWeight()
+    {
+        // These are the weights FilteredCommandTests::VerifyWeight expects
+        // for the same name and filters.
+        FuzzyMatcher matcher;
+        matcher.SetNames({ L"AAAAAABBBBBBCCC" });
+
+        const auto weightOf = [&](const std::wstring_view filter) {
+            const auto& matches{ matcher.Filter(filter) };
+            VERIFY_ARE_EQUAL(1u, matches.size());
+            return matches.front().weight;
+        };
+
+        VERIFY_ARE_EQUAL(30, weightOf(L"AAAAAABBBBBBCCC"));
+        VERIFY_ARE_EQUAL(2, weightOf(L"A"));
+        VERIFY_ARE_EQUAL(2, weightOf(L"a"));
+        VERIFY_ARE_EQUAL(3, weightOf(L"ab"));
+
+        Log::Comment(L"A match at the beginning of a word gets an extra point");
+        matcher.SetNames({ L"Close Pane", L"Split Pane" });
+        const auto& matches{ matcher.Filter(L"sp") };
+        VERIFY_ARE_EQUAL(2u, matches.size());
+        VERIFY_IS_LESS_THAN(matches.at(0).weight, matches.at(1).weight);
+    }
+
+    void FuzzyMatcherTests::VerifyRefinedFilter()
+    {
+        const auto names{ _makeNames(512) };
+        FuzzyMatcher typing;
+        typing.SetNames(names);
+
+        Log::Comment(L"Typing (and deleting) one character at a time must produce the same matches as filtering from scratch");
+        const std::wstring_view filters[] = { L"n", L"ne", L"new", L"new ", L"new p", L"new pr", L"new p", L"sp", L"spl", L"split p1", L"" };
+        for (const auto filter : filters)
+        {
+            FuzzyMatcher fresh;
+            fresh.SetNames(names);
+
+            const auto& expected{ fresh.Filter(filter) };
+            const auto& actual{ typing.Filter(filter) };
+            VERIFY_ARE_EQUAL(expected.size(), actual.size(), NoThrowString().Format(L"filter: \"%.*s\"", gsl::narrow<int>(filter.size()), filter.data()));
+            for (size_t i = 0; i < expected.size(); i++)
+            {
+                VERIFY_ARE_EQUAL(expected.at(i).index, actual.at(i).index);
+                VERIFY_ARE_EQUAL(expected.at(i).weight, actual.at(i).weight);
+                VERIFY_IS_TRUE(expected.at(i).positions == actual.at(i).positions);
+            }
+        }
+    }
+
+    void FuzzyMatcherTests::FilterThroughput()
+    {
+        static constexpr size_t nameCount = 20000;
+        static constexpr std::wstring_view typed{ L"split pane profile 1" };
+
+        const auto names{ _makeNames(nameCount) };
+        FuzzyMatcher matcher;
+        matcher.SetNames(names);
+
+        // Type the filter one character at a time, like the command palette
+        // sees it, once refining the previous matches and once starting over.
+        const auto time = [&](const bool refine) {
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t length = 1; length <= typed.size(); length++)
+            {
+                if (!refine)
+                {
+                    matcher.SetNames(names);
+                }
+                matcher.Filter(typed.substr(0, length));
+            }
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        };
+
+        const auto fromScratch = time(false);
+        matcher.SetNames(names);
+        const auto refined = time(true);
+        VERIFY_IS_FALSE(matcher.Filter(typed).empty());
+
+        Log::Comment(NoThrowString().Format(L"Typed %zu characters over %zu names: %lld us from scratch, %lld us refined",
+                                            typed.size(),
+                                            nameCount,
+                                            fromScratch,
+                                            refined));
+    }
+}
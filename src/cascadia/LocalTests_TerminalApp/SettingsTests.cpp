@@ -43,6 +43,7 @@ namespace TerminalAppLocalTests
         TEST_METHOD(TestMixedNestedAndIterableCommand);
 
         TEST_METHOD(TestIterableColorSchemeCommands);
+        TEST_METHOD(TestIterateOnManyColorSchemes);
 
         TEST_CLASS_SETUP(ClassSetup)
         {
@@ -1202,4 +1203,64 @@ namespace TerminalAppLocalTests
         }
     }
 
+    void SettingsTests::TestIterateOnManyColorSchemes()
+    {
+        // For this test, iterate on enough color schemes to get them expanded
+        // on the thread pool. Each scheme should still get its own command,
+        // with the scheme's name in the name and in the args.
+
+        static constexpr uint32_t schemeCount = 200;
+
+        std::string schemesJson;
+        for (uint32_t i = 0; i < schemeCount; ++i)
+        {
+            // Quotes in the name must survive the expansion, too.
+            schemesJson += fmt::format(R"({{ "name": "scheme_{}\"" }},)", i);
+        }
+
+        const auto settingsJson{ fmt::format(R"(
+        {{
+            "defaultProfile": "{{6239a42c-0000-49a3-80bd-e8fdd045185c}}",
+            "profiles": [
+                {{
+                    "name": "profile0",
+                    "guid": "{{6239a42c-0000-49a3-80bd-e8fdd045185c}}",
+                    "colorScheme": "scheme_0\"",
+                    "commandline": "cmd.exe"
+                }}
+            ],
+            "schemes": [ {} ],
+            "actions": [
+                {{
+                    "name": "iterable command ${{scheme.name}}",
+                    "iterateOn": "schemes",
+                    "command": {{ "action": "splitPane", "profile": "${{scheme.name}}" }}
+                }},
+            ]
+        }})",
+                                             schemesJson) };
+
+        CascadiaSettings settings{ til::u8u16(settingsJson) };
+        VERIFY_ARE_EQUAL(0u, settings.Warnings().Size());
+        VERIFY_ARE_EQUAL(schemeCount, settings.GlobalSettings().ColorSchemes().Size());
+
+        auto nameMap{ settings.ActionMap().NameMap() };
+        VERIFY_ARE_EQUAL(1u, nameMap.Size());
+
+        auto expandedCommands = winrt::TerminalApp::implementation::TerminalPage::_ExpandCommands(nameMap, settings.ActiveProfiles().GetView(), settings.GlobalSettings().ColorSchemes());
+
+        VERIFY_ARE_EQUAL(0u, settings.Warnings().Size());
+        VERIFY_ARE_EQUAL(schemeCount, expandedCommands.Size());
+
+        for (uint32_t i = 0; i < schemeCount; ++i)
+        {
+            const auto schemeName = fmt::format(L"scheme_{}\"", i);
+            auto command = expandedCommands.TryLookup(L"iterable command " + schemeName);
+            VERIFY_IS_NOT_NULL(command);
+            const auto& realArgs = command.ActionAndArgs().Args().try_as<SplitPaneArgs>();
+            VERIFY_IS_NOT_NULL(realArgs);
+            VERIFY_IS_NOT_NULL(realArgs.TerminalArgs());
+            VERIFY_ARE_EQUAL(winrt::hstring{ schemeName }, realArgs.TerminalArgs().Profile());
+        }
+    }
 }
@@ -93,6 +93,8 @@ namespace TerminalAppLocalTests
         TEST_METHOD(TestPreviewDismissScheme);
         TEST_METHOD(TestPreviewSchemeWhilePreviewing);
 
+        TEST_METHOD(TestReloadOnlyChangedProfiles);
+
         TEST_CLASS_SETUP(ClassSetup)
         {
             return true;
@@ -1342,4 +1344,67 @@ namespace TerminalAppLocalTests
         });
     }
 
+    void TabTests::TestReloadOnlyChangedProfiles()
+    {
+        Log::Comment(L"Reload the settings with many tabs open. Make sure only the "
+                     L"tabs of the profile that changed get new settings.");
+
+        auto page = _commonSetup();
+        VERIFY_IS_NOT_NULL(page);
+
+        static constexpr uint32_t tabCount = 32;
+
+        Log::Comment(NoThrowString().Format(L"Create %u tabs with profile1", tabCount));
+        TestOnUIThread([&page]() {
+            for (uint32_t i = 0; i < tabCount; i++)
+            {
+                NewTerminalArgs newTerminalArgs{ 1 };
+                page->_OpenNewTab(newTerminalArgs);
+            }
+        });
+        VERIFY_ARE_EQUAL(tabCount + 1, page->_tabs.Size());
+
+        const auto getParents = [&page]() {
+            std::vector<TerminalSettings> parents;
+            for (const auto& tab : page->_tabs)
+            {
+                const auto control{ page->_GetTerminalTabImpl(tab)->GetActiveTerminalControl() };
+                parents.emplace_back(control.Settings().as<TerminalSettings>().GetParent());
+            }
+            return parents;
+        };
+
+        TestOnUIThread([&]() {
+            Log::Comment(L"Reload the same settings");
+            const auto before{ getParents() };
+            page->_RefreshUIForSettingsReload(page->_settings);
+
+            const auto after{ getParents() };
+            for (size_t i = 0; i < before.size(); i++)
+            {
+                VERIFY_ARE_EQUAL(before.at(i), after.at(i), L"Unchanged tabs keep their settings");
+            }
+        });
+
+        TestOnUIThread([&]() {
+            Log::Comment(L"Change the history size of profile1 and reload");
+            const auto before{ getParents() };
+
+            const auto previousSettings{ page->_settings };
+            auto newSettings{ previousSettings.Copy() };
+            const auto guid2 = Microsoft::Console::Utils::GuidFromString(L"{6239a42c-2222-49a3-80bd-e8fdd045185c}");
+            newSettings.FindProfile(guid2).HistorySize(1000);
+            page->_settings = newSettings;
+
+            page->_RefreshUIForSettingsReload(previousSettings);
+
+            const auto after{ getParents() };
+            VERIFY_ARE_EQUAL(before.at(0), after.at(0), L"The profile0 tab keeps its settings");
+            for (size_t i = 1; i < before.size(); i++)
+            {
+                VERIFY_ARE_NOT_EQUAL(before.at(i), after.at(i), L"The profile1 tabs get new settings");
+                VERIFY_ARE_EQUAL(1000, after.at(i).HistorySize());
+            }
+        });
+    }
 }
@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "../TerminalApp/RecordingTapConnection.h"
+
+#include <array>
+#include <fstream>
+
+using namespace Microsoft::Console;
+using namespace ::Microsoft::Terminal::VtRecording;
+using namespace winrt::Microsoft::Terminal::TerminalConnection;
+
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+using namespace WEX::Common;
+
+namespace TerminalAppLocalTests
+{
+    class VtRecordingTests
+    {
+        BEGIN_TEST_CLASS(VtRecordingTests)
+            TEST_CLASS_PROPERTY(L"RunAs", L"UAP")
+            TEST_CLASS_PROPERTY(L"UAP:AppXManifest", L"TestHostAppXManifest.xml")
+        END_TEST_CLASS()
+
+        TEST_METHOD(RecordEchoConnection);
+        TEST_METHOD(PlaybackOutputOrder);
+
+    private:
+        static std::filesystem::path _tempPath();
+    };
+
+    std::filesystem::path VtRecordingTests::_tempPath()
+    {
+        auto path = std::filesystem::temp_directory_path();
+        path /= fmt::format(L"VtRecordingTests-{}.vtrec", Utils::GuidToString(Utils::CreateGuid()));
+        return path;
+    }
+
+    void VtRecordingTests::RecordEchoConnection()
+    {
+        const auto path = _tempPath();
+        auto cleanup = wil::scope_exit([&]() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        });
+
+        EchoConnection echo{};
+        auto tap = OpenRecordingTapConnection(echo, path);
+
+        std::vector<std::wstring> outputs;
+        tap.TerminalOutput([&](const winrt::hstring& output) {
+            outputs.emplace_back(output);
+        });
+
+        tap.Start();
+        tap.WriteInput(L"ab");
+        tap.WriteInput(L"\x1b");
+        tap.WriteInput(L"\u00e9");
+        tap.Close();
+
+        Log::Comment(L"The output is passed through, after the notice where the recording goes.");
+        VERIFY_ARE_EQUAL(4u, outputs.size());
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"ab" }, std::wstring_view{ outputs.at(1) });
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"^[" }, std::wstring_view{ outputs.at(2) });
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"\u00e9" }, std::wstring_view{ outputs.at(3) });
+
+        std::ifstream file{ path, std::ios::binary };
+        VERIFY_IS_TRUE(file.good());
+        const std::string recording{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+        const auto chunks = Parse(recording);
+
+        Log::Comment(L"Each input and each output is a chunk of its own, in UTF-8. The notice isn't recorded.");
+        VERIFY_ARE_EQUAL(6u, chunks.size());
+        const std::pair<ChunkKind, std::string_view> expected[] = {
+            { ChunkKind::Input, "ab" },
+            { ChunkKind::Output, "ab" },
+            { ChunkKind::Input, "\x1b" },
+            { ChunkKind::Output, "^[" },
+            { ChunkKind::Input, "\xc3\xa9" },
+            { ChunkKind::Output, "\xc3\xa9" },
+        };
+        for (size_t i = 0; i < chunks.size(); i++)
+        {
+            const auto& chunk = chunks.at(i);
+            VERIFY_IS_TRUE(chunk.kind == expected[i].first, NoThrowString().Format(L"chunk %zu", i));
+            VERIFY_ARE_EQUAL(expected[i].second, std::string_view{ chunk.text });
+            if (i > 0)
+            {
+                VERIFY_IS_TRUE(chunk.timestamp >= chunks.at(i - 1).timestamp);
+            }
+        }
+    }
+
+    void VtRecordingTests::PlaybackOutputOrder()
+    {
+        using namespace std::chrono_literals;
+
+        const auto path = _tempPath();
+        auto cleanup = wil::scope_exit([&]() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        });
+
+        // The euro sign is split across two chunks, the way a pty read may
+        // split it. The input chunk must not be played back.
+        auto recording = FormatHeader();
+        AppendChunk(recording, ChunkKind::Output, 0us, "one ");
+        AppendChunk(recording, ChunkKind::Input, 10us, "ignored");
+        AppendChunk(recording, ChunkKind::Output, 20us, "\xe2\x82");
+        AppendChunk(recording, ChunkKind::Output, 30us, "\xac two");
+        AppendChunk(recording, ChunkKind::Output, 40us, "\x1b[m three");
+        {
+            std::ofstream file{ path, std::ios::binary };
+            file.write(recording.data(), gsl::narrow<std::streamsize>(recording.size()));
+            VERIFY_IS_TRUE(file.good());
+        }
+
+        static constexpr std::array<std::wstring_view, 3> expected{ L"one ", L"\u20ac two", L"\x1b[m three" };
+
+        std::mutex outputsLock;
+        std::vector<std::wstring> outputs;
+        wil::unique_event played{ wil::EventOptions::ManualReset };
+
+        PlaybackConnection playback{ winrt::hstring{ path.wstring() }, false };
+        playback.TerminalOutput([&](const winrt::hstring& output) {
+            std::lock_guard<std::mutex> lock{ outputsLock };
+            outputs.emplace_back(output);
+            if (outputs.size() == expected.size())
+            {
+                played.SetEvent();
+            }
+        });
+
+        playback.Start();
+        const auto finished = played.wait(5000);
+        playback.Close();
+        VERIFY_IS_TRUE(finished);
+
+        // After the recording, the connection prints how long it took, which
+        // isn't checked here.
+        std::lock_guard<std::mutex> lock{ outputsLock };
+        VERIFY_IS_GREATER_THAN_OR_EQUAL(outputs.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            VERIFY_ARE_EQUAL(expected.at(i), std::wstring_view{ outputs.at(i) });
+        }
+    }
+}
@@ -1011,18 +1011,20 @@ namespace winrt::TerminalApp::implementation
         }
         else if (_currentMode == CommandPaletteMode::TabSearchMode || _currentMode == CommandPaletteMode::ActionMode || _currentMode == CommandPaletteMode::CommandlineMode)
         {
-            for (const auto& action : commandsToFilter)
+            _updateFilterMatcher(commandsToFilter);
+
+            // If there is active search the matcher skips the commands that
+            // don't match (that would have a weight of 0).
+            for (const auto& match : _filterMatcher.Filter(searchText))
             {
-                // Update filter for all commands
-                // This will modify the highlighting but will also lead to re-computation of weight (and consequently sorting).
-                // Pay attention that it already updates the highlighting in the UI
-                action.UpdateFilter(searchText);
+                const auto& action = til::at(_filterCommands, match.index);
 
-                // if there is active search we skip commands with 0 weight
-                if (searchText.empty() || action.Weight() > 0)
-                {
-                    actions.push_back(action);
-                }
+                // Update filter for the matching commands
+                // This will modify the highlighting and the weight (and consequently sorting),
+                // using the positions and weight the matcher already found.
+                // Pay attention that it already updates the highlighting in the UI
+                winrt::get_self<implementation::FilteredCommand>(action)->UpdateFilter(searchText, match);
+                actions.push_back(action);
             }
         }
 
@@ -1035,6 +1037,53 @@ namespace winrt::TerminalApp::implementation
         return actions;
     }
 
+    // Method Description:
+    // - Makes the fuzzy matcher index the names of the given commands. The
+    //   index is only rebuilt when the list of commands or one of their names
+    //   (e.g. a tab title) changed, so that typing more characters can refine
+    //   the previous matches.
+    // Arguments:
+    // - commands: the commands that are going to be filtered
+    // Return Value:
+    // - <none>
+    void CommandPalette::_updateFilterMatcher(const IVector<winrt::TerminalApp::FilteredCommand>& commands)
+    {
+        const auto size = commands.Size();
+        auto changed = _filterNamesChanged || size != _filterCommands.size();
+        for (uint32_t i = 0; i < size && !changed; i++)
+        {
+            changed = winrt::get_abi(commands.GetAt(i)) != winrt::get_abi(til::at(_filterCommands, i));
+        }
+
+        if (changed)
+        {
+            _filterCommands.clear();
+            _filterCommands.reserve(size);
+            _filterNameChangedRevokers.clear();
+            _filterNameChangedRevokers.reserve(size);
+
+            std::vector<std::wstring> names;
+            names.reserve(size);
+            for (const auto& command : commands)
+            {
+                _filterCommands.push_back(command);
+                names.emplace_back(command.Item().Name());
+
+                // The index holds a copy of the name, so it has to be rebuilt
+                // once the name changes.
+                _filterNameChangedRevokers.push_back(command.Item().PropertyChanged(winrt::auto_revoke, [weakThis{ get_weak() }](auto& /*sender*/, auto& e) {
+                    auto palette{ weakThis.get() };
+                    if (palette && e.PropertyName() == L"Name")
+                    {
+                        palette->_filterNamesChanged = true;
+                    }
+                }));
+            }
+            _filterMatcher.SetNames(std::move(names));
+            _filterNamesChanged = false;
+        }
+    }
+
     // Method Description:
     // - Update our list of filtered actions to reflect the current contents of
     //   the input box.
@@ -1048,36 +1097,53 @@ namespace winrt::TerminalApp::implementation
 
         // Make _filteredActions look identical to actions, using only Insert and Remove.
         // This allows WinUI to nicely animate the ListView as it changes.
-        for (uint32_t i = 0; i < _filteredActions.Size() && i < actions.size(); i++)
+        //
+        // First look up where each item is going to be, so that we never have
+        // to search _filteredActions for it.
+        std::unordered_map<void*, size_t> newIndices;
+        newIndices.reserve(actions.size());
+        for (size_t i = 0; i < actions.size(); i++)
         {
-            for (uint32_t j = i; j < _filteredActions.Size(); j++)
-            {
-                if (_filteredActions.GetAt(j).Item() == actions[i].Item())
-                {
-                    for (uint32_t k = i; k < j; k++)
-                    {
-                        _filteredActions.RemoveAt(i);
-                    }
-                    break;
-                }
-            }
+            newIndices.emplace(winrt::get_abi(til::at(actions, i).Item()), i);
+        }
 
-            if (_filteredActions.GetAt(i).Item() != actions[i].Item())
+        // Keep the items that are still there, as long as they stay in the
+        // same order. Everything else is removed - the items that moved up
+        // will be inserted again at their new position below.
+        const auto oldSize = _filteredActions.Size();
+        std::vector<bool> keep(oldSize, false);
+        size_t nextNewIndex = 0;
+        for (uint32_t i = 0; i < oldSize; i++)
+        {
+            const auto it = newIndices.find(winrt::get_abi(_filteredActions.GetAt(i).Item()));
+            if (it != newIndices.end() && it->second >= nextNewIndex)
             {
-                _filteredActions.InsertAt(i, actions[i]);
+                keep.at(i) = true;
+                nextNewIndex = it->second + 1;
             }
         }
 
-        // Remove any extra trailing items from the destination
-        while (_filteredActions.Size() > actions.size())
+        for (auto i = oldSize; i > 0; i--)
         {
-            _filteredActions.RemoveAtEnd();
+            if (!keep.at(i - 1))
+            {
+                _filteredActions.RemoveAt(i - 1);
+            }
         }
 
-        // Add any extra trailing items from the source
-        while (_filteredActions.Size() < actions.size())
+        // The remaining items are in the same order as in actions, so a single
+        // pass inserts the missing ones in between.
+        for (uint32_t i = 0; i < actions.size(); i++)
         {
-            _filteredActions.Append(actions[_filteredActions.Size()]);
+            const auto& action = til::at(actions, i);
+            if (i == _filteredActions.Size())
+            {
+                _filteredActions.Append(action);
+            }
+            else if (winrt::get_abi(_filteredActions.GetAt(i).Item()) != winrt::get_abi(action.Item()))
+            {
+                _filteredActions.InsertAt(i, action);
+            }
         }
     }
 
@@ -1106,6 +1172,12 @@ namespace winrt::TerminalApp::implementation
 
         ParentCommandName(L"");
         _currentNestedCommands.Clear();
+
+        // Names may change while the palette is closed (e.g. tab titles), so
+        // index them again next time.
+        _filterCommands.clear();
+        _filterNameChangedRevokers.clear();
+        _filterMatcher.SetNames({});
     }
 
     void CommandPalette::EnableTabSwitcherMode(const uint32_t startIdx, TabSwitcherMode tabSwitcherMode)
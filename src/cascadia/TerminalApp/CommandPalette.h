@@ -6,6 +6,7 @@
 #include "FilteredCommand.h"
 #include "CommandPalette.g.h"
 #include "AppCommandlineArgs.h"
+#include "FuzzyMatcher.h"
 #include "../../cascadia/inc/cppwinrt_utils.h"
 
 // fwdecl unittest classes
@@ -99,6 +100,12 @@ namespace winrt::TerminalApp::implementation
 
         std::vector<winrt::TerminalApp::FilteredCommand> _collectFilteredActions();
 
+        FuzzyMatcher _filterMatcher;
+        std::vector<winrt::TerminalApp::FilteredCommand> _filterCommands;
+        std::vector<Windows::UI::Xaml::Data::INotifyPropertyChanged::PropertyChanged_revoker> _filterNameChangedRevokers;
+        bool _filterNamesChanged{ false };
+        void _updateFilterMatcher(const Windows::Foundation::Collections::IVector<winrt::TerminalApp::FilteredCommand>& commands);
+
         void _close();
 
         CommandPaletteMode _currentMode;
@@ -33,8 +33,9 @@ namespace winrt::TerminalApp::implementation
             auto filteredCommand{ weakThis.get() };
             if (filteredCommand && e.PropertyName() == L"Name")
             {
-                filteredCommand->HighlightedName(filteredCommand->_computeHighlightedName());
-                filteredCommand->Weight(filteredCommand->_computeWeight());
+                const auto match = filteredCommand->_matchFilter();
+                filteredCommand->HighlightedName(filteredCommand->_computeHighlightedName(match.positions));
+                filteredCommand->Weight(match.weight);
             }
         });
     }
@@ -46,19 +47,54 @@ namespace winrt::TerminalApp::implementation
         if (filter != _Filter)
         {
             Filter(filter);
-            HighlightedName(_computeHighlightedName());
-            Weight(_computeWeight());
+            const auto match = _matchFilter();
+            HighlightedName(_computeHighlightedName(match.positions));
+            Weight(match.weight);
         }
     }
 
     // Method Description:
-    // - Looks up the filter characters within the item name.
-    // Iterating through the filter and the item name it tries to associate the next filter character
-    // with the first appearance of this character in the item name suffix.
+    // - Same as UpdateFilter(filter), but with the match the command palette's
+    //   FuzzyMatcher already found for this item, so that it isn't looked up again.
+    // Arguments:
+    // - filter: the new filter
+    // - match: the match of the filter within the item name
+    void FilteredCommand::UpdateFilter(winrt::hstring const& filter, const FuzzyMatcher::Match& match)
+    {
+        if (filter != _Filter)
+        {
+            Filter(filter);
+            HighlightedName(_computeHighlightedName(match.positions));
+            Weight(match.weight);
+        }
+    }
+
+    // Method Description:
+    // - Looks up the filter characters within the item name, see FuzzyMatcher::Extend.
+    // Return Value:
+    // - The positions of the matched characters and the weight of the match,
+    //   or an empty match (weight 0) if not all the filter characters were found.
+    FuzzyMatcher::Match FilteredCommand::_matchFilter()
+    {
+        FuzzyMatcher::Match match{};
+        if (!FuzzyMatcher::Extend(FuzzyMatcher::Fold(_Item.Name()), FuzzyMatcher::Fold(_Filter), match))
+        {
+            return {};
+        }
+        return match;
+    }
+
+    winrt::TerminalApp::HighlightedText FilteredCommand::_computeHighlightedName()
+    {
+        return _computeHighlightedName(_matchFilter().positions);
+    }
+
+    // Method Description:
+    // - Highlights the matched characters within the item name.
     //
     // E.g., for filter="c l t s" and name="close all tabs after this", the match will be "CLose TabS after this".
     //
-    // The item name is then split into segments (groupings of matched and non matched characters).
+    // The item name is split into segments (groupings of matched and non matched characters).
     //
     // E.g., the segments were the example above will be "CL", "ose ", "T", "ab", "S", "after this".
     //
@@ -66,157 +102,46 @@ namespace winrt::TerminalApp::implementation
     //
     // E.g., ("CL", true) ("ose ", false), ("T", true), ("ab", false), ("S", true), ("after this", false)
     //
-    // TODO: we probably need to merge this logic with _getWeight computation?
-    //
+    // Arguments:
+    // - positions: the offsets of the matched characters within the item name,
+    //   empty if the item doesn't match the filter.
     // Return Value:
     // - The HighlightedText object initialized with the segments computed according to the algorithm above.
-    winrt::TerminalApp::HighlightedText FilteredCommand::_computeHighlightedName()
+    winrt::TerminalApp::HighlightedText FilteredCommand::_computeHighlightedName(const std::vector<size_t>& positions)
     {
         const auto segments = winrt::single_threaded_observable_vector<winrt::TerminalApp::HighlightedTextSegment>();
-        auto commandName = _Item.Name();
-        bool isProcessingMatchedSegment = false;
-        uint32_t nextOffsetToReport = 0;
-        uint32_t currentOffset = 0;
-
-        for (const auto searchChar : _Filter)
-        {
-            const WCHAR searchCharAsString[] = { searchChar, L'\0' };
-            while (true)
+        const auto commandName = _Item.Name();
+        const auto appendSegment = [&](const size_t offset, const size_t size, const bool isHighlighted) {
+            if (size > 0)
             {
-                if (currentOffset == commandName.size())
-                {
-                    // There are still unmatched filter characters but we finished scanning the name.
-                    // In this case we return the entire item name as unmatched
-                    auto entireNameSegment{ winrt::make<HighlightedTextSegment>(commandName, false) };
-                    segments.Clear();
-                    segments.Append(entireNameSegment);
-                    return winrt::make<HighlightedText>(segments);
-                }
-
-                // GH#9941: search should be locale-aware as well
-                // We use the same comparison method as upon sorting to guarantee consistent behavior
-                const WCHAR currentCharAsString[] = { commandName[currentOffset], L'\0' };
-                auto isCurrentCharMatched = lstrcmpi(searchCharAsString, currentCharAsString) == 0;
-                if (isProcessingMatchedSegment != isCurrentCharMatched)
-                {
-                    // We reached the end of the region (matched character came after a series of unmatched or vice versa).
-                    // Conclude the segment and add it to the list.
-                    // Skip segment if it is empty (might happen when the first character of the name is matched)
-                    auto sizeToReport = currentOffset - nextOffsetToReport;
-                    if (sizeToReport > 0)
-                    {
-                        winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-                        auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, isProcessingMatchedSegment) };
-                        segments.Append(highlightedSegment);
-                        nextOffsetToReport = currentOffset;
-                    }
-                    isProcessingMatchedSegment = isCurrentCharMatched;
-                }
-
-                currentOffset++;
-
-                if (isCurrentCharMatched)
-                {
-                    // We have matched this filter character, let's move to matching the next filter char
-                    break;
-                }
+                winrt::hstring segment{ commandName.data() + offset, gsl::narrow_cast<uint32_t>(size) };
+                segments.Append(winrt::make<HighlightedTextSegment>(segment, isHighlighted));
             }
-        }
+        };
 
-        // Either the filter or the item name were fully processed.
-        // If we were in the middle of the matched segment - add it.
-        if (isProcessingMatchedSegment)
+        size_t nextOffsetToReport = 0;
+        for (size_t i = 0; i < positions.size();)
         {
-            auto sizeToReport = currentOffset - nextOffsetToReport;
-            if (sizeToReport > 0)
+            // Consecutive matched characters make up a single highlighted segment
+            const auto segmentStart = til::at(positions, i);
+            auto segmentEnd = segmentStart + 1;
+            while (++i < positions.size() && til::at(positions, i) == segmentEnd)
             {
-                winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-                auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, true) };
-                segments.Append(highlightedSegment);
-                nextOffsetToReport = currentOffset;
+                segmentEnd++;
             }
+
+            appendSegment(nextOffsetToReport, segmentStart - nextOffsetToReport, false);
+            appendSegment(segmentStart, segmentEnd - segmentStart, true);
+            nextOffsetToReport = segmentEnd;
         }
 
         // Now create a segment for all remaining characters.
         // We will have remaining characters as long as the filter is shorter than the item name.
-        auto sizeToReport = commandName.size() - nextOffsetToReport;
-        if (sizeToReport > 0)
-        {
-            winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-            auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, false) };
-            segments.Append(highlightedSegment);
-        }
+        appendSegment(nextOffsetToReport, commandName.size() - nextOffsetToReport, false);
 
         return winrt::make<HighlightedText>(segments);
     }
 
-    // Function Description:
-    // - Calculates a "weighting" by which should be used to order a item
-    //   name relative to other names, given a specific search string.
-    //   Currently, this is based off of two factors:
-    //   * The weight is incremented once for each matched character of the
-    //     search text.
-    //   * If a matching character from the search text was found at the start
-    //     of a word in the name, then we increment the weight again.
-    //     * For example, for a search string "sp", we want "Split Pane" to
-    //       appear in the list before "Close Pane"
-    //   * Consecutive matches will be weighted higher than matches with
-    //     characters in between the search characters.
-    // - This will return 0 if the item should not be shown. If all the
-    //   characters of search text appear in order in `name`, then this function
-    //   will return a positive number. There can be any number of characters
-    //   separating consecutive characters in searchText.
-    //   * For example:
-    //      "name": "New Tab"
-    //      "name": "Close Tab"
-    //      "name": "Close Pane"
-    //      "name": "[-] Split Horizontal"
-    //      "name": "[ | ] Split Vertical"
-    //      "name": "Next Tab"
-    //      "name": "Prev Tab"
-    //      "name": "Open Settings"
-    //      "name": "Open Media Controls"
-    //   * "open" should return both "**Open** Settings" and "**Open** Media Controls".
-    //   * "Tab" would return "New **Tab**", "Close **Tab**", "Next **Tab**" and "Prev
-    //     **Tab**".
-    //   * "P" would return "Close **P**ane", "[-] S**p**lit Horizontal", "[ | ]
-    //     S**p**lit Vertical", "**P**rev Tab", "O**p**en Settings" and "O**p**en Media
-    //     Controls".
-    //   * "sv" would return "[ | ] Split Vertical" (by matching the **S** in
-    //     "Split", then the **V** in "Vertical").
-    // Arguments:
-    // - searchText: the string of text to search for in `name`
-    // - name: the name to check
-    // Return Value:
-    // - the relative weight of this match
-    int FilteredCommand::_computeWeight()
-    {
-        int result = 0;
-        bool isNextSegmentWordBeginning = true;
-
-        for (const auto& segment : _HighlightedName.Segments())
-        {
-            const auto& segmentText = segment.TextSegment();
-            const auto segmentSize = segmentText.size();
-
-            if (segment.IsHighlighted())
-            {
-                // Give extra point for each consecutive match
-                result += (segmentSize <= 1) ? segmentSize : 1 + 2 * (segmentSize - 1);
-
-                // Give extra point if this segment is at the beginning of a word
-                if (isNextSegmentWordBeginning)
-                {
-                    result++;
-                }
-            }
-
-            isNextSegmentWordBeginning = segmentSize > 0 && segmentText[segmentSize - 1] == L' ';
-        }
-
-        return result;
-    }
-
     // Function Description:
     // - Implementation of Compare for FilteredCommand interface.
     // Compares first instance of the interface with the second instance, first by weight, then by name.
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "HighlightedTextControl.h"
+#include "FuzzyMatcher.h"
 #include "FilteredCommand.g.h"
 #include "../../cascadia/inc/cppwinrt_utils.h"
 
@@ -21,6 +22,7 @@ namespace winrt::TerminalApp::implementation
         FilteredCommand(winrt::TerminalApp::PaletteItem const& item);
 
         void UpdateFilter(winrt::hstring const& filter);
+        void UpdateFilter(winrt::hstring const& filter, const FuzzyMatcher::Match& match);
 
         static int Compare(winrt::TerminalApp::FilteredCommand const& first, winrt::TerminalApp::FilteredCommand const& second);
 
@@ -31,8 +33,9 @@ namespace winrt::TerminalApp::implementation
         WINRT_OBSERVABLE_PROPERTY(int, Weight, _PropertyChangedHandlers);
 
     private:
+        FuzzyMatcher::Match _matchFilter();
         winrt::TerminalApp::HighlightedText _computeHighlightedName();
-        int _computeWeight();
+        winrt::TerminalApp::HighlightedText _computeHighlightedName(const std::vector<size_t>& positions);
         Windows::UI::Xaml::Data::INotifyPropertyChanged::PropertyChanged_revoker _itemChangedRevoker;
 
         friend class TerminalAppLocalTests::FilteredCommandTests;
@@ -0,0 +1,152 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "FuzzyMatcher.h"
+
+using namespace winrt::TerminalApp;
+
+// Function Description:
+// - Lowercases the given text, so that it can be matched case-insensitively
+//   with a plain character comparison. The result has the same length as the
+//   text, so offsets into it are offsets into the original text.
+// Arguments:
+// - text: the text to fold
+// Return Value:
+// - the lowercased text
+std::wstring FuzzyMatcher::Fold(const std::wstring_view text)
+{
+    std::wstring folded{ text };
+    if (!folded.empty())
+    {
+        // GH#9941: Use the user's locale, like the comparison used to sort
+        // the commands does.
+        CharLowerBuffW(folded.data(), gsl::narrow<DWORD>(folded.size()));
+    }
+    return folded;
+}
+
+// Method Description:
+// - Replaces the names to match against. The previous matches are discarded.
+// Arguments:
+// - names: the names to index
+// Return Value:
+// - <none>
+void FuzzyMatcher::SetNames(std::vector<std::wstring> names)
+{
+    for (auto& name : names)
+    {
+        name = Fold(name);
+    }
+    _names = std::move(names);
+    _matches.clear();
+    _filter.clear();
+    _valid = false;
+}
+
+size_t FuzzyMatcher::Size() const noexcept
+{
+    return _names.size();
+}
+
+// Method Description:
+// - Finds the names that match the given filter, see Extend.
+// - If the filter starts with the previous filter, only the previous matches
+//   can match, and each of them is continued from where its match ended.
+//   Otherwise all the names are searched again.
+// Arguments:
+// - filter: the characters to look for. An empty filter matches every name.
+// Return Value:
+// - The matches, in the order the names were indexed. These are what
+//   FilteredCommand::UpdateFilter highlights and sorts by.
+const std::vector<FuzzyMatcher::Match>& FuzzyMatcher::Filter(const std::wstring_view filter)
+{
+    auto folded{ Fold(filter) };
+    std::wstring_view appended{ folded };
+
+    if (_valid && appended.substr(0, _filter.size()) == _filter)
+    {
+        appended = appended.substr(_filter.size());
+    }
+    else
+    {
+        _matches.clear();
+        _matches.reserve(_names.size());
+        for (size_t i = 0; i < _names.size(); i++)
+        {
+            _matches.push_back({ i, {}, 0 });
+        }
+    }
+
+    if (!appended.empty())
+    {
+        // Keep the matches that can be continued with the new characters,
+        // compacting them in place.
+        size_t kept = 0;
+        for (size_t i = 0; i < _matches.size(); i++)
+        {
+            auto& match = til::at(_matches, i);
+            if (Extend(til::at(_names, match.index), appended, match))
+            {
+                if (kept != i)
+                {
+                    til::at(_matches, kept) = std::move(match);
+                }
+                kept++;
+            }
+        }
+        _matches.resize(kept);
+    }
+
+    _filter = std::move(folded);
+    _valid = true;
+    return _matches;
+}
+
+// Function Description:
+// - Continues a match with more filter characters. Each filter character is
+//   matched to its first appearance after the previous match. E.g., for
+//   filter="clts" and name="close all tabs after this", the positions are
+//   those of "CLose all TabS after this". An empty match matches from scratch.
+// - The weight of the match is updated along the way:
+//   * A character that immediately follows the previous match adds 2 points,
+//     consecutive matches are weighted higher.
+//   * Any other character adds 1 point, and another one if it's at the
+//     beginning of a word. For the filter "sp", "Split Pane" weighs more
+//     than "Close Pane".
+// Arguments:
+// - foldedName: the name to search, as returned by Fold
+// - foldedFilter: the characters to add to the match, as returned by Fold
+// - match: the match to continue
+// Return Value:
+// - false if one of the characters couldn't be found. The match is no longer
+//   valid in that case.
+bool FuzzyMatcher::Extend(const std::wstring_view foldedName, const std::wstring_view foldedFilter, Match& match)
+{
+    match.positions.reserve(match.positions.size() + foldedFilter.size());
+
+    for (const auto ch : foldedFilter)
+    {
+        const auto nextOffset = match.positions.empty() ? 0 : match.positions.back() + 1;
+        const auto position = foldedName.find(ch, nextOffset);
+        if (position == std::wstring_view::npos)
+        {
+            return false;
+        }
+
+        if (!match.positions.empty() && position == nextOffset)
+        {
+            match.weight += 2;
+        }
+        else
+        {
+            match.weight++;
+            if (position == 0 || til::at(foldedName, position - 1) == L' ')
+            {
+                match.weight++;
+            }
+        }
+        match.positions.push_back(position);
+    }
+    return true;
+}
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+// Module Name:
+// - FuzzyMatcher.h
+//
+// Abstract:
+// - The FuzzyMatcher finds the names in which all the characters of a filter
+// appear in order, along with the positions of the matched characters (which
+// FilteredCommand highlights) and the weight of each match (which the command
+// palette sorts by). The names are lowercased once when they are indexed.
+// When the filter grows by appending characters (the user typing), only the
+// previous matches are searched again, and each of them resumes where its
+// last match ended.
+//
+
+#pragma once
+
+namespace winrt::TerminalApp
+{
+    class FuzzyMatcher
+    {
+    public:
+        struct Match
+        {
+            // The index of the matched name, in the order they were indexed.
+            size_t index;
+            // The offset of each matched character in the name.
+            std::vector<size_t> positions;
+            int weight;
+        };
+
+        static std::wstring Fold(const std::wstring_view text);
+        static bool Extend(const std::wstring_view foldedName, const std::wstring_view foldedFilter, Match& match);
+
+        void SetNames(std::vector<std::wstring> names);
+        size_t Size() const noexcept;
+
+        const std::vector<Match>& Filter(const std::wstring_view filter);
+
+    private:
+        std::vector<std::wstring> _names;
+        std::vector<Match> _matches;
+        std::wstring _filter;
+        bool _valid{ false };
+    };
+}
@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "RecordingTapConnection.h"
+
+using namespace ::winrt::Microsoft::Terminal::TerminalConnection;
+using namespace ::winrt::Windows::Foundation;
+using namespace ::Microsoft::Terminal::VtRecording;
+
+namespace winrt::Microsoft::TerminalApp::implementation
+{
+    RecordingTapConnection::RecordingTapConnection(ITerminalConnection wrappedConnection, const std::filesystem::path& path) :
+        _wrappedConnection{ std::move(wrappedConnection) },
+        _path{ path },
+        _start{ std::chrono::steady_clock::now() }
+    {
+        _file.reset(CreateFileW(_path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+        THROW_LAST_ERROR_IF(!_file);
+
+        const auto header = FormatHeader();
+        DWORD written{};
+        THROW_IF_WIN32_BOOL_FALSE(WriteFile(_file.get(), header.data(), gsl::narrow<DWORD>(header.size()), &written, nullptr));
+
+        _outputRevoker = _wrappedConnection.TerminalOutput(winrt::auto_revoke, { this, &RecordingTapConnection::_OutputHandler });
+        _stateChangedRevoker = _wrappedConnection.StateChanged(winrt::auto_revoke, [this](auto&& /*s*/, auto&& /*e*/) {
+            _StateChangedHandlers(*this, nullptr);
+        });
+    }
+
+    void RecordingTapConnection::Start()
+    {
+        // Let the user know where to find the recording. This isn't part of
+        // the recording itself.
+        _TerminalOutputHandlers(wil::str_printf<std::wstring>(L"\x1b[93m[recording to %ls]\x1b[m\r\n", _path.c_str()));
+
+        _start = std::chrono::steady_clock::now();
+        _wrappedConnection.Start();
+    }
+
+    void RecordingTapConnection::WriteInput(hstring const& data)
+    {
+        _Record(ChunkKind::Input, data);
+        _wrappedConnection.WriteInput(data);
+    }
+
+    void RecordingTapConnection::Resize(uint32_t rows, uint32_t columns)
+    {
+        _wrappedConnection.Resize(rows, columns);
+    }
+
+    void RecordingTapConnection::Close()
+    {
+        _wrappedConnection.Close();
+
+        // The handlers capture a raw `this`. Let the wrapped connection report
+        // that it closed first, then stop it from calling into us.
+        _outputRevoker.revoke();
+        _stateChangedRevoker.revoke();
+
+        std::lock_guard<std::mutex> lock{ _recordingLock };
+        _file.reset();
+    }
+
+    ConnectionState RecordingTapConnection::State() const noexcept
+    {
+        return _wrappedConnection.State();
+    }
+
+    void RecordingTapConnection::_OutputHandler(const hstring& str)
+    {
+        _Record(ChunkKind::Output, str);
+        _TerminalOutputHandlers(str);
+    }
+
+    // Method Description:
+    // - Appends a chunk to the recording. The chunk is written to the file
+    //   right away, so that a session that crashes is still recorded.
+    // - Failing to record is logged, but doesn't interrupt the session.
+    // Arguments:
+    // - kind: whether the text was output or input
+    // - text: the text of the chunk
+    // Return Value:
+    // - <none>
+    void RecordingTapConnection::_Record(const ChunkKind kind, const std::wstring_view text) noexcept
+    try
+    {
+        const auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start);
+
+        std::lock_guard<std::mutex> lock{ _recordingLock };
+        if (!_file)
+        {
+            return;
+        }
+
+        THROW_IF_FAILED(til::u16u8(text, _utf8));
+        _chunk.clear();
+        AppendChunk(_chunk, kind, timestamp, _utf8);
+        DWORD written{};
+        THROW_IF_WIN32_BOOL_FALSE(WriteFile(_file.get(), _chunk.data(), gsl::narrow<DWORD>(_chunk.size()), &written, nullptr));
+    }
+    CATCH_LOG()
+}
+
+// Function Description
+// - Takes a connection and returns one that can be used in place of it, and
+//   records everything that goes through it to the given file.
+ITerminalConnection OpenRecordingTapConnection(ITerminalConnection baseConnection, const std::filesystem::path& path)
+{
+    using namespace winrt::Microsoft::TerminalApp::implementation;
+    return winrt::make<RecordingTapConnection>(std::move(baseConnection), path);
+}
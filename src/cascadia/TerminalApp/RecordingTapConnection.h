@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <winrt/Microsoft.Terminal.TerminalConnection.h>
+#include "../../inc/cppwinrt_utils.h"
+#include "../inc/VtRecording.h"
+
+namespace winrt::Microsoft::TerminalApp::implementation
+{
+    // The RecordingTapConnection is used in place of another connection. It
+    // passes everything through, and writes every output chunk and every
+    // input string to a recording (see VtRecording.h), which can then be
+    // replayed with the PlaybackConnection.
+    class RecordingTapConnection : public winrt::implements<RecordingTapConnection, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection>
+    {
+    public:
+        RecordingTapConnection(Microsoft::Terminal::TerminalConnection::ITerminalConnection wrappedConnection, const std::filesystem::path& path);
+        void Start();
+        void WriteInput(hstring const& data);
+        void Resize(uint32_t rows, uint32_t columns);
+        void Close();
+        winrt::Microsoft::Terminal::TerminalConnection::ConnectionState State() const noexcept;
+
+        WINRT_CALLBACK(TerminalOutput, winrt::Microsoft::Terminal::TerminalConnection::TerminalOutputHandler);
+
+        TYPED_EVENT(StateChanged, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection, winrt::Windows::Foundation::IInspectable);
+
+    private:
+        void _OutputHandler(const hstring& str);
+        void _Record(const ::Microsoft::Terminal::VtRecording::ChunkKind kind, const std::wstring_view text) noexcept;
+
+        Microsoft::Terminal::TerminalConnection::ITerminalConnection _wrappedConnection;
+
+        std::filesystem::path _path;
+        std::chrono::steady_clock::time_point _start;
+
+        // The output arrives on the connection's thread and the input on the
+        // UI thread, so the recording is guarded by a lock.
+        std::mutex _recordingLock;
+        wil::unique_hfile _file;
+        std::string _utf8;
+        std::string _chunk;
+
+        // These are declared last so that they're destroyed first, before
+        // the members the handlers use.
+        winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection::TerminalOutput_revoker _outputRevoker;
+        winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection::StateChanged_revoker _stateChangedRevoker;
+    };
+}
+
+winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection OpenRecordingTapConnection(winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection baseConnection, const std::filesystem::path& path);
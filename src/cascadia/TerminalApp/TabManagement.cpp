@@ -18,6 +18,7 @@
 #include "TabRowControl.h"
 #include "ColorHelper.h"
 #include "DebugTapConnection.h"
+#include "RecordingTapConnection.h"
 #include "SettingsTab.h"
 
 using namespace winrt;
@@ -113,7 +114,20 @@ namespace winrt::TerminalApp::implementation
             const auto lAltState = window.GetKeyState(VirtualKey::LeftMenu);
             const bool bothAltsPressed = WI_IsFlagSet(lAltState, CoreVirtualKeyStates::Down) &&
                                          WI_IsFlagSet(rAltState, CoreVirtualKeyStates::Down);
-            if (bothAltsPressed)
+            const auto shiftPressed = WI_IsFlagSet(window.GetKeyState(VirtualKey::Shift), CoreVirtualKeyStates::Down);
+            if (bothAltsPressed && shiftPressed)
+            {
+                // Record the session to a file, so that it can be played
+                // back later with a PlaybackConnection.
+                auto path = std::filesystem::temp_directory_path();
+                path /= fmt::format(L"WindowsTerminal-{}.vtrec", Utils::GuidToString(Utils::CreateGuid()));
+                try
+                {
+                    connection = OpenRecordingTapConnection(connection, path);
+                }
+                CATCH_LOG();
+            }
+            else if (bothAltsPressed)
             {
                 std::tie(connection, debugConnection) = OpenDebugTapConnection(connection);
             }
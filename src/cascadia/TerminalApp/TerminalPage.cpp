@@ -94,6 +94,7 @@ namespace winrt::TerminalApp::implementation
 
     winrt::fire_and_forget TerminalPage::SetSettings(CascadiaSettings settings, bool needRefreshUI)
     {
+        const auto previousSettings{ _settings };
         _settings = settings;
 
         auto weakThis{ get_weak() };
@@ -110,7 +111,7 @@ namespace winrt::TerminalApp::implementation
 
             if (needRefreshUI)
             {
-                _RefreshUIForSettingsReload();
+                _RefreshUIForSettingsReload(previousSettings);
             }
 
             // Upon settings update we reload the system settings for scrolling as well.
@@ -792,6 +793,38 @@ namespace winrt::TerminalApp::implementation
                                                               winrt::guid());
         }
 
+        else if (connectionType == TerminalConnection::PlaybackConnection::ConnectionType())
+        {
+            // The commandline of a playback profile is the path to the
+            // recording, quoted if it contains spaces. With "--realtime", the
+            // recording is played back with its original timing instead of
+            // as fast as possible.
+            const auto commandline{ settings.Commandline() };
+            winrt::hstring path;
+            auto realTime = false;
+            // CommandLineToArgvW returns the path of our own executable for
+            // an empty commandline.
+            if (!commandline.empty())
+            {
+                int argc = 0;
+                wil::unique_any<LPWSTR*, decltype(&::LocalFree), ::LocalFree> argv{ CommandLineToArgvW(commandline.c_str(), &argc) };
+                THROW_LAST_ERROR_IF(!argv);
+                for (int i = 0; i < argc; i++)
+                {
+                    const std::wstring_view arg{ argv.get()[i] };
+                    if (arg == L"--realtime")
+                    {
+                        realTime = true;
+                    }
+                    else
+                    {
+                        path = arg;
+                    }
+                }
+            }
+            connection = TerminalConnection::PlaybackConnection(path, realTime);
+        }
+
         else
         {
             std::wstring guidWString = Utils::GuidToString(profileGuid);
@@ -1830,7 +1863,13 @@ namespace winrt::TerminalApp::implementation
     //   This includes update the settings of all the tabs according
     //   to their profiles, update the title and icon of each tab, and
     //   finally create the tab flyout
-    winrt::fire_and_forget TerminalPage::_RefreshUIForSettingsReload()
+    // - Only the panes of profiles whose settings differ from the previous
+    //   settings are updated. Applying settings to a control reloads its
+    //   colors and renderer state, which adds up with many panes open.
+    //   Everything else is refreshed on every reload.
+    // Arguments:
+    // - previousSettings: the settings we used before this reload. May be null.
+    winrt::fire_and_forget TerminalPage::_RefreshUIForSettingsReload(const CascadiaSettings previousSettings)
     {
         // Re-wire the keybindings to their handlers, as we'll have created a
         // new AppKeyBindings object.
@@ -1847,6 +1886,12 @@ namespace winrt::TerminalApp::implementation
                 // This can throw an exception if the profileGuid does
                 // not belong to an actual profile in the list of profiles.
                 auto settings{ TerminalSettings::CreateWithProfileByID(_settings, profileGuid, *_bindings) };
+                if (!_ProfileSettingsChanged(previousSettings, profileGuid, settings))
+                {
+                    // The panes of this profile would look and behave exactly
+                    // the same. The tabs are refreshed below regardless.
+                    continue;
+                }
 
                 for (auto tab : _tabs)
                 {
@@ -1871,6 +1916,7 @@ namespace winrt::TerminalApp::implementation
         {
             if (auto terminalTab = _GetTerminalTabImpl(tab))
             {
+                terminalTab->UpdateGlobalSettings();
                 _UpdateTabIcon(*terminalTab);
 
                 // Force the TerminalTab to re-grab its currently active control's title.
@@ -1909,6 +1955,31 @@ namespace winrt::TerminalApp::implementation
         WUX::Media::Animation::Timeline::AllowDependentAnimations(!_settings.GlobalSettings().DisableAnimations());
     }
 
+    // Method Description:
+    // - Checks whether the settings of the given profile differ between the
+    //   previous and the current settings, to find the panes that need to be
+    //   updated after a reload.
+    // Arguments:
+    // - previousSettings: the settings we used before the reload. May be null.
+    // - profileGuid: the profile to check
+    // - settings: the TerminalSettings of the profile in the current settings
+    // Return Value:
+    // - false if the profile existed before and resolves to equivalent
+    //   TerminalSettings, otherwise true.
+    bool TerminalPage::_ProfileSettingsChanged(const CascadiaSettings& previousSettings,
+                                               const winrt::guid& profileGuid,
+                                               const TerminalSettingsCreateResult& settings)
+    {
+        if (!previousSettings || !previousSettings.FindProfile(profileGuid))
+        {
+            return true;
+        }
+
+        const auto previous{ TerminalSettings::CreateWithProfileByID(previousSettings, profileGuid, *_bindings) };
+        return !TerminalSettings::Equivalent(previous.DefaultSettings(), settings.DefaultSettings()) ||
+               !TerminalSettings::Equivalent(previous.UnfocusedSettings(), settings.UnfocusedSettings());
+    }
+
     // This is a helper to aid in sorting commands by their `Name`s, alphabetically.
     static bool _compareSchemeNames(const ColorScheme& lhs, const ColorScheme& rhs)
     {
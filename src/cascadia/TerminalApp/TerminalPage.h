@@ -296,7 +296,10 @@ namespace winrt::TerminalApp::implementation
         winrt::Microsoft::Terminal::Control::TermControl _InitControl(const winrt::Microsoft::Terminal::Settings::Model::TerminalSettingsCreateResult& settings,
                                                                       const winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection& connection);
 
-        winrt::fire_and_forget _RefreshUIForSettingsReload();
+        winrt::fire_and_forget _RefreshUIForSettingsReload(const Microsoft::Terminal::Settings::Model::CascadiaSettings previousSettings);
+        bool _ProfileSettingsChanged(const Microsoft::Terminal::Settings::Model::CascadiaSettings& previousSettings,
+                                     const winrt::guid& profileGuid,
+                                     const Microsoft::Terminal::Settings::Model::TerminalSettingsCreateResult& settings);
 
         void _SetNonClientAreaColors(const Windows::UI::Color& selectedTabColor);
         void _ClearNonClientAreaColors();
@@ -227,7 +227,17 @@ namespace winrt::TerminalApp::implementation
     void TerminalTab::UpdateSettings(const TerminalSettingsCreateResult& settings, const GUID& profile)
     {
         _rootPane->UpdateSettings(settings, profile);
+    }
 
+    // Method Description:
+    // - Updates the parts of this tab that depend on the global settings rather
+    //   than on the profiles of its panes. Called on every settings reload.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void TerminalTab::UpdateGlobalSettings()
+    {
         // The tabWidthMode may have changed, update the header control accordingly
         _UpdateHeaderControlMaxWidth();
     }
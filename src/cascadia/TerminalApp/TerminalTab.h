@@ -56,6 +56,7 @@ namespace winrt::TerminalApp::implementation
         bool FocusPane(const uint32_t id);
 
         void UpdateSettings(const Microsoft::Terminal::Settings::Model::TerminalSettingsCreateResult& settings, const GUID& profile);
+        void UpdateGlobalSettings();
         winrt::fire_and_forget UpdateTitle();
 
         void Shutdown() override;
@@ -0,0 +1,187 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "PlaybackConnection.h"
+#include <LibraryResources.h>
+
+#include "PlaybackConnection.g.cpp"
+
+#include "../cascadia/inc/VtRecording.h"
+
+using namespace ::Microsoft::Terminal::VtRecording;
+
+static constexpr winrt::guid PlaybackConnectionType = { 0x32996926, 0xbbf3, 0x4c51, { 0x84, 0xd6, 0xf4, 0x2d, 0x7c, 0x50, 0xee, 0x6d } };
+
+// Function Description:
+// - Reads a whole file into memory.
+// Arguments:
+// - path: the file to read
+// Return Value:
+// - the contents of the file
+static std::string _readFile(const std::wstring_view path)
+{
+    wil::unique_hfile file{ CreateFileW(path.data(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    THROW_LAST_ERROR_IF(!file);
+
+    LARGE_INTEGER size{};
+    THROW_IF_WIN32_BOOL_FALSE(GetFileSizeEx(file.get(), &size));
+
+    std::string contents(gsl::narrow<size_t>(size.QuadPart), '\0');
+    DWORD read{};
+    THROW_IF_WIN32_BOOL_FALSE(ReadFile(file.get(), contents.data(), gsl::narrow<DWORD>(contents.size()), &read, nullptr));
+    contents.resize(read);
+    return contents;
+}
+
+namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
+{
+    winrt::guid PlaybackConnection::ConnectionType() noexcept
+    {
+        return PlaybackConnectionType;
+    }
+
+    // Arguments:
+    // - path: the recording to play back
+    // - realTime: if true, every chunk is written at the time it was
+    //   recorded. Otherwise the chunks are written as fast as the terminal
+    //   accepts them.
+    PlaybackConnection::PlaybackConnection(const hstring& path, const bool realTime) :
+        _path{ path },
+        _realTime{ realTime }
+    {
+    }
+
+    void PlaybackConnection::Start()
+    {
+        _transitionToState(ConnectionState::Connected);
+
+        _hPlaybackThread.reset(CreateThread(
+            nullptr,
+            0,
+            [](LPVOID lpParameter) noexcept {
+                PlaybackConnection* const pInstance = static_cast<PlaybackConnection*>(lpParameter);
+                if (pInstance)
+                {
+                    return pInstance->_PlaybackThread();
+                }
+                return gsl::narrow_cast<DWORD>(E_INVALIDARG);
+            },
+            this,
+            0,
+            nullptr));
+
+        THROW_LAST_ERROR_IF_NULL(_hPlaybackThread);
+
+        LOG_IF_FAILED(SetThreadDescription(_hPlaybackThread.get(), L"PlaybackConnection Output Thread"));
+    }
+
+    // Method Description:
+    // - The recorded session can't react to anything the user types, so
+    //   input is ignored.
+    void PlaybackConnection::WriteInput(const hstring& /*data*/) noexcept
+    {
+    }
+
+    void PlaybackConnection::Resize(uint32_t /*rows*/, uint32_t /*columns*/) noexcept
+    {
+    }
+
+    void PlaybackConnection::Close()
+    {
+        if (_transitionToState(ConnectionState::Closing))
+        {
+            _closingEvent.SetEvent();
+
+            if (_hPlaybackThread)
+            {
+                // Tear down our playback thread
+                WaitForSingleObject(_hPlaybackThread.get(), INFINITE);
+                _hPlaybackThread.reset();
+            }
+
+            _transitionToState(ConnectionState::Closed);
+        }
+    }
+
+    DWORD PlaybackConnection::_PlaybackThread() noexcept
+    {
+        // Keep us alive until the playback thread terminates; the destructor
+        // won't wait for us.
+        auto strongThis{ get_strong() };
+
+        try
+        {
+            _Play();
+            return 0;
+        }
+        catch (...)
+        {
+            const auto hr = wil::ResultFromCaughtException();
+            if (!_isStateAtOrBeyond(ConnectionState::Closing))
+            {
+                try
+                {
+                    winrt::hstring failureText{ fmt::format(std::wstring_view{ RS_(L"PlaybackFailed") },
+                                                            gsl::narrow_cast<unsigned long>(hr),
+                                                            _path) };
+                    _TerminalOutputHandlers(failureText);
+                }
+                CATCH_LOG();
+
+                _transitionToState(ConnectionState::Failed);
+            }
+            return gsl::narrow_cast<DWORD>(hr);
+        }
+    }
+
+    // Method Description:
+    // - Writes the output chunks of the recording, decoded the same way
+    //   ConptyConnection decodes what it reads, one TerminalOutput per chunk.
+    //   Once done, prints how long it took the terminal to process them.
+    void PlaybackConnection::_Play()
+    {
+        const auto chunks = Parse(_readFile(_path));
+
+        til::u8state u8State{};
+        std::wstring u16Str;
+        size_t bytes = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto& chunk : chunks)
+        {
+            if (chunk.kind != ChunkKind::Output)
+            {
+                continue;
+            }
+
+            if (_realTime)
+            {
+                // Wait until the chunk is due, unless we fell behind already.
+                const auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(start + chunk.timestamp - std::chrono::steady_clock::now());
+                if (delay.count() > 0 && WaitForSingleObject(_closingEvent.get(), gsl::narrow<DWORD>(delay.count())) == WAIT_OBJECT_0)
+                {
+                    return;
+                }
+            }
+
+            if (_isStateAtOrBeyond(ConnectionState::Closing))
+            {
+                return;
+            }
+
+            THROW_IF_FAILED(til::u8u16(std::string_view{ chunk.text }, u16Str, u8State));
+            if (!u16Str.empty())
+            {
+                _TerminalOutputHandlers(winrt::hstring{ u16Str });
+            }
+            bytes += chunk.text.size();
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        winrt::hstring finishedText{ fmt::format(std::wstring_view{ RS_(L"PlaybackFinished") },
+                                                 bytes,
+                                                 elapsed.count()) };
+        _TerminalOutputHandlers(L"\r\n");
+        _TerminalOutputHandlers(finishedText);
+    }
+}
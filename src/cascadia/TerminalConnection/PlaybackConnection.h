@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "PlaybackConnection.g.h"
+
+#include "../cascadia/inc/cppwinrt_utils.h"
+#include "ConnectionStateHolder.h"
+
+namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
+{
+    // The PlaybackConnection replays the output of a session that was
+    // recorded with the RecordingTapConnection (see VtRecording.h), either
+    // with the timing of the recording or as fast as possible.
+    struct PlaybackConnection : PlaybackConnectionT<PlaybackConnection>, ConnectionStateHolder<PlaybackConnection>
+    {
+        static winrt::guid ConnectionType() noexcept;
+        PlaybackConnection(const hstring& path, const bool realTime);
+
+        void Start();
+        void WriteInput(const hstring& data) noexcept;
+        void Resize(uint32_t rows, uint32_t columns) noexcept;
+        void Close();
+
+        WINRT_CALLBACK(TerminalOutput, TerminalOutputHandler);
+
+    private:
+        hstring _path;
+        bool _realTime{ false };
+
+        wil::unique_event _closingEvent{ wil::EventOptions::ManualReset };
+        wil::unique_handle _hPlaybackThread;
+
+        DWORD _PlaybackThread() noexcept;
+        void _Play();
+    };
+}
+
+namespace winrt::Microsoft::Terminal::TerminalConnection::factory_implementation
+{
+    struct PlaybackConnection : PlaybackConnectionT<PlaybackConnection, implementation::PlaybackConnection>
+    {
+    };
+}
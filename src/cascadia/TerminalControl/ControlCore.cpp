@@ -136,7 +136,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             // to paint itself *after* we hand off its ownership to the renderer.
             // We split up construction and initialization of the render thread object this way
             // because the renderer and render thread have circular references to each other.
-            auto renderThread = std::make_unique<::Microsoft::Console::Render::RenderThread>();
+            // All the panes in the process paint from the shared thread pool, rather
+            // than each of them owning a thread that's idle most of the time.
+            auto renderThread = std::make_unique<::Microsoft::Console::Render::PooledRenderThread>();
             auto* const localPointerToThread = renderThread.get();
 
             // Now create the renderer and initialize the render thread.
@@ -511,8 +513,17 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         //      The family is only used to determine if the font is truetype or
         //      not, but DX doesn't use that info at all.
         //      The Codepage is additionally not actually used by the DX engine at all.
-        _actualFont = { fontFace, 0, fontWeight.Weight, { 0, fontHeight }, CP_UTF8, false };
-        _desiredFont = { _actualFont };
+        const FontInfo newFont{ fontFace, 0, fontWeight.Weight, { 0, fontHeight }, CP_UTF8, false };
+        const FontInfoDesired newDesiredFont{ newFont };
+
+        // Reloading the font is by far the most expensive part of applying new
+        // settings, so only do it when the settings actually changed the font.
+        const auto fontChanged = !(newDesiredFont == _desiredFont);
+        if (fontChanged)
+        {
+            _actualFont = newFont;
+            _desiredFont = newDesiredFont;
+        }
 
         // Update the terminal core with its new Core settings
         _terminal->UpdateSettings(_settings);
@@ -528,13 +539,16 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _renderEngine->SetSoftwareRendering(_settings.SoftwareRendering());
         _updateAntiAliasingMode(_renderEngine.get());
 
-        // Refresh our font with the renderer
-        const auto actualFontOldSize = _actualFont.GetSize();
-        _updateFont();
-        const auto actualFontNewSize = _actualFont.GetSize();
-        if (actualFontNewSize != actualFontOldSize)
+        if (fontChanged)
         {
-            _refreshSizeUnderLock();
+            // Refresh our font with the renderer
+            const auto actualFontOldSize = _actualFont.GetSize();
+            _updateFont();
+            const auto actualFontNewSize = _actualFont.GetSize();
+            if (actualFontNewSize != actualFontOldSize)
+            {
+                _refreshSizeUnderLock();
+            }
         }
     }
 
@@ -833,35 +847,19 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             return false;
         }
 
-        // extract text from buffer
-        // RetrieveSelectedTextFromBuffer will lock while it's reading
-        const auto bufferData = _terminal->RetrieveSelectedTextFromBuffer(singleLine);
-
-        // convert text: vector<string> --> string
-        std::wstring textData;
-        for (const auto& text : bufferData.text)
-        {
-            textData += text;
-        }
-
-        // convert text to HTML format
+        // extract the text from the buffer and convert it to HTML and RTF
+        // format in one go. SerializeSelection will lock while it's reading.
         // GH#5347 - Don't provide a title for the generated HTML, as many
         // web applications will paste the title first, followed by the HTML
         // content, which is unexpected.
-        const auto htmlData = formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::HTML) ?
-                                  TextBuffer::GenHTML(bufferData,
-                                                      _actualFont.GetUnscaledSize().Y,
-                                                      _actualFont.GetFaceName(),
-                                                      til::color{ _settings.DefaultBackground() }) :
-                                  "";
-
-        // convert to RTF format
-        const auto rtfData = formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::RTF) ?
-                                 TextBuffer::GenRTF(bufferData,
-                                                    _actualFont.GetUnscaledSize().Y,
-                                                    _actualFont.GetFaceName(),
-                                                    til::color{ _settings.DefaultBackground() }) :
-                                 "";
+        const auto includeHTML = formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::HTML);
+        const auto includeRTF = formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::RTF);
+        const auto bufferData = _terminal->SerializeSelection(singleLine,
+                                                              includeHTML,
+                                                              includeRTF,
+                                                              _actualFont.GetUnscaledSize().Y,
+                                                              _actualFont.GetFaceName(),
+                                                              til::color{ _settings.DefaultBackground() });
 
         if (!_settings.CopyOnSelect())
         {
@@ -871,9 +869,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         // send data up for clipboard
         _CopyToClipboardHandlers(*this,
-                                 winrt::make<CopyToClipboardEventArgs>(winrt::hstring{ textData },
-                                                                       winrt::to_hstring(htmlData),
-                                                                       winrt::to_hstring(rtfData),
+                                 winrt::make<CopyToClipboardEventArgs>(winrt::hstring{ bufferData.text },
+                                                                       winrt::to_hstring(bufferData.html),
+                                                                       winrt::to_hstring(bufferData.rtf),
                                                                        formats));
         return true;
     }
@@ -1200,7 +1198,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         auto& renderTarget = *_renderer;
         auto& blinkingState = _terminal->GetBlinkingState();
-        blinkingState.ToggleBlinkingRendition(renderTarget);
+        blinkingState.ToggleBlinkingRendition(renderTarget, _terminal->GetTextBuffer(), _terminal->GetViewport());
     }
 
     void ControlCore::BlinkCursor()
@@ -18,6 +18,7 @@
 #include "EventArgs.h"
 #include "ControlCore.g.h"
 #include "../../renderer/base/Renderer.hpp"
+#include "../../renderer/base/PooledRenderThread.hpp"
 #include "../../renderer/dx/DxRenderer.hpp"
 #include "../../renderer/uia/UiaRenderer.hpp"
 #include "../../cascadia/TerminalCore/Terminal.hpp"
@@ -22,21 +22,6 @@ using namespace Microsoft::Console::VirtualTerminal;
 
 using PointTree = interval_tree::IntervalTree<til::point, size_t>;
 
-static std::wstring _KeyEventsToText(std::deque<std::unique_ptr<IInputEvent>>& inEventsToWrite)
-{
-    std::wstring wstr = L"";
-    for (const auto& ev : inEventsToWrite)
-    {
-        if (ev->EventType() == InputEventType::KeyEvent)
-        {
-            const auto& k = static_cast<KeyEvent&>(*ev);
-            const auto wch = k.GetCharData();
-            wstr += wch;
-        }
-    }
-    return wstr;
-}
-
 #pragma warning(suppress : 26455) // default constructor is throwing, too much effort to rearrange at this time.
 Terminal::Terminal() :
     _mutableViewport{ Viewport::Empty() },
@@ -60,13 +45,15 @@ Terminal::Terminal() :
 
     _stateMachine = std::make_unique<StateMachine>(std::move(engine));
 
-    auto passAlongInput = [&](std::deque<std::unique_ptr<IInputEvent>>& inEventsToWrite) {
+    auto passAlongInput = [&](std::wstring_view sequence) {
         if (!_pfnWriteInput)
         {
             return;
         }
-        std::wstring wstr = _KeyEventsToText(inEventsToWrite);
-        _pfnWriteInput(wstr);
+        // Reuse the same string for every sequence, so that a stream of
+        // mouse moves doesn't allocate once it has warmed up.
+        _inputSequence.assign(sequence);
+        _pfnWriteInput(_inputSequence);
     };
 
     _terminalInput = std::make_unique<TerminalInput>(passAlongInput);
@@ -430,6 +417,12 @@ void Terminal::Write(std::wstring_view stringView)
 {
     auto lock = LockForWriting();
 
+    // Every character we print triggers a redraw. Let the renderer merge
+    // them into a single invalidation once we're done with this string.
+    auto& renderTarget = _buffer->GetRenderTarget();
+    renderTarget.BeginInvalidationBatch();
+    auto endBatch = wil::scope_exit([&]() { renderTarget.EndInvalidationBatch(); });
+
     _stateMachine->ProcessString(stringView);
 }
 
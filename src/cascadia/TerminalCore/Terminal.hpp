@@ -235,6 +235,12 @@ public:
     void SetBlockSelection(const bool isEnabled) noexcept;
 
     const TextBuffer::TextAndColor RetrieveSelectedTextFromBuffer(bool trimTrailingWhitespace);
+    TextBuffer::ClipboardData SerializeSelection(bool singleLine,
+                                                 bool includeHTML,
+                                                 bool includeRTF,
+                                                 int fontHeightPoints,
+                                                 std::wstring_view fontFaceName,
+                                                 COLORREF backgroundColor);
 #pragma endregion
 
 private:
@@ -250,6 +256,7 @@ private:
 
     std::unique_ptr<::Microsoft::Console::VirtualTerminal::StateMachine> _stateMachine;
     std::unique_ptr<::Microsoft::Console::VirtualTerminal::TerminalInput> _terminalInput;
+    std::wstring _inputSequence;
 
     std::optional<std::wstring> _title;
     std::wstring _startingTitle;
@@ -267,6 +267,48 @@ const TextBuffer::TextAndColor Terminal::RetrieveSelectedTextFromBuffer(bool sin
     return _buffer->GetText(includeCRLF, trimTrailingWhitespace, selectionRects, GetAttributeColors, formatWrappedRows);
 }
 
+// Method Description:
+// - serialize the highlighted portion of the text buffer for the clipboard,
+//   as text and optionally as HTML and RTF, in a single pass over the buffer
+// Arguments:
+// - singleLine: collapse all of the text to one line
+// - includeHTML: also generate the CF_HTML document
+// - includeRTF: also generate the RTF document
+// - fontHeightPoints: the unscaled font height
+// - fontFaceName: the name of the font used
+// - backgroundColor: default background color for characters
+// Return Value:
+// - the text and the requested rich text documents. If extended to multiple
+//   lines, each line of the text is separated by \r\n
+TextBuffer::ClipboardData Terminal::SerializeSelection(bool singleLine,
+                                                       bool includeHTML,
+                                                       bool includeRTF,
+                                                       int fontHeightPoints,
+                                                       std::wstring_view fontFaceName,
+                                                       COLORREF backgroundColor)
+{
+    auto lock = LockForReading();
+
+    const auto selectionRects = _GetSelectionRects();
+
+    const auto GetAttributeColors = std::bind(&Terminal::GetAttributeColors, this, std::placeholders::_1);
+
+    // See RetrieveSelectedTextFromBuffer for the reasoning behind these.
+    const auto includeCRLF = !singleLine || _blockSelection;
+    const auto trimTrailingWhitespace = !singleLine && (!_blockSelection || _trimBlockSelection);
+    const auto formatWrappedRows = _blockSelection;
+    return _buffer->SerializeSelection(includeCRLF,
+                                       trimTrailingWhitespace,
+                                       selectionRects,
+                                       GetAttributeColors,
+                                       formatWrappedRows,
+                                       includeHTML,
+                                       includeRTF,
+                                       fontHeightPoints,
+                                       fontFaceName,
+                                       backgroundColor);
+}
+
 // Method Description:
 // - convert viewport position to the corresponding location on the buffer
 // Arguments:
@@ -322,6 +322,8 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         _NameMapCache = nullptr;
         _GlobalHotkeysCache = nullptr;
         _KeyBindingMapCache = nullptr;
+        _frozen = false;
+        _ResolvedKeyChords.clear();
 
         // Handle nested commands
         const auto cmdImpl{ get_self<Command>(cmd) };
@@ -579,6 +581,13 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     // - nullptr if the key chord is explicitly unbound
     Model::Command ActionMap::GetActionByKeyChord(Control::KeyChord const& keys) const
     {
+        // Once we're frozen, every layer was already resolved into a single table
+        if (_frozen)
+        {
+            const auto resolvedPair{ _ResolvedKeyChords.find(_PackKeyChord(keys)) };
+            return resolvedPair != _ResolvedKeyChords.end() ? resolvedPair->second : nullptr;
+        }
+
         // Check the current layer
         const auto cmd{ _GetActionByKeyChordInternal(keys) };
         if (cmd.has_value())
@@ -626,6 +635,54 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         return std::nullopt;
     }
 
+    // Method Description:
+    // - Packs the given key chord into an integer, for use as a key in _ResolvedKeyChords
+    // Arguments:
+    // - keys: the key chord to pack
+    // Return Value:
+    // - the modifiers in the upper 32 bits, and the vkey in the lower 32 bits
+    PackedKeyChord ActionMap::_PackKeyChord(Control::KeyChord const& keys)
+    {
+        return static_cast<PackedKeyChord>(keys.Modifiers()) << 32 | static_cast<uint32_t>(keys.Vkey());
+    }
+
+    // Method Description:
+    // - Resolves the key chords of every layer into _ResolvedKeyChords, so that
+    //   GetActionByKeyChord is a single lookup. We also build the caches of our
+    //   views now, instead of on first use.
+    // - This is done once the settings are loaded. Adding an action afterwards
+    //   thaws the ActionMap again.
+    void ActionMap::_FreezeSettings()
+    {
+        _ResolvedKeyChords.clear();
+        _PopulateResolvedKeyChords(_ResolvedKeyChords);
+
+        NameMap();
+        KeyBindings();
+        GlobalHotkeys();
+    }
+
+    // Method Description:
+    // - Populates the provided map with the command each of our key chords and our parents key chords resolve to
+    // - This needs to be a bottom up approach, so that a key chord bound (or unbound) in a layer hides the parents binding.
+    // Arguments:
+    // - resolvedKeyChords: the map we're populating. This maps a packed key chord to its command, or nullptr if it's explicitly unbound.
+    void ActionMap::_PopulateResolvedKeyChords(std::unordered_map<PackedKeyChord, Model::Command>& resolvedKeyChords) const
+    {
+        for (const auto& [keys, actionID] : _KeyMap)
+        {
+            // This _cannot_ be nullopt because KeyMap can only map to
+            //   actions in this layer (see _PopulateKeyBindingMapWithStandardCommands).
+            resolvedKeyChords.try_emplace(_PackKeyChord(keys), _GetActionByID(actionID).value());
+        }
+
+        FAIL_FAST_IF(_parents.size() > 1);
+        for (const auto& parent : _parents)
+        {
+            parent->_PopulateResolvedKeyChords(resolvedKeyChords);
+        }
+    }
+
     // Method Description:
     // - Retrieves the key chord for the provided action
     // Arguments:
@@ -48,6 +48,11 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         }
     };
 
+    // The modifiers and the vkey of a KeyChord, packed into a single integer.
+    // Unlike a KeyChord, it can be hashed and compared without calling into
+    // the KeyChord's projection.
+    using PackedKeyChord = uint64_t;
+
     struct ActionMap : ActionMapT<ActionMap>, IInheritable<ActionMap>
     {
         ActionMap();
@@ -77,13 +82,18 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 
         static Windows::System::VirtualKeyModifiers ConvertVKModifiers(Control::KeyModifiers modifiers);
 
+    protected:
+        void _FreezeSettings() override;
+
     private:
+        static PackedKeyChord _PackKeyChord(Control::KeyChord const& keys);
         std::optional<Model::Command> _GetActionByID(const InternalActionID actionID) const;
         std::optional<Model::Command> _GetActionByKeyChordInternal(Control::KeyChord const& keys) const;
 
         void _PopulateNameMapWithNestedCommands(std::unordered_map<hstring, Model::Command>& nameMap) const;
         void _PopulateNameMapWithStandardCommands(std::unordered_map<hstring, Model::Command>& nameMap) const;
         void _PopulateKeyBindingMapWithStandardCommands(std::unordered_map<Control::KeyChord, Model::Command, KeyChordHash, KeyChordEquality>& keyBindingsMap, std::unordered_set<Control::KeyChord, KeyChordHash, KeyChordEquality>& unboundKeys) const;
+        void _PopulateResolvedKeyChords(std::unordered_map<PackedKeyChord, Model::Command>& resolvedKeyChords) const;
         std::vector<Model::Command> _GetCumulativeActions() const noexcept;
 
         void _TryUpdateActionMap(const Model::Command& cmd, Model::Command& oldCmd, Model::Command& consolidatedCmd);
@@ -97,6 +107,10 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         std::unordered_map<Control::KeyChord, InternalActionID, KeyChordHash, KeyChordEquality> _KeyMap;
         std::unordered_map<InternalActionID, Model::Command> _ActionMap;
 
+        // The command each key chord resolves to across all layers, while we're
+        // frozen. Explicitly unbound key chords map to nullptr.
+        std::unordered_map<PackedKeyChord, Model::Command> _ResolvedKeyChords;
+
         // Masking Actions:
         // These are actions that were introduced in an ancestor,
         //   but were edited (or unbound) in the current layer.
@@ -141,3 +141,17 @@ winrt::hstring AppearanceConfig::ExpandedBackgroundImagePath()
         return winrt::hstring{ wil::ExpandEnvironmentStringsW<std::wstring>(path.c_str()) };
     }
 }
+
+// Method Description:
+// - Resolves the inherited value of each of our settings. See IInheritable::Freeze.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void AppearanceConfig::_FreezeSettings()
+{
+#define FREEZE_SETTING(type, name, ...) _Freeze##name();
+    MTSM_APPEARANCE_SETTINGS(FREEZE_SETTING)
+    MTSM_APPEARANCE_NULLABLE_SETTINGS(FREEZE_SETTING)
+#undef FREEZE_SETTING
+}
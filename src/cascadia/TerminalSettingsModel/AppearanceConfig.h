@@ -23,6 +23,28 @@ Author(s):
 #include "IInheritable.h"
 #include <DefaultSettings.h>
 
+// The inheritable settings of an appearance, as X(type, name, default value).
+// Both the settings and AppearanceConfig::_FreezeSettings are generated from
+// these lists, so add new settings here rather than declaring them on their own.
+#define MTSM_APPEARANCE_SETTINGS(X)                                                                                              \
+    X(ConvergedAlignment, BackgroundImageAlignment, ConvergedAlignment::Horizontal_Center | ConvergedAlignment::Vertical_Center) \
+    X(uint32_t, CursorHeight, DEFAULT_CURSOR_HEIGHT)                                                                             \
+    X(hstring, ColorSchemeName, L"Campbell")                                                                                     \
+    X(Microsoft::Terminal::Core::CursorStyle, CursorShape, Microsoft::Terminal::Core::CursorStyle::Bar)                          \
+    X(hstring, BackgroundImagePath)                                                                                              \
+    X(double, BackgroundImageOpacity, 1.0)                                                                                       \
+    X(Windows::UI::Xaml::Media::Stretch, BackgroundImageStretchMode, Windows::UI::Xaml::Media::Stretch::UniformToFill)           \
+    X(bool, RetroTerminalEffect, false)                                                                                          \
+    X(hstring, PixelShaderPath, L"")
+
+// Same as above, but for settings where null is a valid value rather than
+// "inherit". See INHERITABLE_NULLABLE_SETTING.
+#define MTSM_APPEARANCE_NULLABLE_SETTINGS(X)                          \
+    X(Microsoft::Terminal::Core::Color, Foreground, nullptr)          \
+    X(Microsoft::Terminal::Core::Color, Background, nullptr)          \
+    X(Microsoft::Terminal::Core::Color, SelectionBackground, nullptr) \
+    X(Microsoft::Terminal::Core::Color, CursorColor, nullptr)
+
 namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 {
     struct AppearanceConfig : AppearanceConfigT<AppearanceConfig>, IInheritable<AppearanceConfig>
@@ -37,22 +59,14 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 
         winrt::hstring ExpandedBackgroundImagePath();
 
-        INHERITABLE_SETTING(Model::IAppearanceConfig, ConvergedAlignment, BackgroundImageAlignment, ConvergedAlignment::Horizontal_Center | ConvergedAlignment::Vertical_Center);
-
-        INHERITABLE_SETTING(Model::IAppearanceConfig, uint32_t, CursorHeight, DEFAULT_CURSOR_HEIGHT);
-        INHERITABLE_SETTING(Model::IAppearanceConfig, hstring, ColorSchemeName, L"Campbell");
-        INHERITABLE_NULLABLE_SETTING(Model::IAppearanceConfig, Microsoft::Terminal::Core::Color, Foreground, nullptr);
-        INHERITABLE_NULLABLE_SETTING(Model::IAppearanceConfig, Microsoft::Terminal::Core::Color, Background, nullptr);
-        INHERITABLE_NULLABLE_SETTING(Model::IAppearanceConfig, Microsoft::Terminal::Core::Color, SelectionBackground, nullptr);
-        INHERITABLE_NULLABLE_SETTING(Model::IAppearanceConfig, Microsoft::Terminal::Core::Color, CursorColor, nullptr);
-        INHERITABLE_SETTING(Model::IAppearanceConfig, Microsoft::Terminal::Core::CursorStyle, CursorShape, Microsoft::Terminal::Core::CursorStyle::Bar);
-        INHERITABLE_SETTING(Model::IAppearanceConfig, hstring, BackgroundImagePath);
-
-        INHERITABLE_SETTING(Model::IAppearanceConfig, double, BackgroundImageOpacity, 1.0);
-        INHERITABLE_SETTING(Model::IAppearanceConfig, Windows::UI::Xaml::Media::Stretch, BackgroundImageStretchMode, Windows::UI::Xaml::Media::Stretch::UniformToFill);
+        void _FreezeSettings() override;
 
-        INHERITABLE_SETTING(Model::IAppearanceConfig, bool, RetroTerminalEffect, false);
-        INHERITABLE_SETTING(Model::IAppearanceConfig, hstring, PixelShaderPath, L"");
+#define APPEARANCE_SETTING(type, name, ...) INHERITABLE_SETTING(Model::IAppearanceConfig, type, name, __VA_ARGS__);
+#define APPEARANCE_NULLABLE_SETTING(type, name, ...) INHERITABLE_NULLABLE_SETTING(Model::IAppearanceConfig, type, name, __VA_ARGS__);
+        MTSM_APPEARANCE_SETTINGS(APPEARANCE_SETTING)
+        MTSM_APPEARANCE_NULLABLE_SETTINGS(APPEARANCE_NULLABLE_SETTING)
+#undef APPEARANCE_SETTING
+#undef APPEARANCE_NULLABLE_SETTING
 
     private:
         winrt::weak_ref<Profile> _sourceProfile;
@@ -654,6 +654,32 @@ void CascadiaSettings::_UpdateActiveProfiles()
     }
 }
 
+// Method Description:
+// - Freezes all of our profiles, the profile defaults and the action map, now
+//   that their inheritance is final. Creating the settings for a new pane then
+//   reads each setting directly, instead of searching every parent profile for
+//   it, and a key chord is resolved with a single lookup.
+// - The settings editor modifies a Copy() of these settings, which isn't
+//   frozen.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CascadiaSettings::_Freeze()
+{
+    if (_userDefaultProfileSettings)
+    {
+        _userDefaultProfileSettings->Freeze();
+    }
+
+    for (const auto& profile : _allProfiles)
+    {
+        winrt::get_self<implementation::Profile>(profile)->Freeze();
+    }
+
+    winrt::get_self<implementation::ActionMap>(_globals->ActionMap())->Freeze();
+}
+
 // Method Description:
 // - Ensures that every profile has a valid "color scheme" set. If any profile
 //   has a colorScheme set to a value which is _not_ the name of an actual color
@@ -119,6 +119,18 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 
         std::vector<std::unique_ptr<::Microsoft::Terminal::Settings::Model::IDynamicProfileGenerator>> _profileGenerators;
 
+        // The profiles each generator (by namespace) created the last time it
+        // ran, together with the fingerprint it reported back then. This is
+        // shared by all instances, so that reloading the settings doesn't have
+        // to run the generators again unless something actually changed.
+        struct DynamicProfileCacheEntry
+        {
+            std::wstring fingerprint;
+            std::vector<winrt::com_ptr<Profile>> profiles;
+        };
+        inline static std::mutex _dynamicProfileCacheMutex;
+        inline static std::unordered_map<std::wstring, DynamicProfileCacheEntry> _dynamicProfileCache;
+
         std::string _userSettingsString;
         Json::Value _userSettings;
         Json::Value _defaultSettings;
@@ -128,6 +140,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         winrt::com_ptr<implementation::Profile> _FindMatchingProfile(const Json::Value& profileJson);
         std::optional<uint32_t> _FindMatchingProfileIndex(const Json::Value& profileJson);
         void _LayerOrCreateColorScheme(const Json::Value& schemeJson);
+        void _LayerOrCreateColorSchemes(const Json::Value& schemesJson);
         Json::Value _ParseUtf8JsonString(std::string_view fileData);
 
         winrt::com_ptr<implementation::ColorScheme> _FindMatchingColorScheme(const Json::Value& schemeJson);
@@ -142,11 +155,13 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         void _ApplyDefaultsFromUserSettings();
 
         void _LoadDynamicProfiles();
+        static std::vector<Model::Profile> _GenerateDynamicProfiles(::Microsoft::Terminal::Settings::Model::IDynamicProfileGenerator& generator);
         void _LoadFragmentExtensions();
         void _ApplyJsonStubsHelper(const std::wstring_view directory, const std::unordered_set<std::wstring>& ignoredNamespaces);
         std::unordered_set<std::string> _AccumulateJsonFilesInDirectory(const std::wstring_view directory);
         void _ParseAndLayerFragmentFiles(const std::unordered_set<std::string> files, const winrt::hstring source);
 
+        static com_ptr<CascadiaSettings> _ParseDefaults();
         static bool _IsPackaged();
         static void _WriteSettings(std::string_view content, const hstring filepath);
         static std::optional<std::string> _ReadUserSettings();
@@ -162,6 +177,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         void _ResolveDefaultProfile();
         void _ReorderProfilesToMatchUserSettingsOrder();
         void _UpdateActiveProfiles();
+        void _Freeze();
         void _ValidateAllSchemesExist();
         void _ValidateMediaResources();
         void _ValidateKeybindings();
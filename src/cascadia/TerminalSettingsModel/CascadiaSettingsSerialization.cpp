@@ -11,6 +11,7 @@
 #include <shlobj.h>
 #include <fmt/chrono.h>
 #include "DefaultProfileUtils.h"
+#include "ParallelUtils.h"
 
 // defaults.h is a file containing the default json settings in a std::string_view
 #include "defaults.h"
@@ -247,6 +248,7 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
 
         // If this throws, the app will catch it and use the default settings
         resultPtr->_ValidateSettings();
+        resultPtr->_Freeze();
 
         return *resultPtr;
     }
@@ -286,6 +288,7 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
         // Now validate.
         // If this throws, the app will catch it and use the default settings
         resultPtr->_ValidateSettings();
+        resultPtr->_Freeze();
 
         return *resultPtr;
     }
@@ -307,11 +310,34 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
 // Function Description:
 // - Creates a new CascadiaSettings object initialized with settings from the
 //   hardcoded defaults.json.
+// - defaults.json is stamped into the binary, so parsing and layering it
+//   always produces the same settings. We only do that once per process and
+//   hand out copies of the result afterwards, which skips jsoncpp and
+//   LayerJson for the defaults entirely on every later (re)load.
 // Arguments:
 // - <none>
 // Return Value:
 // - a unique_ptr to a CascadiaSettings with the settings from defaults.json
 winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::LoadDefaults()
+{
+    static const auto defaults{ _ParseDefaults() };
+
+    auto settings{ defaults->Copy() };
+
+    // Copy() shares the list of default terminals with its source. Every
+    // instance needs its own, or refreshing one would affect all the others.
+    winrt::get_self<CascadiaSettings>(settings)->_defaultTerminals = winrt::single_threaded_observable_vector<Model::DefaultTerminal>();
+
+    return settings;
+}
+
+// Function Description:
+// - Parses and layers the hardcoded defaults.json. See LoadDefaults.
+// Arguments:
+// - <none>
+// Return Value:
+// - a CascadiaSettings with the settings from defaults.json
+winrt::com_ptr<CascadiaSettings> CascadiaSettings::_ParseDefaults()
 {
     auto resultPtr{ winrt::make_self<CascadiaSettings>() };
 
@@ -330,7 +356,7 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
         profileImpl->Origin(OriginTag::InBox);
     }
 
-    return *resultPtr;
+    return resultPtr;
 }
 
 // Method Description:
@@ -339,6 +365,9 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
 // - Uses the Json::Value _userSettings to check which DPGs should not be run.
 //   If the user settings has any namespaces in the "disabledProfileSources"
 //   property, we'll ensure that any DPGs with a matching namespace _don't_ run.
+// - Some DPGs have to wait for external processes (like `wsl.exe --list`), so
+//   we run them concurrently. The profiles are still added in the order of
+//   _profileGenerators, no matter which DPG finishes first.
 // Arguments:
 // - <none>
 // Return Value:
@@ -355,7 +384,7 @@ void CascadiaSettings::_LoadDynamicProfiles()
         }
     }
 
-    const GUID nullGuid{ 0 };
+    std::vector<::Microsoft::Terminal::Settings::Model::IDynamicProfileGenerator*> generators;
     for (auto& generator : _profileGenerators)
     {
         const std::wstring generatorNamespace{ generator->GetNamespace() };
@@ -366,19 +395,122 @@ void CascadiaSettings::_LoadDynamicProfiles()
         }
         else
         {
-            try
+            generators.emplace_back(generator.get());
+        }
+    }
+
+    std::vector<std::vector<Model::Profile>> results(generators.size());
+    if (generators.size() == 1)
+    {
+        results[0] = _GenerateDynamicProfiles(*generators[0]);
+    }
+    else if (generators.size() > 1)
+    {
+        // Activation contexts are per-thread. The workers need ours to be able
+        // to activate the same classes we can (this matters for the unit tests).
+        wil::unique_hactctx actCtx;
+        LOG_IF_WIN32_BOOL_FALSE(GetCurrentActCtx(actCtx.addressof()));
+
+        std::vector<std::thread> workers;
+        workers.reserve(generators.size());
+        auto joinWorkers = wil::scope_exit([&]() {
+            for (auto& worker : workers)
             {
-                auto profiles = generator->GenerateProfiles();
-                for (auto& profile : profiles)
+                worker.join();
+            }
+        });
+
+        for (size_t i = 0; i < generators.size(); ++i)
+        {
+            workers.emplace_back([&, i]() {
+                try
                 {
-                    profile.Source(generatorNamespace);
+                    // The generators create WinRT objects and may call into COM
+                    // (e.g. to look for WSL distributions), so every worker needs
+                    // to join the multi-threaded apartment.
+                    winrt::init_apartment(winrt::apartment_type::multi_threaded);
+                    auto uninitApartment = wil::scope_exit([]() { winrt::uninit_apartment(); });
+
+                    const auto activation = wil::activate_context(actCtx.get());
+                    results[i] = _GenerateDynamicProfiles(*generators[i]);
+                }
+                CATCH_LOG();
+            });
+        }
+    }
+
+    for (const auto& profiles : results)
+    {
+        for (const auto& profile : profiles)
+        {
+            _allProfiles.Append(profile);
+        }
+    }
+}
+
+// Method Description:
+// - Runs a single dynamic profile generator, unless the fingerprint it reports
+//   is still the same as the one from the last time it ran. In that case we
+//   return copies of the profiles it generated back then instead.
+// - This is called on a background thread by _LoadDynamicProfiles, so it must
+//   not throw.
+// Arguments:
+// - generator: the DPG to get the profiles of
+// Return Value:
+// - The generated profiles, with their Source set to the generator's namespace.
+std::vector<Model::Profile> CascadiaSettings::_GenerateDynamicProfiles(::Microsoft::Terminal::Settings::Model::IDynamicProfileGenerator& generator)
+{
+    const std::wstring generatorNamespace{ generator.GetNamespace() };
+    std::vector<Model::Profile> profiles;
+
+    try
+    {
+        std::optional<std::wstring> fingerprint;
+        try
+        {
+            fingerprint = generator.GetFingerprint();
+        }
+        CATCH_LOG();
 
-                    _allProfiles.Append(profile);
+        if (fingerprint)
+        {
+            std::lock_guard<std::mutex> lock{ _dynamicProfileCacheMutex };
+            const auto found = _dynamicProfileCache.find(generatorNamespace);
+            if (found != _dynamicProfileCache.end() && found->second.fingerprint == *fingerprint)
+            {
+                // The profiles will get modified as soon as the user's settings
+                // are layered on top of them. Only ever hand out copies.
+                for (const auto& cached : found->second.profiles)
+                {
+                    profiles.emplace_back(*Profile::CopySettings(cached));
                 }
+                return profiles;
             }
-            CATCH_LOG_MSG("Dynamic Profile Namespace: \"%ls\"", generatorNamespace.data());
+        }
+
+        profiles = generator.GenerateProfiles();
+        for (auto& profile : profiles)
+        {
+            profile.Source(generatorNamespace);
+        }
+
+        if (fingerprint)
+        {
+            DynamicProfileCacheEntry entry{ std::move(*fingerprint), {} };
+            for (const auto& profile : profiles)
+            {
+                winrt::com_ptr<Profile> profileImpl;
+                profileImpl.copy_from(winrt::get_self<Profile>(profile));
+                entry.profiles.emplace_back(Profile::CopySettings(profileImpl));
+            }
+
+            std::lock_guard<std::mutex> lock{ _dynamicProfileCacheMutex };
+            _dynamicProfileCache.insert_or_assign(generatorNamespace, std::move(entry));
         }
     }
+    CATCH_LOG_MSG("Dynamic Profile Namespace: \"%ls\"", generatorNamespace.data());
+
+    return profiles;
 }
 
 // Method Description:
@@ -838,13 +970,7 @@ void CascadiaSettings::LayerJson(const Json::Value& json)
 
     if (auto schemes{ json[SchemesKey.data()] })
     {
-        for (auto schemeJson : schemes)
-        {
-            if (schemeJson.isObject())
-            {
-                _LayerOrCreateColorScheme(schemeJson);
-            }
-        }
+        _LayerOrCreateColorSchemes(schemes);
     }
 
     for (auto profileJson : _GetProfilesJsonObject(json))
@@ -1035,6 +1161,59 @@ void CascadiaSettings::_LayerOrCreateColorScheme(const Json::Value& schemeJson)
     }
 }
 
+// Method Description:
+// - Layers or creates each of the color schemes in the given json array, in
+//   order, like _LayerOrCreateColorScheme.
+// - The schemes that don't exist yet don't depend on anything else, so they
+//   are all parsed up front, on the thread pool if there are many of them
+//   (like with a large pack of community schemes).
+// Arguments:
+// - schemesJson: an array of partial serializations of ColorScheme objects.
+// Return Value:
+// - <none>
+void CascadiaSettings::_LayerOrCreateColorSchemes(const Json::Value& schemesJson)
+{
+    const auto existingSchemes{ _globals->ColorSchemes() };
+    std::vector<const Json::Value*> schemeJsons;
+    std::vector<size_t> newSchemeIndices;
+    std::unordered_set<std::wstring> names;
+
+    for (const auto& schemeJson : schemesJson)
+    {
+        if (!schemeJson.isObject())
+        {
+            continue;
+        }
+
+        // A scheme is new if we don't have it yet, and it didn't appear earlier
+        // in the array. Schemes without a name are never layered.
+        const auto name = ColorScheme::GetNameFromJson(schemeJson);
+        if (!name || (!existingSchemes.HasKey(*name) && names.emplace(*name).second))
+        {
+            newSchemeIndices.emplace_back(schemeJsons.size());
+        }
+        schemeJsons.emplace_back(&schemeJson);
+    }
+
+    std::vector<winrt::com_ptr<ColorScheme>> newSchemes(schemeJsons.size());
+    ParallelUtils::ForEachIndex(newSchemeIndices.size(), [&](const size_t i) {
+        const auto index = newSchemeIndices.at(i);
+        newSchemes.at(index) = ColorScheme::FromJson(*schemeJsons.at(index));
+    });
+
+    for (size_t i = 0; i < schemeJsons.size(); ++i)
+    {
+        if (const auto& scheme{ newSchemes.at(i) })
+        {
+            _globals->AddColorScheme(*scheme);
+        }
+        else
+        {
+            _LayerOrCreateColorScheme(*schemeJsons.at(i));
+        }
+    }
+}
+
 // Method Description:
 // - Finds a color scheme from our list of color schemes that matches the given
 //   json object. Uses ColorScheme::GetNameFromJson to find the name and then
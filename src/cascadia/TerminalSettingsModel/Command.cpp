@@ -9,6 +9,7 @@
 #include "KeyChordSerialization.h"
 #include <LibraryResources.h>
 #include "TerminalSettingsSerializationHelpers.h"
+#include "ParallelUtils.h"
 
 using namespace winrt::Microsoft::Terminal::Settings::Model;
 using namespace winrt::Windows::Foundation::Collections;
@@ -444,26 +445,51 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     }
 
     // Function Description:
-    // - Helper to escape a string as a json string. This function will also
-    //   trim off the leading and trailing double-quotes, so the output string
-    //   can be inserted directly into another json blob.
+    // - Helper to instantiate the json of an iterable command for one of the
+    //   items it iterates on. Copies the json, replacing every instance of the
+    //   given tokens in its strings (including the names of object members).
+    // - Since we work on the parsed strings, the replacements don't need to be
+    //   escaped, and there's no need to serialize the json and parse it again.
     // Arguments:
-    // - input: the string to JSON escape.
+    // - json: the json to instantiate
+    // - replacements: pairs of tokens and the strings to replace them with
     // Return Value:
-    // - the input string escaped properly to be inserted into another json blob.
-    std::string _escapeForJson(const std::string& input)
+    // - the json, with the tokens replaced.
+    static Json::Value _replaceTokens(const Json::Value& json, const std::vector<std::pair<std::string_view, std::string>>& replacements)
     {
-        Json::Value inJson{ input };
-        Json::StreamWriterBuilder builder;
-        builder.settings_["indentation"] = "";
-        std::string out{ Json::writeString(builder, inJson) };
-        if (out.size() >= 2)
+        const auto replaceAll = [&](std::string value) {
+            for (const auto& [token, replacement] : replacements)
+            {
+                til::replace_needle_in_haystack_inplace(value, token, replacement);
+            }
+            return value;
+        };
+
+        switch (json.type())
+        {
+        case Json::ValueType::stringValue:
+            return Json::Value{ replaceAll(json.asString()) };
+        case Json::ValueType::arrayValue:
         {
-            // trim off the leading/trailing '"'s
-            auto ss{ out.substr(1, out.size() - 2) };
-            return ss;
+            Json::Value result{ Json::ValueType::arrayValue };
+            for (const auto& element : json)
+            {
+                result.append(_replaceTokens(element, replacements));
+            }
+            return result;
+        }
+        case Json::ValueType::objectValue:
+        {
+            Json::Value result{ Json::ValueType::objectValue };
+            for (auto it = json.begin(); it != json.end(); ++it)
+            {
+                result[replaceAll(it.name())] = _replaceTokens(*it, replacements);
+            }
+            return result;
+        }
+        default:
+            return json;
         }
-        return out;
     }
 
     // Method Description:
@@ -525,8 +551,8 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     //   * For the new commands, we'll replace any instance of "${profile.name}"
     //     in the original json used to create this action with the name of the
     //     given profile.
-    // - If we encounter any errors while re-parsing the json with the replaced
-    //   name, we'll just return immediately.
+    // - The new commands are parsed from copies of the original json with the
+    //   names replaced (see _replaceTokens), so there's nothing to re-parse.
     // - At the end, we'll return all the new commands we've build for the given command.
     // Arguments:
     // - expandable: the Command to potentially turn into more commands
@@ -553,85 +579,58 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
             return newCommands;
         }
 
-        std::string errs; // This string will receive any error text from failing to parse.
-        std::unique_ptr<Json::CharReader> reader{ Json::CharReaderBuilder::CharReaderBuilder().newCharReader() };
-
-        // First, get a string for the original Json::Value
-        auto oldJsonString = expandable->_originalJson.toStyledString();
-
-        auto reParseJson = [&](const auto& newJsonString) -> bool {
-            // - Now, re-parse the modified value.
-            Json::Value newJsonValue;
-            const auto actualDataStart = newJsonString.data();
-            const auto actualDataEnd = newJsonString.data() + newJsonString.size();
-            if (!reader->parse(actualDataStart, actualDataEnd, &newJsonValue, &errs))
-            {
-                warnings.Append(SettingsLoadWarnings::FailedToParseCommandJson);
-                // If we encounter a re-parsing error, just stop processing the rest of the commands.
-                return false;
-            }
-
-            // Pass the new json back though FromJson, to get the new expanded value.
-            std::vector<SettingsLoadWarnings> newWarnings;
-            if (auto newCmd{ Command::FromJson(newJsonValue, newWarnings) })
-            {
-                newCommands.push_back(*newCmd);
-            }
-            std::for_each(newWarnings.begin(), newWarnings.end(), [warnings](auto& warn) { warnings.Append(warn); });
-            return true;
-        };
-
+        // The original json of the command is the template for the new
+        // commands. First collect what to replace its tokens with for each
+        // item we iterate on.
+        std::vector<std::vector<std::pair<std::string_view, std::string>>> replacements;
         if (expandable->_IterateOn == ExpandCommandType::Profiles)
         {
+            // For each profile, create a new command. This command will have:
+            // * the icon path and keychord text of the original command
+            // * the Name will have any instances of "${profile.name}"
+            //   replaced with the profile's name
+            // * for the action, we'll take the original json, replace any
+            //   instances of "${profile.name}" with the profile's name,
+            //   then re-attempt to parse the action and args.
+            replacements.reserve(profiles.Size());
             for (const auto& p : profiles)
             {
-                // For each profile, create a new command. This command will have:
-                // * the icon path and keychord text of the original command
-                // * the Name will have any instances of "${profile.name}"
-                //   replaced with the profile's name
-                // * for the action, we'll take the original json, replace any
-                //   instances of "${profile.name}" with the profile's name,
-                //   then re-attempt to parse the action and args.
-
-                // Replace all the keywords in the original json, and try and parse that
-
-                // - Escape the profile name for JSON appropriately
-                auto escapedProfileName = _escapeForJson(til::u16u8(p.Name()));
-                auto escapedProfileIcon = _escapeForJson(til::u16u8(p.Icon()));
-                auto newJsonString = til::replace_needle_in_haystack(oldJsonString,
-                                                                     ProfileNameToken,
-                                                                     escapedProfileName);
-                til::replace_needle_in_haystack_inplace(newJsonString,
-                                                        ProfileIconToken,
-                                                        escapedProfileIcon);
-
-                // If we encounter a re-parsing error, just stop processing the rest of the commands.
-                if (!reParseJson(newJsonString))
-                {
-                    break;
-                }
+                replacements.push_back({ { ProfileNameToken, til::u16u8(p.Name()) },
+                                         { ProfileIconToken, til::u16u8(p.Icon()) } });
             }
         }
         else if (expandable->_IterateOn == ExpandCommandType::ColorSchemes)
         {
+            // For each scheme, create a new command. We'll take the
+            // original json, replace any instances of "${scheme.name}" with
+            // the scheme's name, then re-attempt to parse the action and
+            // args.
+            replacements.reserve(schemes.Size());
             for (const auto& s : schemes)
             {
-                // For each scheme, create a new command. We'll take the
-                // original json, replace any instances of "${scheme.name}" with
-                // the scheme's name, then re-attempt to parse the action and
-                // args.
-
-                // - Escape the profile name for JSON appropriately
-                auto escapedSchemeName = _escapeForJson(til::u16u8(s.Name()));
-                auto newJsonString = til::replace_needle_in_haystack(oldJsonString,
-                                                                     SchemeNameToken,
-                                                                     escapedSchemeName);
-
-                // If we encounter a re-parsing error, just stop processing the rest of the commands.
-                if (!reParseJson(newJsonString))
-                {
-                    break;
-                }
+                replacements.push_back({ { SchemeNameToken, til::u16u8(s.Name()) } });
+            }
+        }
+
+        // Then instantiate the template for each of them. The new commands
+        // don't depend on each other, so with many profiles or schemes this
+        // runs on the thread pool.
+        std::vector<winrt::com_ptr<Command>> expanded(replacements.size());
+        std::vector<std::vector<SettingsLoadWarnings>> expandedWarnings(replacements.size());
+        ParallelUtils::ForEachIndex(replacements.size(), [&](const size_t i) {
+            const auto newJsonValue{ _replaceTokens(expandable->_originalJson, replacements.at(i)) };
+            expanded.at(i) = Command::FromJson(newJsonValue, expandedWarnings.at(i));
+        });
+
+        for (size_t i = 0; i < expanded.size(); ++i)
+        {
+            if (const auto& newCmd{ expanded.at(i) })
+            {
+                newCommands.push_back(*newCmd);
+            }
+            for (const auto warning : expandedWarnings.at(i))
+            {
+                warnings.Append(warning);
             }
         }
 
@@ -13,6 +13,11 @@ Abstract:
 - Each DPG must have a unique namespace to associate with itself. If the
   namespace is not unique, the generator risks affecting profiles from
   conflicting generators.
+- Generators may run concurrently with each other, on a background thread.
+- A DPG may optionally report a fingerprint of whatever its profiles are
+  based on (a registry key's last write time, etc.). As long as the
+  fingerprint doesn't change, the profiles from the last run are reused
+  instead of running the generator again.
 
 Author(s):
 - Mike Griese - August 2019
@@ -33,5 +38,6 @@ public:
     virtual ~IDynamicProfileGenerator() = 0;
     virtual std::wstring_view GetNamespace() = 0;
     virtual std::vector<winrt::Microsoft::Terminal::Settings::Model::Profile> GenerateProfiles() = 0;
+    virtual std::optional<std::wstring> GetFingerprint() { return std::nullopt; }
 };
 inline Microsoft::Terminal::Settings::Model::IDynamicProfileGenerator::~IDynamicProfileGenerator() {}
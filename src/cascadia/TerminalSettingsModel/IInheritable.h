@@ -44,17 +44,41 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         void ClearParents()
         {
             _parents.clear();
+            _frozen = false;
         }
 
         void InsertParent(com_ptr<T> parent)
         {
             _parents.push_back(parent);
+            _frozen = false;
         }
 
         void InsertParent(size_t index, com_ptr<T> parent)
         {
             auto pos{ _parents.begin() + index };
             _parents.insert(pos, parent);
+            _frozen = false;
+        }
+
+        // Method Description:
+        // - Resolves the value of every setting this instance inherits from its
+        //   parents, so that the getters no longer walk up the inheritance tree.
+        // - Only freeze an instance once its inheritance tree is complete. Changes
+        //   made to its parents afterwards aren't observed anymore, while its own
+        //   values can still be set and cleared. Changing its parents thaws it.
+        // Arguments:
+        // - <none>
+        // Return Value:
+        // - <none>
+        void Freeze()
+        {
+            _FreezeSettings();
+            _frozen = true;
+        }
+
+        bool Frozen() const noexcept
+        {
+            return _frozen;
         }
 
         const std::vector<com_ptr<T>>& Parents()
@@ -73,6 +97,17 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         // Return Value:
         // - <none>
         virtual void _FinalizeInheritance() {}
+
+        bool _frozen{ false };
+
+        // Method Description:
+        // - Resolves the inherited value of each setting. Implementations call
+        //   the _Freeze<name> method generated for each of their settings.
+        // Arguments:
+        // - <none>
+        // Return Value:
+        // - <none>
+        virtual void _FreezeSettings() {}
     };
 
     // This is like std::optional, but we can use it in inheritance to determine whether the user explicitly cleared it
@@ -89,6 +124,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 // - Clear(): clear the user set value
 // - the setting is saved as an optional, where nullopt means
 //   that we must inherit the value from our parent
+// - _Freeze<name>(): cache the inherited value (see IInheritable::Freeze)
 #define INHERITABLE_SETTING(projectedType, type, name, ...)                 \
 public:                                                                     \
     /* Returns true if the user explicitly set the value, false otherwise*/ \
@@ -135,6 +171,7 @@ public:                                                                     \
                                                                             \
 private:                                                                    \
     std::optional<type> _##name{ std::nullopt };                            \
+    std::optional<type> _inherited##name{ std::nullopt };                   \
     std::optional<type> _get##name##Impl() const                            \
     {                                                                       \
         /*return user set value*/                                           \
@@ -143,6 +180,16 @@ private:                                                                    \
             return _##name;                                                 \
         }                                                                   \
                                                                             \
+        /*a frozen object already resolved the inherited value*/            \
+        if (_frozen)                                                        \
+        {                                                                   \
+            return _inherited##name;                                        \
+        }                                                                   \
+                                                                            \
+        return _getInherited##name##Impl();                                 \
+    }                                                                       \
+    std::optional<type> _getInherited##name##Impl() const                   \
+    {                                                                       \
         /*user set value was not set*/                                      \
         /*iterate through parents to find a value*/                         \
         for (const auto& parent : _parents)                                 \
@@ -156,6 +203,10 @@ private:                                                                    \
         /*no value was found*/                                              \
         return std::nullopt;                                                \
     }                                                                       \
+    void _Freeze##name()                                                    \
+    {                                                                       \
+        _inherited##name = _getInherited##name##Impl();                     \
+    }                                                                       \
     projectedType _get##name##OverrideSourceImpl() const                    \
     {                                                                       \
         /*we have a value*/                                                 \
@@ -244,6 +295,7 @@ public:                                                                     \
                                                                             \
 private:                                                                    \
     NullableSetting<type> _##name{};                                        \
+    NullableSetting<type> _inherited##name{};                               \
     NullableSetting<type> _get##name##Impl() const                          \
     {                                                                       \
         /*return user set value*/                                           \
@@ -252,6 +304,16 @@ private:                                                                    \
             return _##name;                                                 \
         }                                                                   \
                                                                             \
+        /*a frozen object already resolved the inherited value*/            \
+        if (_frozen)                                                        \
+        {                                                                   \
+            return _inherited##name;                                        \
+        }                                                                   \
+                                                                            \
+        return _getInherited##name##Impl();                                 \
+    }                                                                       \
+    NullableSetting<type> _getInherited##name##Impl() const                 \
+    {                                                                       \
         /*user set value was not set*/                                      \
         /*iterate through parents to find a value*/                         \
         for (const auto& parent : _parents)                                 \
@@ -265,6 +327,10 @@ private:                                                                    \
         /*no value was found*/                                              \
         return std::nullopt;                                                \
     }                                                                       \
+    void _Freeze##name()                                                    \
+    {                                                                       \
+        _inherited##name = _getInherited##name##Impl();                     \
+    }                                                                       \
     projectedType _get##name##OverrideSourceImpl() const                    \
     {                                                                       \
         /*we have a value*/                                                 \
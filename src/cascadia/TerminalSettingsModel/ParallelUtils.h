@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+/*++
+Module Name:
+- ParallelUtils.h
+
+Abstract:
+- This module is used for spreading independent pieces of work, like parsing
+  each color scheme of a settings file, over the thread pool.
+
+Revision History:
+- N/A
+--*/
+
+#pragma once
+
+#include <execution>
+#include <numeric>
+
+namespace Microsoft::Terminal::Settings::Model::ParallelUtils
+{
+    // Handing work to the thread pool isn't free. Below this many items it's
+    // faster to do them all on the calling thread.
+    static constexpr size_t MinimumParallelCount{ 32 };
+
+    // Calls func(i) for every i in [0, count). If there are enough items, the
+    // calls are spread over the thread pool, so func must be safe to call
+    // concurrently with different indices.
+    // Exceptions thrown by func are rethrown once all calls are done. If
+    // several calls threw, the one with the lowest index wins, which is the
+    // one a plain loop would have thrown.
+    template<typename Func>
+    void ForEachIndex(const size_t count, Func&& func)
+    {
+        if (count < MinimumParallelCount)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                func(i);
+            }
+            return;
+        }
+
+        std::vector<size_t> indices(count);
+        std::iota(indices.begin(), indices.end(), size_t{ 0 });
+
+        // An exception escaping a parallel algorithm would terminate us.
+        std::vector<std::exception_ptr> exceptions(count);
+        std::for_each(std::execution::par, indices.begin(), indices.end(), [&](const size_t i) {
+            try
+            {
+                func(i);
+            }
+            catch (...)
+            {
+                exceptions.at(i) = std::current_exception();
+            }
+        });
+
+        for (const auto& exception : exceptions)
+        {
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+    }
+}
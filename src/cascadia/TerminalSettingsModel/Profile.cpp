@@ -394,6 +394,33 @@ void Profile::_FinalizeInheritance()
     }
 }
 
+// Method Description:
+// - Resolves the inherited value of each of our settings, including the ones
+//   of our appearances. See IInheritable::Freeze.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Profile::_FreezeSettings()
+{
+#define FREEZE_SETTING(type, name, ...) _Freeze##name();
+    MTSM_PROFILE_SETTINGS(FREEZE_SETTING)
+    MTSM_PROFILE_NULLABLE_SETTINGS(FREEZE_SETTING)
+#undef FREEZE_SETTING
+
+    if (auto defaultAppearanceImpl = get_self<AppearanceConfig>(_DefaultAppearance))
+    {
+        defaultAppearanceImpl->Freeze();
+    }
+
+    // The unfocused appearance is only ours to freeze if we define it. An
+    // inherited one is frozen along with the profile that defines it.
+    if (_UnfocusedAppearance && *_UnfocusedAppearance)
+    {
+        get_self<AppearanceConfig>(*_UnfocusedAppearance)->Freeze();
+    }
+}
+
 winrt::Microsoft::Terminal::Settings::Model::IAppearanceConfig Profile::DefaultAppearance()
 {
     return _DefaultAppearance;
@@ -70,6 +70,43 @@ namespace TerminalAppUnitTests
 // GUID specified manually.
 constexpr GUID RUNTIME_GENERATED_PROFILE_NAMESPACE_GUID = { 0xf65ddb7e, 0x706b, 0x4499, { 0x8a, 0x50, 0x40, 0x31, 0x3c, 0xaf, 0x51, 0x0a } };
 
+// The inheritable settings of a profile, as X(type, name, default value).
+// Both the settings and Profile::_FreezeSettings are generated from these
+// lists, so add new settings here rather than declaring them on their own.
+#define MTSM_PROFILE_SETTINGS(X)                                                                                                           \
+    X(guid, Guid, _GenerateGuidForProfile(Name(), Source()))                                                                               \
+    X(hstring, Name, L"Default")                                                                                                           \
+    X(hstring, Source)                                                                                                                     \
+    X(bool, Hidden, false)                                                                                                                 \
+    X(guid, ConnectionType)                                                                                                                \
+    /* Default Icon: Segoe MDL2 CommandPrompt icon */                                                                                      \
+    X(hstring, Icon, L"\uE756")                                                                                                            \
+    X(CloseOnExitMode, CloseOnExit, CloseOnExitMode::Graceful)                                                                             \
+    X(hstring, TabTitle)                                                                                                                   \
+    X(bool, SuppressApplicationTitle, false)                                                                                               \
+    X(bool, UseAcrylic, false)                                                                                                             \
+    X(double, AcrylicOpacity, 0.5)                                                                                                         \
+    X(Microsoft::Terminal::Control::ScrollbarState, ScrollState, Microsoft::Terminal::Control::ScrollbarState::Visible)                    \
+    X(hstring, FontFace, DEFAULT_FONT_FACE)                                                                                                \
+    X(int32_t, FontSize, DEFAULT_FONT_SIZE)                                                                                                \
+    X(Windows::UI::Text::FontWeight, FontWeight, DEFAULT_FONT_WEIGHT)                                                                      \
+    X(hstring, Padding, DEFAULT_PADDING)                                                                                                   \
+    X(hstring, Commandline, L"cmd.exe")                                                                                                    \
+    X(hstring, StartingDirectory)                                                                                                          \
+    X(Microsoft::Terminal::Control::TextAntialiasingMode, AntialiasingMode, Microsoft::Terminal::Control::TextAntialiasingMode::Grayscale) \
+    X(bool, ForceFullRepaintRendering, false)                                                                                              \
+    X(bool, SoftwareRendering, false)                                                                                                      \
+    X(int32_t, HistorySize, DEFAULT_HISTORY_SIZE)                                                                                          \
+    X(bool, SnapOnInput, true)                                                                                                             \
+    X(bool, AltGrAliasing, true)                                                                                                           \
+    X(Model::BellStyle, BellStyle, BellStyle::Audible)                                                                                     \
+    X(Model::IAppearanceConfig, UnfocusedAppearance, nullptr)
+
+// Same as above, but for settings where null is a valid value rather than
+// "inherit". See INHERITABLE_NULLABLE_SETTING.
+#define MTSM_PROFILE_NULLABLE_SETTINGS(X)                  \
+    X(Microsoft::Terminal::Core::Color, TabColor, nullptr)
+
 namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 {
     struct Profile : ProfileT<Profile>, IInheritable<Profile>
@@ -100,46 +137,16 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         Model::IAppearanceConfig DefaultAppearance();
 
         void _FinalizeInheritance() override;
+        void _FreezeSettings() override;
 
         WINRT_PROPERTY(OriginTag, Origin, OriginTag::Custom);
 
-        INHERITABLE_SETTING(Model::Profile, guid, Guid, _GenerateGuidForProfile(Name(), Source()));
-        INHERITABLE_SETTING(Model::Profile, hstring, Name, L"Default");
-        INHERITABLE_SETTING(Model::Profile, hstring, Source);
-        INHERITABLE_SETTING(Model::Profile, bool, Hidden, false);
-        INHERITABLE_SETTING(Model::Profile, guid, ConnectionType);
-
-        // Default Icon: Segoe MDL2 CommandPrompt icon
-        INHERITABLE_SETTING(Model::Profile, hstring, Icon, L"\uE756");
-
-        INHERITABLE_SETTING(Model::Profile, CloseOnExitMode, CloseOnExit, CloseOnExitMode::Graceful);
-        INHERITABLE_SETTING(Model::Profile, hstring, TabTitle);
-        INHERITABLE_NULLABLE_SETTING(Model::Profile, Microsoft::Terminal::Core::Color, TabColor, nullptr);
-        INHERITABLE_SETTING(Model::Profile, bool, SuppressApplicationTitle, false);
-
-        INHERITABLE_SETTING(Model::Profile, bool, UseAcrylic, false);
-        INHERITABLE_SETTING(Model::Profile, double, AcrylicOpacity, 0.5);
-        INHERITABLE_SETTING(Model::Profile, Microsoft::Terminal::Control::ScrollbarState, ScrollState, Microsoft::Terminal::Control::ScrollbarState::Visible);
-
-        INHERITABLE_SETTING(Model::Profile, hstring, FontFace, DEFAULT_FONT_FACE);
-        INHERITABLE_SETTING(Model::Profile, int32_t, FontSize, DEFAULT_FONT_SIZE);
-        INHERITABLE_SETTING(Model::Profile, Windows::UI::Text::FontWeight, FontWeight, DEFAULT_FONT_WEIGHT);
-        INHERITABLE_SETTING(Model::Profile, hstring, Padding, DEFAULT_PADDING);
-
-        INHERITABLE_SETTING(Model::Profile, hstring, Commandline, L"cmd.exe");
-        INHERITABLE_SETTING(Model::Profile, hstring, StartingDirectory);
-
-        INHERITABLE_SETTING(Model::Profile, Microsoft::Terminal::Control::TextAntialiasingMode, AntialiasingMode, Microsoft::Terminal::Control::TextAntialiasingMode::Grayscale);
-        INHERITABLE_SETTING(Model::Profile, bool, ForceFullRepaintRendering, false);
-        INHERITABLE_SETTING(Model::Profile, bool, SoftwareRendering, false);
-
-        INHERITABLE_SETTING(Model::Profile, int32_t, HistorySize, DEFAULT_HISTORY_SIZE);
-        INHERITABLE_SETTING(Model::Profile, bool, SnapOnInput, true);
-        INHERITABLE_SETTING(Model::Profile, bool, AltGrAliasing, true);
-
-        INHERITABLE_SETTING(Model::Profile, Model::BellStyle, BellStyle, BellStyle::Audible);
-
-        INHERITABLE_SETTING(Model::Profile, Model::IAppearanceConfig, UnfocusedAppearance, nullptr);
+#define PROFILE_SETTING(type, name, ...) INHERITABLE_SETTING(Model::Profile, type, name, __VA_ARGS__);
+#define PROFILE_NULLABLE_SETTING(type, name, ...) INHERITABLE_NULLABLE_SETTING(Model::Profile, type, name, __VA_ARGS__);
+        MTSM_PROFILE_SETTINGS(PROFILE_SETTING)
+        MTSM_PROFILE_NULLABLE_SETTINGS(PROFILE_NULLABLE_SETTING)
+#undef PROFILE_SETTING
+#undef PROFILE_NULLABLE_SETTING
 
     private:
         Model::IAppearanceConfig _DefaultAppearance{ winrt::make<AppearanceConfig>(weak_ref<Model::Profile>(*this)) };
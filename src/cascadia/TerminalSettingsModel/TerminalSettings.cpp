@@ -220,6 +220,86 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         return winrt::make<TerminalSettingsCreateResult>(*defaultChild, parent.UnfocusedSettings());
     }
 
+    // Method Description:
+    // - Checks whether two TerminalSettings would configure a terminal the same
+    //   way. The resolved value of each setting is compared, so the two may have
+    //   been created from entirely different CascadiaSettings.
+    // - Settings that are only used when a terminal is created (its commandline,
+    //   starting directory, initial size and so on) are ignored, because they
+    //   aren't applied to a terminal that already exists.
+    // Arguments:
+    // - lhs: the first settings to compare. May be null.
+    // - rhs: the second settings to compare. May be null.
+    // Return Value:
+    // - true if applying one of the settings to a terminal that uses the other
+    //   one wouldn't change anything.
+    bool TerminalSettings::Equivalent(const Model::TerminalSettings& lhs, const Model::TerminalSettings& rhs)
+    {
+        if (!lhs || !rhs)
+        {
+            return !lhs && !rhs;
+        }
+
+        const auto a{ get_self<TerminalSettings>(lhs) };
+        const auto b{ get_self<TerminalSettings>(rhs) };
+
+        // IReferences need to be compared by their value, not their identity.
+        const auto sameColor = [](const Windows::Foundation::IReference<Core::Color>& x, const Windows::Foundation::IReference<Core::Color>& y) {
+            return x ? y && x.Value() == y.Value() : !y;
+        };
+
+        // This must compare every setting that Terminal::UpdateSettings,
+        // Terminal::UpdateAppearance, ControlCore::UpdateSettings and
+        // TermControl::UpdateSettings read. Panes whose settings are
+        // equivalent aren't updated on a settings reload.
+
+        // Core settings
+        return a->ColorTable() == b->ColorTable() &&
+               a->DefaultForeground() == b->DefaultForeground() &&
+               a->DefaultBackground() == b->DefaultBackground() &&
+               a->SelectionBackground() == b->SelectionBackground() &&
+               a->HistorySize() == b->HistorySize() &&
+               a->SnapOnInput() == b->SnapOnInput() &&
+               a->AltGrAliasing() == b->AltGrAliasing() &&
+               a->CursorColor() == b->CursorColor() &&
+               a->CursorShape() == b->CursorShape() &&
+               a->CursorHeight() == b->CursorHeight() &&
+               a->WordDelimiters() == b->WordDelimiters() &&
+               a->CopyOnSelect() == b->CopyOnSelect() &&
+               a->InputServiceWarning() == b->InputServiceWarning() &&
+               a->FocusFollowMouse() == b->FocusFollowMouse() &&
+               a->TrimBlockSelection() == b->TrimBlockSelection() &&
+               a->DetectURLs() == b->DetectURLs() &&
+               sameColor(a->TabColor(), b->TabColor()) &&
+               sameColor(a->StartingTabColor(), b->StartingTabColor()) &&
+               a->StartingTitle() == b->StartingTitle() &&
+               a->InitialRows() == b->InitialRows() &&
+               a->InitialCols() == b->InitialCols() &&
+               // Control settings
+               a->ProfileName() == b->ProfileName() &&
+               a->StartingDirectory() == b->StartingDirectory() &&
+               a->UseAcrylic() == b->UseAcrylic() &&
+               a->TintOpacity() == b->TintOpacity() &&
+               a->Padding() == b->Padding() &&
+               a->FontFace() == b->FontFace() &&
+               a->FontSize() == b->FontSize() &&
+               a->FontWeight() == b->FontWeight() &&
+               a->BackgroundImage() == b->BackgroundImage() &&
+               a->BackgroundImageOpacity() == b->BackgroundImageOpacity() &&
+               a->BackgroundImageStretchMode() == b->BackgroundImageStretchMode() &&
+               a->BackgroundImageHorizontalAlignment() == b->BackgroundImageHorizontalAlignment() &&
+               a->BackgroundImageVerticalAlignment() == b->BackgroundImageVerticalAlignment() &&
+               a->KeyBindings() == b->KeyBindings() &&
+               a->SuppressApplicationTitle() == b->SuppressApplicationTitle() &&
+               a->ScrollState() == b->ScrollState() &&
+               a->AntialiasingMode() == b->AntialiasingMode() &&
+               a->RetroTerminalEffect() == b->RetroTerminalEffect() &&
+               a->ForceFullRepaintRendering() == b->ForceFullRepaintRendering() &&
+               a->SoftwareRendering() == b->SoftwareRendering() &&
+               a->ForceVTInput() == b->ForceVTInput() &&
+               a->PixelShaderPath() == b->PixelShaderPath();
+    }
+
     // Method Description:
     // - Sets our parent to the provided TerminalSettings
     // Arguments:
@@ -63,6 +63,8 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 
         static Model::TerminalSettingsCreateResult CreateWithParent(const Model::TerminalSettingsCreateResult& parent);
 
+        static bool Equivalent(const Model::TerminalSettings& lhs, const Model::TerminalSettings& rhs);
+
         Model::TerminalSettings GetParent();
 
         void SetParent(const Model::TerminalSettings& parent);
@@ -14,6 +14,7 @@
 #include "DefaultProfileUtils.h"
 
 static constexpr std::wstring_view DockerDistributionPrefix{ L"docker-desktop" };
+static constexpr std::wstring_view RegKeyLxss{ L"Software\\Microsoft\\Windows\\CurrentVersion\\Lxss" };
 
 using namespace ::Microsoft::Terminal::Settings::Model;
 using namespace winrt::Microsoft::Terminal::Settings::Model;
@@ -29,6 +30,28 @@ std::wstring_view WslDistroGenerator::GetNamespace()
     return WslGeneratorNamespace;
 }
 
+// Method Description:
+// - Every distro is registered as a subkey of the Lxss key in HKCU. Installing
+//   or removing one updates the key's last write time, which makes it a cheap way to tell whether `wsl.exe --list` could return anything new.
+// Arguments:
+// - <none>
+// Return Value:
+// - the Lxss key's subkey count and last write time, or an empty string if
+//   the key doesn't exist (yet)
+std::optional<std::wstring> WslDistroGenerator::GetFingerprint()
+{
+    wil::unique_hkey lxssKey;
+    if (RegOpenKeyExW(HKEY_CURRENT_USER, RegKeyLxss.data(), 0, KEY_READ, &lxssKey) != ERROR_SUCCESS)
+    {
+        return std::wstring{};
+    }
+
+    DWORD subKeys{ 0 };
+    FILETIME lastWriteTime{ 0 };
+    THROW_IF_WIN32_ERROR(RegQueryInfoKeyW(lxssKey.get(), nullptr, nullptr, nullptr, &subKeys, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, &lastWriteTime));
+    return fmt::format(L"{}:{:08x}{:08x}", subKeys, lastWriteTime.dwHighDateTime, lastWriteTime.dwLowDateTime);
+}
+
 // Method Description:
 // -  Enumerates all the installed WSL distros to create profiles for them.
 // Arguments:
@@ -26,5 +26,6 @@ namespace Microsoft::Terminal::Settings::Model
         ~WslDistroGenerator() = default;
         std::wstring_view GetNamespace() override;
         std::vector<winrt::Microsoft::Terminal::Settings::Model::Profile> GenerateProfiles() override;
+        std::optional<std::wstring> GetFingerprint() override;
     };
 };
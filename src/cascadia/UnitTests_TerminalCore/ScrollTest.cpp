@@ -54,6 +54,8 @@ namespace
         };
         virtual void TriggerCircling(){};
         void TriggerTitleChange(){};
+        void BeginInvalidationBatch(){};
+        void EndInvalidationBatch(){};
 
     private:
         std::optional<COORD> _triggerScrollDelta;
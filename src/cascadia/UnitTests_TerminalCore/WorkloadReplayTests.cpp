@@ -0,0 +1,446 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include <WexTestClass.h>
+#include <random>
+
+#include "../cascadia/TerminalCore/Terminal.hpp"
+#include "../cascadia/inc/VtRecording.h"
+#include "../renderer/inc/DummyRenderTarget.hpp"
+#include "consoletaeftemplates.hpp"
+
+using namespace Microsoft::Terminal::Core;
+using namespace Microsoft::Terminal::VtRecording;
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+namespace
+{
+    // Bump this whenever one of the workloads below changes, so that numbers
+    // measured with different versions of the corpus aren't compared.
+    static constexpr uint32_t CorpusVersion = 1;
+
+    // ConptyConnection reads the output pipe 4KB at a time.
+    static constexpr size_t ReadSize = 4096;
+
+    // The interactive workloads draw a frame at a time, at 60 frames per second.
+    static constexpr std::chrono::microseconds FrameInterval{ 16667 };
+
+    struct Workload
+    {
+        std::wstring_view name;
+        std::vector<Chunk> chunks;
+    };
+
+    // The corpus must be the same from run to run and from compiler to
+    // compiler, so the random numbers are always drawn in the same order,
+    // rather than in the unspecified order of function arguments.
+    template<size_t N>
+    std::array<uint32_t, N> _Draw(std::minstd_rand& rng, const std::array<uint32_t, N>& bounds)
+    {
+        std::array<uint32_t, N> values{};
+        for (size_t i = 0; i < N; i++)
+        {
+            values.at(i) = gsl::narrow_cast<uint32_t>(rng() % bounds.at(i));
+        }
+        return values;
+    }
+
+    // A 64-bit FNV-1a hash of every chunk of a workload. It's logged next to
+    // the results, so that the corpora two builds were measured with can be
+    // told apart even if CorpusVersion wasn't bumped.
+    uint64_t _Hash(const Workload& workload) noexcept
+    {
+        uint64_t hash = 14695981039346656037ull;
+        const auto append = [&](const std::string_view bytes) {
+            for (const auto ch : bytes)
+            {
+                hash ^= static_cast<uint8_t>(ch);
+                hash *= 1099511628211ull;
+            }
+        };
+
+        for (const auto& chunk : workload.chunks)
+        {
+            const auto kind = static_cast<char>(chunk.kind);
+            const auto timestamp = chunk.timestamp.count();
+            append({ &kind, 1 });
+            append({ reinterpret_cast<const char*>(&timestamp), sizeof(timestamp) });
+            append(chunk.text);
+        }
+        return hash;
+    }
+
+    // Splits the output written at the given time into the reads a
+    // connection would have received it in.
+    void _AppendReads(std::vector<Chunk>& chunks, std::string_view output, const std::chrono::microseconds timestamp)
+    {
+        while (!output.empty())
+        {
+            const auto read = output.substr(0, ReadSize);
+            chunks.push_back({ ChunkKind::Output, timestamp, std::string{ read } });
+            output.remove_prefix(read.size());
+        }
+    }
+
+    // `cat` of a large log file: plain text in full reads.
+    Workload _CatLog()
+    {
+        static constexpr std::array<std::string_view, 4> levels{ "INFO", "INFO", "WARN", "DEBUG" };
+
+        std::minstd_rand rng;
+        std::string output;
+        for (uint32_t line = 0; output.size() < 4 * 1024 * 1024; line++)
+        {
+            const auto [level, worker, duration] = _Draw<3>(rng, { gsl::narrow_cast<uint32_t>(levels.size()), 16, 1000 });
+            fmt::format_to(std::back_inserter(output),
+                           FMT_STRING("2021-06-01T{:02}:{:02}:{:02}.{:03}Z [{}] worker-{}: processed request {} in {} ms\r\n"),
+                           line / 360000 % 24,
+                           line / 6000 % 60,
+                           line / 100 % 60,
+                           line % 100 * 10,
+                           levels.at(level),
+                           worker,
+                           line,
+                           duration);
+        }
+
+        Workload workload{ L"cat", {} };
+        _AppendReads(workload.chunks, output, {});
+        return workload;
+    }
+
+    // Colorized compiler output: short lines that are mostly SGR sequences.
+    Workload _CompilerOutput()
+    {
+        Workload workload{ L"compiler", {} };
+
+        std::minstd_rand rng;
+        std::string output;
+        for (uint32_t diagnostic = 0; diagnostic < 20000; diagnostic++)
+        {
+            const auto [severity, directory, file, lineNumber, column] = _Draw<5>(rng, { 4, 32, 256, 2000, 80 });
+            const auto error = severity == 0;
+            fmt::format_to(std::back_inserter(output),
+                           FMT_STRING("\x1b[1msrc/module{}/file{}.cpp:{}:{}: {}\x1b[0m\x1b[1m{} 'value{}'\x1b[0m\r\n"
+                                      "    auto value{} = \x1b[1;32mcompute\x1b[0m(first, second);\r\n"
+                                      "\x1b[1;32m         ^~~~~~\x1b[0m\r\n"),
+                           directory,
+                           file,
+                           lineNumber + 1,
+                           column + 1,
+                           error ? "\x1b[1;31merror: " : "\x1b[1;35mwarning: ",
+                           error ? "use of undeclared identifier" : "unused variable",
+                           diagnostic,
+                           diagnostic);
+
+            // The compiler flushes a batch of diagnostics every few milliseconds.
+            if (diagnostic % 16 == 15)
+            {
+                _AppendReads(workload.chunks, output, FrameInterval * (diagnostic / 16));
+                output.clear();
+            }
+        }
+        _AppendReads(workload.chunks, output, {});
+        return workload;
+    }
+
+    // `vim` scrolling through a file a line at a time: every frame scrolls
+    // the margins, draws the new line and redraws the status line.
+    Workload _VimScrolling()
+    {
+        Workload workload{ L"vim", {} };
+
+        std::minstd_rand rng;
+        std::string frame;
+        for (uint32_t line = 0; line < 10000; line++)
+        {
+            const auto [index, bound, commentLength] = _Draw<3>(rng, { 100, 65536, 60 });
+            frame.clear();
+            fmt::format_to(std::back_inserter(frame),
+                           FMT_STRING("\x1b[?25l\x1b[1;29r\x1b[29;1H\n\x1b[r\x1b[29;1H"
+                                      "\x1b[33m{:>5} \x1b[m    \x1b[38;5;130mif\x1b[m (\x1b[36mindex{}\x1b[m < \x1b[31m{}\x1b[m) {{ \x1b[34m// {}\x1b[m\x1b[K"
+                                      "\x1b[30;1H\x1b[7m\"source.cpp\" {}L, {}B{:>60}{},1{:>10}\x1b[27m"
+                                      "\x1b[28;7H\x1b[?25h"),
+                           line + 29,
+                           index,
+                           bound,
+                           std::string(commentLength, 'x'),
+                           10000,
+                           480000,
+                           "",
+                           line + 29,
+                           "Top");
+            _AppendReads(workload.chunks, frame, FrameInterval * line);
+        }
+        return workload;
+    }
+
+    // `htop` redrawing the whole screen with colored meters and a process list.
+    Workload _Htop()
+    {
+        Workload workload{ L"htop", {} };
+
+        std::minstd_rand rng;
+        std::string frame;
+        for (uint32_t refresh = 0; refresh < 2000; refresh++)
+        {
+            frame.assign("\x1b[?25l\x1b[H");
+            for (uint32_t cpu = 0; cpu < 8; cpu++)
+            {
+                const auto [user, system, tenths] = _Draw<3>(rng, { 30, 10, 10 });
+                fmt::format_to(std::back_inserter(frame),
+                               FMT_STRING("\x1b[{};1H\x1b[36m{:>3}\x1b[39m\x1b[1m[\x1b[32m{}\x1b[31m{}\x1b[39m{:>{}}{:>3}.{}%\x1b[1m]\x1b[m\x1b[K"),
+                               cpu + 1,
+                               cpu,
+                               std::string(user, '|'),
+                               std::string(system, '|'),
+                               "",
+                               40 - user - system,
+                               user + system,
+                               tenths);
+            }
+
+            frame.append("\x1b[10;1H\x1b[30;42m  PID USER      PRI  NI  VIRT   RES   SHR S CPU% MEM%   TIME+  Command\x1b[K\x1b[m");
+            for (uint32_t row = 0; row < 20; row++)
+            {
+                const auto [pid, virt, res, shr, cpu, mem, minutes, seconds, hundredths] = _Draw<9>(rng, { 32768, 4096, 1024, 256, 100, 10, 60, 60, 100 });
+                fmt::format_to(std::back_inserter(frame),
+                               FMT_STRING("\x1b[{};1H{}{:>5} user       20   0 {:>5}M {:>5}M {:>5}M S {:>4} {:>4} {:>2}:{:02}.{:02} \x1b[32m/usr/bin/process{}\x1b[m\x1b[K"),
+                               row + 11,
+                               row == refresh % 20 ? "\x1b[30;46m" : "",
+                               pid,
+                               virt,
+                               res,
+                               shr,
+                               cpu,
+                               mem,
+                               minutes,
+                               seconds,
+                               hundredths,
+                               row);
+            }
+            _AppendReads(workload.chunks, frame, FrameInterval * refresh);
+        }
+        return workload;
+    }
+
+    // Emoji and CJK text: wide glyphs and surrogate pairs, with reads that
+    // split characters in half.
+    Workload _WideText()
+    {
+        static constexpr std::array<std::string_view, 6> words{
+            u8"漢字",
+            u8"テキスト",
+            u8"한국어",
+            u8"😀",
+            u8"🚀🚀",
+            u8"👍🏽",
+        };
+
+        std::minstd_rand rng;
+        std::string output;
+        while (output.size() < 2 * 1024 * 1024)
+        {
+            for (auto word = rng() % 16 + 4; word > 0; word--)
+            {
+                output.append(words.at(rng() % words.size()));
+                output.push_back(' ');
+            }
+            output.append("\r\n");
+        }
+
+        Workload workload{ L"wide", {} };
+        _AppendReads(workload.chunks, output, {});
+        return workload;
+    }
+}
+
+namespace TerminalCoreUnitTests
+{
+    class WorkloadReplayTests;
+};
+using namespace TerminalCoreUnitTests;
+
+class TerminalCoreUnitTests::WorkloadReplayTests final
+{
+    static const SHORT TerminalViewWidth = 120;
+    static const SHORT TerminalViewHeight = 30;
+    static const SHORT TerminalHistoryLength = 9001;
+
+    TEST_CLASS(WorkloadReplayTests);
+
+    TEST_METHOD(RecordingRoundTrip);
+
+    BEGIN_TEST_METHOD(ReplaySyntheticWorkloads)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD()
+
+    // Replays a captured session, given with /p:VtRecording=<path>. This is
+    // either a recording made with the RecordingTapConnection, or the raw
+    // output of an application (e.g. captured with `script`), which is
+    // replayed in ReadSize chunks.
+    TEST_METHOD(ReplayRecording);
+
+private:
+    void _Replay(const std::wstring_view name, const std::vector<Chunk>& chunks);
+};
+
+void WorkloadReplayTests::RecordingRoundTrip()
+{
+    using namespace std::chrono_literals;
+
+    auto recording = FormatHeader();
+    AppendChunk(recording, ChunkKind::Output, 0us, "\x1b[31mred");
+    AppendChunk(recording, ChunkKind::Input, 1500us, "q");
+    AppendChunk(recording, ChunkKind::Output, 2s, "");
+
+    const auto chunks = Parse(recording);
+    VERIFY_ARE_EQUAL(3u, chunks.size());
+    VERIFY_IS_TRUE(chunks.at(0).kind == ChunkKind::Output);
+    VERIFY_IS_TRUE(chunks.at(0).timestamp == 0us);
+    VERIFY_IS_TRUE(chunks.at(0).text == "\x1b[31mred");
+    VERIFY_IS_TRUE(chunks.at(1).kind == ChunkKind::Input);
+    VERIFY_IS_TRUE(chunks.at(1).timestamp == 1500us);
+    VERIFY_IS_TRUE(chunks.at(1).text == "q");
+    VERIFY_IS_TRUE(chunks.at(2).kind == ChunkKind::Output);
+    VERIFY_IS_TRUE(chunks.at(2).timestamp == 2s);
+    VERIFY_IS_TRUE(chunks.at(2).text.empty());
+
+    Log::Comment(L"A recording without any chunks is valid.");
+    VERIFY_IS_TRUE(Parse(FormatHeader()).empty());
+
+    Log::Comment(L"Truncated recordings and other files should be rejected.");
+    VERIFY_THROWS(Parse(recording.substr(0, recording.size() - 2)), wil::ResultException);
+    VERIFY_THROWS(Parse(std::string_view{ recording }.substr(4)), wil::ResultException);
+    VERIFY_THROWS(Parse(""), wil::ResultException);
+}
+
+void WorkloadReplayTests::ReplaySyntheticWorkloads()
+{
+    Log::Comment(NoThrowString().Format(L"Workload corpus version %u", CorpusVersion));
+
+    const auto generate = [] {
+        return std::array<Workload, 5>{ _CatLog(), _CompilerOutput(), _VimScrolling(), _Htop(), _WideText() };
+    };
+
+    const auto workloads = generate();
+    const auto regenerated = generate();
+    for (size_t i = 0; i < workloads.size(); i++)
+    {
+        const auto& workload = workloads.at(i);
+        const auto hash = _Hash(workload);
+
+        // The corpus must be the same from run to run, so that the numbers
+        // of two builds can be compared. Generating it again must yield the
+        // exact same chunks, and the hash is logged to compare across builds.
+        VERIFY_IS_FALSE(workload.chunks.empty());
+        VERIFY_ARE_EQUAL(hash, _Hash(regenerated.at(i)));
+        Log::Comment(NoThrowString().Format(L"%.*s: corpus hash %016llx",
+                                            gsl::narrow_cast<int>(workload.name.size()),
+                                            workload.name.data(),
+                                            hash));
+
+        _Replay(workload.name, workload.chunks);
+    }
+}
+
+void WorkloadReplayTests::ReplayRecording()
+{
+    String path;
+    if (FAILED(RuntimeParameters::TryGetValue(L"VtRecording", path)))
+    {
+        Log::Comment(L"No recording was given with /p:VtRecording=<path>.");
+        Log::Result(WEX::Logging::TestResults::Skipped);
+        return;
+    }
+
+    std::ifstream file{ static_cast<const wchar_t*>(path), std::ios::binary };
+    VERIFY_IS_TRUE(file.good());
+    const std::string recording{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+
+    std::vector<Chunk> chunks;
+    if (std::string_view{ recording }.substr(0, Signature.size()) == Signature)
+    {
+        chunks = Parse(recording);
+    }
+    else
+    {
+        Log::Comment(L"Not a recording, replaying the file as raw output.");
+        _AppendReads(chunks, recording, {});
+    }
+
+    const std::wstring_view name{ static_cast<const wchar_t*>(path) };
+    _Replay(name.substr(name.find_last_of(L"\\/") + 1), chunks);
+}
+
+// Method Description:
+// - Writes the output chunks of a workload into a new Terminal, one
+//   Terminal::Write per chunk, and logs the throughput and the distribution
+//   of the time each write took. Input chunks are ignored.
+// Arguments:
+// - name: the name to log the results under
+// - chunks: the recorded chunks, in order
+// Return Value:
+// - <none>
+void WorkloadReplayTests::_Replay(const std::wstring_view name, const std::vector<Chunk>& chunks)
+{
+    // Decode everything up front, the way ConptyConnection does for every
+    // read, so that only the Terminal is measured.
+    til::u8state state;
+    std::vector<std::wstring> writes;
+    size_t bytes = 0;
+    for (const auto& chunk : chunks)
+    {
+        if (chunk.kind == ChunkKind::Output)
+        {
+            VERIFY_SUCCEEDED(til::u8u16(std::string_view{ chunk.text }, writes.emplace_back(), state));
+            bytes += chunk.text.size();
+        }
+    }
+
+    if (writes.empty())
+    {
+        Log::Comment(NoThrowString().Format(L"%.*s: no output to replay", gsl::narrow_cast<int>(name.size()), name.data()));
+        return;
+    }
+
+    DummyRenderTarget renderTarget;
+    Terminal term;
+    term.Create({ TerminalViewWidth, TerminalViewHeight }, TerminalHistoryLength, renderTarget);
+
+    std::vector<std::chrono::steady_clock::duration> latencies;
+    latencies.reserve(writes.size());
+    std::chrono::steady_clock::duration total{};
+    for (const auto& text : writes)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        term.Write(text);
+        latencies.push_back(std::chrono::steady_clock::now() - start);
+        total += latencies.back();
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    // The nearest-rank percentile, in microseconds.
+    const auto percentile = [&](const size_t percent) {
+        const auto rank = std::max<size_t>((latencies.size() * percent + 99) / 100, 1);
+        return std::chrono::duration<double, std::micro>(latencies.at(rank - 1)).count();
+    };
+
+    const auto seconds = std::chrono::duration<double>(total).count();
+    const auto megabytes = bytes / 1048576.0;
+    Log::Comment(NoThrowString().Format(L"%.*s: %zu chunks, %.2f MB in %.2f ms (%.1f MB/s), chunk latency p50 %.1f us, p90 %.1f us, p99 %.1f us, max %.1f us",
+                                        gsl::narrow_cast<int>(name.size()),
+                                        name.data(),
+                                        writes.size(),
+                                        megabytes,
+                                        seconds * 1000,
+                                        megabytes / seconds,
+                                        percentile(50),
+                                        percentile(90),
+                                        percentile(99),
+                                        percentile(100)));
+}
@@ -0,0 +1,132 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- VtRecording.h
+
+Abstract:
+- Reads and writes recordings of the traffic of a terminal connection: every
+  chunk of output exactly as it was read, and every string of input that was
+  written to the connection, each with the time it happened.
+- A recording starts with the signature "VTRC" and a 32-bit format version,
+  followed by the chunks. Each chunk is stored as:
+    uint8   kind (0 = output, 1 = input)
+    uint64  microseconds since the recording started
+    uint32  length of the text, in bytes
+    char[]  the text, in UTF-8
+  All the integers are little endian.
+- Raw pty captures may split a character across two chunks. Replays should
+  decode the output with a til::u8state, the way ConptyConnection does.
+--*/
+
+#pragma once
+
+namespace Microsoft::Terminal::VtRecording
+{
+    enum class ChunkKind : uint8_t
+    {
+        Output = 0,
+        Input = 1,
+    };
+
+    struct Chunk
+    {
+        ChunkKind kind;
+        std::chrono::microseconds timestamp;
+        std::string text;
+    };
+
+    static constexpr std::string_view Signature{ "VTRC" };
+    // Bump this whenever the layout of a recording changes.
+    static constexpr uint32_t FormatVersion{ 1 };
+
+    namespace details
+    {
+        template<typename T>
+        void AppendInteger(std::string& recording, const T value)
+        {
+            for (size_t i = 0; i < sizeof(T); i++)
+            {
+                recording.push_back(gsl::narrow_cast<char>((value >> (i * 8)) & 0xff));
+            }
+        }
+
+        template<typename T>
+        T ReadInteger(std::string_view& recording)
+        {
+            THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), recording.size() < sizeof(T));
+
+            T value{ 0 };
+            for (size_t i = 0; i < sizeof(T); i++)
+            {
+                value |= static_cast<T>(static_cast<uint8_t>(til::at(recording, i))) << (i * 8);
+            }
+            recording.remove_prefix(sizeof(T));
+            return value;
+        }
+    }
+
+    // Function Description:
+    // - Builds the header that every recording starts with.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - the signature and format version
+    inline std::string FormatHeader()
+    {
+        std::string header{ Signature };
+        details::AppendInteger(header, FormatVersion);
+        return header;
+    }
+
+    // Function Description:
+    // - Appends a single chunk to a recording.
+    // Arguments:
+    // - recording: the recording to append to. This may also be an empty
+    //   string, when the chunks are streamed to a file one at a time.
+    // - kind: whether the text was output or input
+    // - timestamp: the time since the recording started
+    // - text: the text of the chunk, in UTF-8
+    // Return Value:
+    // - <none>
+    inline void AppendChunk(std::string& recording, const ChunkKind kind, const std::chrono::microseconds timestamp, const std::string_view text)
+    {
+        recording.reserve(recording.size() + 13 + text.size());
+        details::AppendInteger(recording, static_cast<uint8_t>(kind));
+        details::AppendInteger(recording, gsl::narrow<uint64_t>(timestamp.count()));
+        details::AppendInteger(recording, gsl::narrow<uint32_t>(text.size()));
+        recording.append(text);
+    }
+
+    // Function Description:
+    // - Parses a whole recording into its chunks.
+    // Arguments:
+    // - recording: the contents of the recording
+    // Return Value:
+    // - the chunks, in the order they were recorded
+    // - Throws ERROR_INVALID_DATA if this isn't a recording, and
+    //   ERROR_UNSUPPORTED_TYPE if it was made with a newer format version.
+    inline std::vector<Chunk> Parse(std::string_view recording)
+    {
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), recording.substr(0, Signature.size()) != Signature);
+        recording.remove_prefix(Signature.size());
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_UNSUPPORTED_TYPE), details::ReadInteger<uint32_t>(recording) > FormatVersion);
+
+        std::vector<Chunk> chunks;
+        while (!recording.empty())
+        {
+            const auto kind = details::ReadInteger<uint8_t>(recording);
+            THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), kind > static_cast<uint8_t>(ChunkKind::Input));
+            const auto timestamp = details::ReadInteger<uint64_t>(recording);
+            const auto length = details::ReadInteger<uint32_t>(recording);
+            THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), recording.size() < length);
+
+            chunks.push_back({ static_cast<ChunkKind>(kind),
+                               std::chrono::microseconds{ gsl::narrow<int64_t>(timestamp) },
+                               std::string{ recording.substr(0, length) } });
+            recording.remove_prefix(length);
+        }
+        return chunks;
+    }
+}
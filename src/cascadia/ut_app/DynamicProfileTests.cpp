@@ -55,6 +55,14 @@ namespace TerminalAppUnitTests
         TEST_METHOD(UserProfilesWithInvalidSourcesAreIgnored);
         // This does the same, but by disabling a profile source
         TEST_METHOD(UserProfilesFromDisabledSourcesDontAppear);
+
+        // Generators with an unchanged fingerprint shouldn't be run again
+        TEST_METHOD(TestCachedGeneratorsDontRerun);
+
+        // Measures how long slow generators hold up loading the settings
+        BEGIN_TEST_METHOD(TestSlowGeneratorsLoadTime)
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD()
     };
 
     void DynamicProfileTests::TestSimpleGenerate()
@@ -670,4 +678,118 @@ namespace TerminalAppUnitTests
         VERIFY_ARE_EQUAL(2u, settings->_allProfiles.Size());
     }
 
+    void DynamicProfileTests::TestCachedGeneratorsDontRerun()
+    {
+        implementation::CascadiaSettings::_dynamicProfileCache.clear();
+
+        std::atomic<int> generated{ 0 };
+        std::wstring fingerprint{ L"first" };
+        const auto makeGenerator = [&]() {
+            auto gen = std::make_unique<TestDynamicProfileGenerator>(L"Terminal.App.UnitTest.0");
+            gen->pfnGenerate = [&]() {
+                ++generated;
+                std::vector<Profile> profiles;
+                Profile p0 = winrt::make<implementation::Profile>();
+                p0.Name(L"profile0");
+                profiles.push_back(p0);
+                return profiles;
+            };
+            gen->pfnFingerprint = [&]() -> std::optional<std::wstring> {
+                return fingerprint;
+            };
+            return gen;
+        };
+
+        auto settings0 = winrt::make_self<implementation::CascadiaSettings>(false);
+        settings0->_profileGenerators.emplace_back(makeGenerator());
+        settings0->_LoadDynamicProfiles();
+        VERIFY_ARE_EQUAL(1, generated.load());
+        VERIFY_ARE_EQUAL(1u, settings0->_allProfiles.Size());
+
+        Log::Comment(L"The same fingerprint should reuse the profiles from the last run");
+        auto settings1 = winrt::make_self<implementation::CascadiaSettings>(false);
+        settings1->_profileGenerators.emplace_back(makeGenerator());
+        settings1->_LoadDynamicProfiles();
+        VERIFY_ARE_EQUAL(1, generated.load());
+        VERIFY_ARE_EQUAL(1u, settings1->_allProfiles.Size());
+        VERIFY_ARE_EQUAL(L"profile0", settings1->_allProfiles.GetAt(0).Name());
+        VERIFY_ARE_EQUAL(L"Terminal.App.UnitTest.0", settings1->_allProfiles.GetAt(0).Source());
+
+        Log::Comment(L"Cached profiles must not be shared between settings objects");
+        settings1->_allProfiles.GetAt(0).Name(L"renamed");
+        VERIFY_ARE_EQUAL(L"profile0", settings0->_allProfiles.GetAt(0).Name());
+
+        auto settings2 = winrt::make_self<implementation::CascadiaSettings>(false);
+        settings2->_profileGenerators.emplace_back(makeGenerator());
+        settings2->_LoadDynamicProfiles();
+        VERIFY_ARE_EQUAL(1, generated.load());
+        VERIFY_ARE_EQUAL(L"profile0", settings2->_allProfiles.GetAt(0).Name());
+
+        Log::Comment(L"A new fingerprint should run the generator again");
+        fingerprint = L"second";
+        auto settings3 = winrt::make_self<implementation::CascadiaSettings>(false);
+        settings3->_profileGenerators.emplace_back(makeGenerator());
+        settings3->_LoadDynamicProfiles();
+        VERIFY_ARE_EQUAL(2, generated.load());
+        VERIFY_ARE_EQUAL(1u, settings3->_allProfiles.Size());
+
+        implementation::CascadiaSettings::_dynamicProfileCache.clear();
+    }
+
+    void DynamicProfileTests::TestSlowGeneratorsLoadTime()
+    {
+        implementation::CascadiaSettings::_dynamicProfileCache.clear();
+
+        static constexpr uint32_t generatorCount{ 4 };
+        static constexpr std::chrono::milliseconds generatorDelay{ 250 };
+
+        const auto load = [](const bool withFingerprint) {
+            auto settings = winrt::make_self<implementation::CascadiaSettings>(false);
+            for (uint32_t i = 0; i < generatorCount; ++i)
+            {
+                auto gen = std::make_unique<TestDynamicProfileGenerator>(fmt::format(L"Terminal.App.UnitTest.{}", i));
+                gen->pfnGenerate = [i]() {
+                    // Pretend to wait on an external process, like `wsl.exe --list`.
+                    std::this_thread::sleep_for(generatorDelay);
+                    std::vector<Profile> profiles;
+                    Profile p0 = winrt::make<implementation::Profile>();
+                    p0.Name(fmt::format(L"profile{}", i));
+                    profiles.push_back(p0);
+                    return profiles;
+                };
+                if (withFingerprint)
+                {
+                    gen->pfnFingerprint = []() -> std::optional<std::wstring> {
+                        return L"unchanged";
+                    };
+                }
+                settings->_profileGenerators.emplace_back(std::move(gen));
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            settings->_LoadDynamicProfiles();
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+            VERIFY_ARE_EQUAL(generatorCount, settings->_allProfiles.Size());
+            for (uint32_t i = 0; i < generatorCount; ++i)
+            {
+                VERIFY_ARE_EQUAL(winrt::hstring{ fmt::format(L"profile{}", i) }, settings->_allProfiles.GetAt(i).Name());
+            }
+            return elapsed;
+        };
+
+        Log::Comment(String().Format(L"%u generators taking %lldms each, run one after another, would take %lldms.",
+                                     generatorCount,
+                                     generatorDelay.count(),
+                                     (generatorDelay * generatorCount).count()));
+
+        const auto uncached = load(false);
+        Log::Comment(String().Format(L"Without fingerprints: %lldms", uncached.count()));
+
+        load(true);
+        const auto cached = load(true);
+        Log::Comment(String().Format(L"With unchanged fingerprints: %lldms", cached.count()));
+
+        implementation::CascadiaSettings::_dynamicProfileCache.clear();
+    }
 };
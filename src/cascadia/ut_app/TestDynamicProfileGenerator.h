@@ -38,7 +38,17 @@ public:
         return std::vector<winrt::Microsoft::Terminal::Settings::Model::Profile>{};
     }
 
+    std::optional<std::wstring> GetFingerprint() override
+    {
+        if (pfnFingerprint)
+        {
+            return pfnFingerprint();
+        }
+        return std::nullopt;
+    }
+
     std::wstring _namespace;
 
     std::function<std::vector<winrt::Microsoft::Terminal::Settings::Model::Profile>()> pfnGenerate{ nullptr };
+    std::function<std::optional<std::wstring>()> pfnFingerprint{ nullptr };
 };
@@ -110,3 +110,25 @@ void ScreenBufferRenderTarget::TriggerTitleChange()
         pRenderer->TriggerTitleChange();
     }
 }
+
+// Unlike the other methods, these are forwarded even if we're not the active
+// buffer. The active buffer may change in the middle of a batch (for instance
+// when an application switches to the alternate buffer), and the renderer
+// needs to see every begin matched with an end.
+void ScreenBufferRenderTarget::BeginInvalidationBatch()
+{
+    auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
+    if (pRenderer != nullptr)
+    {
+        pRenderer->BeginInvalidationBatch();
+    }
+}
+
+void ScreenBufferRenderTarget::EndInvalidationBatch()
+{
+    auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
+    if (pRenderer != nullptr)
+    {
+        pRenderer->EndInvalidationBatch();
+    }
+}
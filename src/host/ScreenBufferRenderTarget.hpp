@@ -39,6 +39,8 @@ public:
     void TriggerScroll(const COORD* const pcoordDelta) override;
     void TriggerCircling() override;
     void TriggerTitleChange() override;
+    void BeginInvalidationBatch() override;
+    void EndInvalidationBatch() override;
 
 private:
     SCREEN_INFORMATION& _owner;
@@ -969,6 +969,23 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
                 StateMachine& machine = screenInfo.GetStateMachine();
                 size_t const cch = BufferSize / sizeof(WCHAR);
 
+                // Let the renderer merge the redraws for every run of text
+                // we print into one invalidation once the string is done.
+                // This goes straight to the renderer rather than through
+                // screenInfo, which might be an alternate buffer that gets
+                // destroyed by one of the sequences in the string.
+                auto* const pRender = ServiceLocator::LocateGlobals().pRender;
+                if (pRender)
+                {
+                    pRender->BeginInvalidationBatch();
+                }
+                auto endBatch = wil::scope_exit([&]() {
+                    if (pRender)
+                    {
+                        pRender->EndInvalidationBatch();
+                    }
+                });
+
                 machine.ProcessString({ pwchRealUnicode, cch });
                 *pcb += BufferSize;
             }
@@ -998,7 +1015,7 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
 // - STATUS_SUCCESS if OK.
 // - CONSOLE_STATUS_WAIT if we couldn't finish now and need to be called back later (see ppWaiter).
 // - Or a suitable NTSTATUS format error code for memory/string/math failures.
-[[nodiscard]] NTSTATUS DoWriteConsole(_In_reads_bytes_(*pcbBuffer) PWCHAR pwchBuffer,
+[[nodiscard]] NTSTATUS DoWriteConsole(_In_reads_bytes_(*pcbBuffer) const wchar_t* pwchBuffer,
                                       _Inout_ size_t* const pcbBuffer,
                                       SCREEN_INFORMATION& screenInfo,
                                       bool requiresVtQuirk,
@@ -1048,6 +1065,44 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
                       nullptr);
 }
 
+// Routine Description:
+// - Takes the given text and inserts it into the given screen buffer.
+// - This is the std::wstring_view flavor of the above. The text is handed down
+//   as-is without being copied, the byte count is only used internally.
+// Note:
+// - Console lock must be held when calling this routine
+// Arguments:
+// - string - wide character text to be inserted into buffer
+// - read - on return, the number of characters consumed
+// - screenInfo - Screen Information class to write the text into at the current cursor position
+// - requiresVtQuirk - whether the legacy VT attribute quirk should be engaged for this write
+// - waiter - If writing to the console is blocked for whatever reason, this will be filled with a pointer to context
+//            that can be used by the server to resume the call at a later time.
+// Return Value:
+// - STATUS_SUCCESS if OK.
+// - CONSOLE_STATUS_WAIT if we couldn't finish now and need to be called back later (see waiter).
+// - Or a suitable NTSTATUS format error code for memory/string/math failures.
+[[nodiscard]] NTSTATUS DoWriteConsole(const std::wstring_view string,
+                                      size_t& read,
+                                      SCREEN_INFORMATION& screenInfo,
+                                      bool requiresVtQuirk,
+                                      std::unique_ptr<WriteData>& waiter)
+{
+    read = 0;
+
+    size_t cbBuffer;
+    const auto hr = SizeTMult(string.size(), sizeof(wchar_t), &cbBuffer);
+    if (FAILED(hr))
+    {
+        return NTSTATUS_FROM_HRESULT(hr);
+    }
+
+    const auto Status = DoWriteConsole(string.data(), &cbBuffer, screenInfo, requiresVtQuirk, waiter);
+
+    read = cbBuffer / sizeof(wchar_t);
+    return Status;
+}
+
 // Routine Description:
 // - This method performs the actual work of attempting to write to the console, converting data types as necessary
 //   to adapt from the server types to the legacy internal host types.
@@ -1074,14 +1129,7 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
         read = 0;
         waiter.reset();
 
-        // Convert characters to bytes to give to DoWriteConsole.
-        size_t cbTextBufferLength;
-        RETURN_IF_FAILED(SizeTMult(buffer.size(), sizeof(wchar_t), &cbTextBufferLength));
-
-        NTSTATUS Status = DoWriteConsole(const_cast<wchar_t*>(buffer.data()), &cbTextBufferLength, context, requiresVtQuirk, waiter);
-
-        // Convert back from bytes to characters for the resulting string length written.
-        read = cbTextBufferLength / sizeof(wchar_t);
+        NTSTATUS Status = DoWriteConsole(buffer, read, context, requiresVtQuirk, waiter);
 
         if (Status == CONSOLE_STATUS_WAIT)
         {
@@ -1133,9 +1181,17 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
         const auto codepage{ consoleInfo.OutputCP };
         auto leadByteCaptured{ false };
         auto leadByteConsumed{ false };
-        std::wstring wstr{};
         static til::u8state u8State{};
 
+        // Convert into the reusable buffer of the main screen buffer, so that we don't
+        // need to allocate a new string for every write. We deliberately don't use the
+        // active buffer's one: an alternate buffer may be destroyed by the VT sequences
+        // contained in the text while we're still writing it.
+        auto& mainBuffer{ screenInfo.GetMainBuffer() };
+        auto& wstr{ mainBuffer.GetWriteConversionBuffer() };
+        // A waiter copies the text it needs, so once we return, the buffer is free to go.
+        auto trim{ wil::scope_exit([&] { mainBuffer.TrimWriteConversionBuffer(); }) };
+
         // Convert our input parameters to Unicode
         if (codepage == CP_UTF8)
         {
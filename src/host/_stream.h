@@ -90,8 +90,15 @@ Note:
 
 // NOTE: console lock must be held when calling this routine
 // String has been translated to unicode at this point.
-[[nodiscard]] NTSTATUS DoWriteConsole(_In_reads_bytes_(*pcbBuffer) PWCHAR pwchBuffer,
+[[nodiscard]] NTSTATUS DoWriteConsole(_In_reads_bytes_(*pcbBuffer) const wchar_t* pwchBuffer,
                                       _Inout_ size_t* const pcbBuffer,
                                       SCREEN_INFORMATION& screenInfo,
                                       bool requiresVtQuirk,
                                       std::unique_ptr<WriteData>& waiter);
+
+// Same as above, but takes the text as a view and reports the number of characters consumed.
+[[nodiscard]] NTSTATUS DoWriteConsole(const std::wstring_view string,
+                                      size_t& read,
+                                      SCREEN_INFORMATION& screenInfo,
+                                      bool requiresVtQuirk,
+                                      std::unique_ptr<WriteData>& waiter);
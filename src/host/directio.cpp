@@ -786,7 +786,6 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 {
     try
     {
-        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         const auto& storageBuffer = context.GetActiveBuffer();
         const auto storageSize = storageBuffer.GetBufferSize().Dimensions();
 
@@ -824,41 +823,26 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 
         // We will start reading the buffer at the point of the top left corner (origin) of the (potentially adjusted) request
         const auto sourcePoint = clippedRequestRectangle.Origin();
+        const auto& textBuffer = storageBuffer.GetTextBuffer();
 
-        // Get an iterator to the beginning of the return buffer
-        // We might have to seek this forward or skip around if we clipped the request.
-        auto targetIter = targetBuffer.begin();
-        COORD targetPos = { 0 };
-        const auto targetLimit = Viewport::FromDimensions(targetPoint, clippedRequestRectangle.Dimensions());
-
-        // Get an iterator to the beginning of the request inside the screen buffer
-        // This should walk exactly along every cell of the clipped request.
-        auto sourceIter = storageBuffer.GetCellDataAt(sourcePoint, clippedRequestRectangle);
-
-        // Walk through every cell of the target, advancing the buffer.
-        // Validate that we always still have a valid iterator to the backing store,
-        // that we always are writing inside the user's buffer (before the end)
-        // and we're always targeting the user's buffer inside its original bounds.
-        while (sourceIter && targetIter < targetBuffer.end())
+        // Copy the clipped request out of the text buffer one row at a time, straight into the
+        // right spot of the user's buffer. Legacy full screen apps read the entire viewport this
+        // way every frame, so we avoid going through a cell iterator here.
+        // The user's buffer may be smaller than the request, so stop as soon as we'd run past its end.
+        if (clip.Right > clip.Left && clip.Bottom > clip.Top)
         {
-            // If the point we're trying to write is inside the limited buffer write zone...
-            if (targetLimit.IsInBounds(targetPos))
+            const auto clippedWidth = gsl::narrow_cast<size_t>(clip.Right - clip.Left);
+            for (SHORT row = 0; row < clip.Bottom - clip.Top; row++)
             {
-                // Copy the data into position...
-                *targetIter = gci.AsCharInfo(*sourceIter);
-                // ... and advance the read iterator.
-                sourceIter++;
-            }
-
-            // Always advance the write iterator, we might have skipped it due to clipping.
-            targetIter++;
+                const size_t targetOffset = static_cast<size_t>(targetPoint.Y + row) * targetSize.X + targetPoint.X;
+                if (targetOffset >= targetBuffer.size())
+                {
+                    break;
+                }
 
-            // Increment the target
-            targetPos.X++;
-            if (targetPos.X >= targetSize.X)
-            {
-                targetPos.X = 0;
-                targetPos.Y++;
+                const auto targetCount = std::min(clippedWidth, targetBuffer.size() - targetOffset);
+                const COORD source{ sourcePoint.X, gsl::narrow_cast<SHORT>(sourcePoint.Y + row) };
+                textBuffer.ReadCharInfoLine(targetBuffer.subspan(targetOffset, targetCount), source);
             }
         }
 
@@ -1009,9 +993,14 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
             // Convert to a CHAR_INFO view to fit into the iterator
             const auto charInfos = gsl::span<const CHAR_INFO>(subspan.data(), subspan.size());
 
-            // Make the iterator and write to the target position.
-            OutputCellIterator it(charInfos);
-            storageBuffer.Write(it, target);
+            // Most rows are plain single-width text, which the text buffer can take as a whole.
+            // Only rows containing DBCS or surrogate cells need to go through the iterator.
+            if (!storageBuffer.GetTextBuffer().WriteCharInfoLine(charInfos, target))
+            {
+                // Make the iterator and write to the target position.
+                OutputCellIterator it(charInfos);
+                storageBuffer.Write(it, target);
+            }
         }
 
         // Since we've managed to write part of the request, return the clamped part that we actually used.
@@ -27,6 +27,8 @@ class BufferTests
     TEST_METHOD(ScrollLargeBufferPerformance);
 
     TEST_METHOD(ChafaGifPerformance);
+
+    TEST_METHOD(FullScreenBlitPerformance);
 };
 
 void BufferTests::TestSetConsoleActiveScreenBufferInvalid()
@@ -257,3 +259,60 @@ void BufferTests::ChafaGifPerformance()
     const auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count();
     Log::Comment(String().Format(L"%d calls took %d ms. Avg %d ms per call", count, delta, delta / count));
 }
+
+void BufferTests::FullScreenBlitPerformance()
+{
+    // Legacy full screen apps (Far Manager, curses ports, ...) redraw by
+    // reading and writing the entire viewport as a CHAR_INFO rectangle every frame.
+
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    const auto Out = GetStdHandle(STD_OUTPUT_HANDLE);
+
+    CONSOLE_SCREEN_BUFFER_INFO Info;
+    GetConsoleScreenBufferInfo(Out, &Info);
+
+    // We need a buffer of at least 200x60
+    constexpr SHORT Width = 200;
+    constexpr SHORT Height = 60;
+    Info.dwSize.X = std::max(Info.dwSize.X, Width);
+    Info.dwSize.Y = std::max(Info.dwSize.Y, Height);
+    SetConsoleScreenBufferSize(Out, Info.dwSize);
+
+    // Alternate between two frames with differently colored runs, so that every blit actually changes the buffer.
+    std::vector<CHAR_INFO> frames[2];
+    for (auto& frame : frames)
+    {
+        frame.resize(Width * Height);
+    }
+    for (size_t i = 0; i < frames[0].size(); ++i)
+    {
+        const auto ch = static_cast<wchar_t>(L'A' + i % 26);
+        frames[0][i] = CHAR_INFO{ ch, static_cast<WORD>((i / 40) % 2 ? FOREGROUND_GREEN : FOREGROUND_RED | BACKGROUND_BLUE) };
+        frames[1][i] = CHAR_INFO{ ch, static_cast<WORD>((i / 40) % 2 ? FOREGROUND_BLUE : FOREGROUND_GREEN | BACKGROUND_RED) };
+    }
+    std::vector<CHAR_INFO> readBack(Width * Height);
+
+    Log::Comment(L"Working. Please wait...");
+
+    const auto count = 1000;
+    const COORD size{ Width, Height };
+
+    const auto now = std::chrono::steady_clock::now();
+
+    for (int i = 0; i != count; ++i)
+    {
+        SMALL_RECT region{ 0, 0, Width - 1, Height - 1 };
+        WriteConsoleOutputW(Out, frames[i % 2].data(), size, { 0, 0 }, &region);
+
+        region = { 0, 0, Width - 1, Height - 1 };
+        ReadConsoleOutputW(Out, readBack.data(), size, { 0, 0 }, &region);
+    }
+
+    const auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count();
+    Log::Comment(String().Format(L"%d write+read blits of %dx%d took %d ms. Avg %d us per blit", count, Width, Height, delta, delta * 1000 / count));
+
+    VERIFY_ARE_EQUAL(frames[(count - 1) % 2][Width * Height - 1], readBack[Width * Height - 1]);
+}
@@ -77,6 +77,25 @@ static bool CaseInsensitiveEquality(wchar_t a, wchar_t b)
     return ::towlower(a) == ::towlower(b);
 }
 
+// Routine Description:
+// - Lowercases the given character the same way CaseInsensitiveEquality compares it,
+//   so that case-insensitive matches become plain comparisons on the result.
+static wchar_t FoldCase(const wchar_t wch) noexcept
+{
+    return gsl::narrow_cast<wchar_t>(::towlower(wch));
+}
+
+// Routine Description:
+// - Returns a copy of the given text with every character folded by FoldCase.
+static std::wstring FoldCase(const std::wstring_view text)
+{
+    std::wstring folded{ text };
+    std::transform(folded.begin(), folded.end(), folded.begin(), [](const wchar_t wch) noexcept {
+        return FoldCase(wch);
+    });
+    return folded;
+}
+
 bool CommandHistory::IsAppNameMatch(const std::wstring_view other) const
 {
     return std::equal(_appName.cbegin(), _appName.cend(), other.cbegin(), other.cend(), CaseInsensitiveEquality);
@@ -124,7 +143,9 @@ void CommandHistory::_Reset()
             // find free record.  if all records are used, free the lru one.
             if ((SHORT)_commands.size() == _maxCommands)
             {
-                _commands.erase(_commands.cbegin());
+                _IndexErase(0);
+                _commands.pop_front();
+                _ids.pop_front();
                 // move LastDisplayed back one in order to stay synced with the
                 // command it referred to before erasing the lru one
                 --LastDisplayed;
@@ -139,6 +160,8 @@ void CommandHistory::_Reset()
             {
                 _commands.emplace_back(newCommand);
             }
+            _ids.emplace_back(_nextId++);
+            _IndexInsert(_commands.size() - 1);
 
             if (LastDisplayed == -1 ||
                 _commands.at(LastDisplayed).size() != newCommand.size() ||
@@ -249,6 +272,8 @@ std::wstring_view CommandHistory::GetLastCommand() const
 void CommandHistory::Empty()
 {
     _commands.clear();
+    _ids.clear();
+    _index = {};
     LastDisplayed = -1;
     WI_SetFlag(Flags, CLE_RESET);
 }
@@ -282,14 +307,11 @@ void CommandHistory::Realloc(const size_t commands)
         return;
     }
 
-    const auto oldCommands = _commands;
     const auto newNumberOfCommands = gsl::narrow<SHORT>(std::min(_commands.size(), commands));
 
-    _commands.clear();
-    for (SHORT i = 0; i < newNumberOfCommands; i++)
-    {
-        _commands.emplace_back(oldCommands[i]);
-    }
+    _commands.resize(newNumberOfCommands);
+    _ids.resize(newNumberOfCommands);
+    _RebuildIndex();
 
     WI_SetFlag(Flags, CLE_RESET);
     LastDisplayed = gsl::narrow<SHORT>(_commands.size()) - 1;
@@ -392,6 +414,8 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
         if (!SameApp)
         {
             BestCandidate->_commands.clear();
+            BestCandidate->_ids.clear();
+            BestCandidate->_index = {};
             BestCandidate->LastDisplayed = -1;
             BestCandidate->_appName = appName;
         }
@@ -472,6 +496,9 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
     {
         const auto str = _commands.at(iDel);
 
+        _IndexErase(iDel);
+        _ids.erase(_ids.cbegin() + iDel);
+
         if (iDel < iLast)
         {
             _commands.erase(_commands.cbegin() + iDel);
@@ -529,29 +556,89 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
 
     try
     {
-        for (size_t i = 0; i < _commands.size(); i++)
+        // The matching commands are the range of the index that starts at the
+        // given text and ends at the first command that doesn't match it.
+        const auto folded = FoldCase(givenCommand);
+        const auto exact = WI_IsFlagSet(options, MatchOptions::ExactMatch);
+        const auto first = std::lower_bound(_index.cbegin(), _index.cend(), folded, [](const auto& entry, const std::wstring& text) {
+            return entry.first < text;
+        });
+        const auto last = std::partition_point(first, _index.cend(), [&](const auto& entry) {
+            return exact ? entry.first == folded : entry.first.compare(0, folded.size(), folded) == 0;
+        });
+        if (first == last)
+        {
+            return false;
+        }
+
+        // We're looking for the first match when walking backwards from indexFound and
+        // wrapping around at the start. Since ids increase with the position, that's the
+        // match with the largest id at or below the starting one, or failing that, the
+        // match with the largest id overall.
+        const auto startingId = _ids.at(indexFound);
+        std::optional<uint64_t> before;
+        uint64_t latest = 0;
+        for (auto it = first; it != last; ++it)
         {
-            const auto& storedCommand = _commands.at(indexFound);
-            if ((WI_IsFlagClear(options, MatchOptions::ExactMatch) && (givenCommand.size() <= storedCommand.size())) || (givenCommand.size() == storedCommand.size()))
+            const auto id = it->second;
+            if (id <= startingId && (!before || id > *before))
             {
-                if (std::equal(storedCommand.begin(),
-                               storedCommand.begin() + givenCommand.size(),
-                               givenCommand.begin(),
-                               givenCommand.end(),
-                               CaseInsensitiveEquality))
-                {
-                    return true;
-                }
+                before = id;
             }
-
-            _Prev(indexFound);
+            latest = std::max(latest, id);
         }
+
+        indexFound = _PositionOf(before.value_or(latest));
+        return true;
     }
     CATCH_LOG();
 
     return false;
 }
 
+// Routine Description:
+// - Adds the command in the given slot to the search index.
+void CommandHistory::_IndexInsert(const size_t position)
+{
+    auto entry = std::make_pair(FoldCase(_commands.at(position)), _ids.at(position));
+    _index.insert(std::upper_bound(_index.begin(), _index.end(), entry), std::move(entry));
+}
+
+// Routine Description:
+// - Removes the command in the given slot from the search index.
+void CommandHistory::_IndexErase(const size_t position)
+{
+    const auto entry = std::make_pair(FoldCase(_commands.at(position)), _ids.at(position));
+    const auto it = std::lower_bound(_index.begin(), _index.end(), entry);
+    if (it != _index.end() && *it == entry)
+    {
+        _index.erase(it);
+    }
+}
+
+// Routine Description:
+// - Renumbers all slots and recreates the search index from scratch.
+void CommandHistory::_RebuildIndex()
+{
+    _index.clear();
+    _index.reserve(_commands.size());
+    for (size_t i = 0; i < _commands.size(); ++i)
+    {
+        _ids.at(i) = _nextId++;
+        _index.emplace_back(FoldCase(_commands.at(i)), _ids.at(i));
+    }
+    std::sort(_index.begin(), _index.end());
+}
+
+// Routine Description:
+// - Finds the slot with the given id. As the ids are sorted, this is a binary search.
+SHORT CommandHistory::_PositionOf(const uint64_t id) const
+{
+    const auto it = std::lower_bound(_ids.cbegin(), _ids.cend(), id);
+    FAIL_FAST_IF(it == _ids.cend() || *it != id);
+    return gsl::narrow<SHORT>(it - _ids.cbegin());
+}
+
 #ifdef UNIT_TESTING
 void CommandHistory::s_ClearHistoryListStorage()
 {
@@ -566,7 +653,12 @@ void CommandHistory::s_ClearHistoryListStorage()
 // - indexB - index of one history item to swap
 void CommandHistory::Swap(const short indexA, const short indexB)
 {
+    // The ids stay with their slots, so the index has to follow the commands.
+    _IndexErase(indexA);
+    _IndexErase(indexB);
     std::swap(_commands.at(indexA), _commands.at(indexB));
+    _IndexInsert(indexA);
+    _IndexInsert(indexB);
 }
 
 // Routine Description:
@@ -83,7 +83,23 @@ private:
     void _Dec(SHORT& ind) const;
     void _Inc(SHORT& ind) const;
 
-    std::vector<std::wstring> _commands;
+    void _IndexInsert(const size_t position);
+    void _IndexErase(const size_t position);
+    void _RebuildIndex();
+    SHORT _PositionOf(const uint64_t id) const;
+
+    // The commands, oldest first. _ids holds a strictly increasing sequence
+    // number for each slot, which _index uses to refer to the slots without
+    // having to be updated every time the commands shift around.
+    std::deque<std::wstring> _commands;
+    std::deque<uint64_t> _ids;
+    uint64_t _nextId{ 0 };
+
+    // The search index: the case-folded command of every slot along with the
+    // slot's id, sorted by both. The commands that start with some text are
+    // a contiguous range of it, so FindMatchingCommand finds them with a
+    // binary search instead of comparing against every command.
+    std::vector<std::pair<std::wstring, uint64_t>> _index;
     SHORT _maxCommands;
 
     std::wstring _appName;
@@ -59,7 +59,8 @@ SCREEN_INFORMATION::SCREEN_INFORMATION(
     _renderTarget{ *this },
     _currentFont{ fontInfo },
     _desiredFont{ fontInfo },
-    _ignoreLegacyEquivalentVTAttributes{ false }
+    _ignoreLegacyEquivalentVTAttributes{ false },
+    _writeConversionBuffer{}
 {
     // Check if VT mode is enabled. Note that this can be true w/o calling
     // SetConsoleMode, if VirtualTerminalLevel is set to !=0 in the registry.
@@ -2705,3 +2706,24 @@ void SCREEN_INFORMATION::ResetIgnoreLegacyEquivalentVTAttributes() noexcept
 {
     _ignoreLegacyEquivalentVTAttributes = false;
 }
+
+// Routine Description:
+// - Gets the reusable buffer that narrow text is converted into before it's written.
+//   Its contents are only meaningful for the duration of a single write call.
+// Return Value:
+// - a reference to the conversion buffer
+std::wstring& SCREEN_INFORMATION::GetWriteConversionBuffer() noexcept
+{
+    return _writeConversionBuffer;
+}
+
+// Routine Description:
+// - Releases the conversion buffer's storage if a large write grew it beyond
+//   WriteConversionBufferMaxCapacity. Smaller buffers are kept for reuse.
+void SCREEN_INFORMATION::TrimWriteConversionBuffer() noexcept
+{
+    if (_writeConversionBuffer.capacity() > WriteConversionBufferMaxCapacity)
+    {
+        std::wstring{}.swap(_writeConversionBuffer);
+    }
+}
@@ -240,6 +240,14 @@ public:
     void SetIgnoreLegacyEquivalentVTAttributes() noexcept;
     void ResetIgnoreLegacyEquivalentVTAttributes() noexcept;
 
+    std::wstring& GetWriteConversionBuffer() noexcept;
+    void TrimWriteConversionBuffer() noexcept;
+
+    // The largest capacity (in characters) the conversion buffer is allowed to keep
+    // after a write. Anything bigger is released instead of being pinned for the
+    // lifetime of the screen buffer by a single large write.
+    static constexpr size_t WriteConversionBufferMaxCapacity{ 64 * 1024 / sizeof(wchar_t) };
+
 private:
     SCREEN_INFORMATION(_In_ Microsoft::Console::Interactivity::IWindowMetrics* pMetrics,
                        _In_ Microsoft::Console::Interactivity::IAccessibilityNotifier* pNotifier,
@@ -304,6 +312,10 @@ private:
 
     bool _ignoreLegacyEquivalentVTAttributes;
 
+    // Scratch space for WriteConsoleA to convert into. It keeps its capacity
+    // between calls, so steady-state writes don't allocate a new string each time.
+    std::wstring _writeConversionBuffer;
+
 #ifdef UNIT_TESTING
     friend class TextBufferIteratorTests;
     friend class ScreenBufferTests;
@@ -426,6 +426,34 @@ class ApiRoutinesTests
         }
     }
 
+    TEST_METHOD(ApiWriteConsoleAReleasesLargeConversionBuffer)
+    {
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer();
+
+        gci.LockConsole();
+        auto Unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+        gci.OutputCP = CP_USA;
+        SetConsoleCPInfo(TRUE);
+
+        auto& conversionBuffer = si.GetMainBuffer().GetWriteConversionBuffer();
+
+        Log::Comment(L"A small write keeps the conversion buffer around for reuse.");
+        const std::string smallText(16, 'a');
+        size_t cchRead = 0;
+        std::unique_ptr<IWaitRoutine> waiter;
+        VERIFY_ARE_EQUAL(S_OK, _pApiRoutines->WriteConsoleAImpl(si, smallText, cchRead, false, waiter));
+        VERIFY_ARE_EQUAL(smallText.size(), cchRead);
+        VERIFY_IS_GREATER_THAN_OR_EQUAL(conversionBuffer.capacity(), smallText.size());
+
+        Log::Comment(L"A write larger than the cap must not pin its memory after it returns.");
+        const std::string largeText(SCREEN_INFORMATION::WriteConversionBufferMaxCapacity * 2, 'a');
+        VERIFY_ARE_EQUAL(S_OK, _pApiRoutines->WriteConsoleAImpl(si, largeText, cchRead, false, waiter));
+        VERIFY_ARE_EQUAL(largeText.size(), cchRead);
+        VERIFY_IS_LESS_THAN_OR_EQUAL(conversionBuffer.capacity(), SCREEN_INFORMATION::WriteConversionBufferMaxCapacity);
+    }
+
     TEST_METHOD(ApiWriteConsoleW)
     {
         BEGIN_TEST_METHOD_PROPERTIES()
@@ -117,6 +117,7 @@ class ConptyOutputTests
     TEST_METHOD(ConptyOutputTestCanary);
     TEST_METHOD(SimpleWriteOutputTest);
     TEST_METHOD(WriteTwoLinesUsesNewline);
+    TEST_METHOD(BatchedInvalidationsUseNewline);
     TEST_METHOD(WriteAFewSimpleLines);
     TEST_METHOD(InvalidateUntilOneBeforeEnd);
 
@@ -259,6 +260,35 @@ void ConptyOutputTests::WriteTwoLinesUsesNewline()
     VERIFY_SUCCEEDED(renderer.PaintFrame());
 }
 
+void ConptyOutputTests::BatchedInvalidationsUseNewline()
+{
+    Log::Comment(NoThrowString().Format(
+        L"Write two lines of output inside an invalidation batch. The merged "
+        L"invalidation should produce the same output as the individual ones."));
+
+    auto& g = ServiceLocator::LocateGlobals();
+    auto& renderer = *g.pRender;
+    auto& gci = g.getConsoleInformation();
+    auto& si = gci.GetActiveOutputBuffer();
+    auto& sm = si.GetStateMachine();
+
+    _flushFirstFrame();
+
+    renderer.BeginInvalidationBatch();
+    sm.ProcessString(L"AAA");
+    renderer.BeginInvalidationBatch();
+    sm.ProcessString(L"\x1b[2;1H");
+    sm.ProcessString(L"BBB");
+    renderer.EndInvalidationBatch();
+    renderer.EndInvalidationBatch();
+
+    expectedOutput.push_back("AAA");
+    expectedOutput.push_back("\r\n");
+    expectedOutput.push_back("BBB");
+
+    VERIFY_SUCCEEDED(renderer.PaintFrame());
+}
+
 void ConptyOutputTests::WriteAFewSimpleLines()
 {
     Log::Comment(NoThrowString().Format(
@@ -242,6 +242,62 @@ class HistoryTests
         VERIFY_ARE_EQUAL(2ul, history->GetNumberOfCommands());
     }
 
+    TEST_METHOD(FindMatchingCommandWalksBackwardsAndWraps)
+    {
+        auto history = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+
+        // Overflow the buffer so that the oldest entries have been evicted.
+        for (const auto& item : _manyHistoryItems)
+        {
+            VERIFY_SUCCEEDED(history->Add(item, false));
+        }
+        VERIFY_ARE_EQUAL(s_BufferSize, history->GetNumberOfCommands());
+
+        SHORT index;
+        Log::Comment(L"The most recent prefix match before the starting index is found, case-insensitively.");
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"IP", 5, index, CommandHistory::MatchOptions::JustLooking));
+        VERIFY_ARE_EQUAL(String(L"ipconfig /all"), String(history->GetNth(index).data()));
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"ip", index, index, CommandHistory::MatchOptions::JustLooking));
+        VERIFY_ARE_EQUAL(String(L"ipconfig"), String(history->GetNth(index).data()));
+
+        Log::Comment(L"Without a match before the starting index, the search wraps around to the newest one.");
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"no", 2, index, CommandHistory::MatchOptions::JustLooking));
+        VERIFY_ARE_EQUAL(String(L"notepad sources"), String(history->GetNth(index).data()));
+
+        Log::Comment(L"Evicted commands can't be found anymore.");
+        VERIFY_IS_FALSE(history->FindMatchingCommand(L"dir /w", 9, index, CommandHistory::MatchOptions::JustLooking));
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"dir /p", 9, index, CommandHistory::MatchOptions::JustLooking));
+        VERIFY_ARE_EQUAL(String(L"dir /p /w"), String(history->GetNth(index).data()));
+
+        Log::Comment(L"Exact matches don't accept prefixes.");
+        VERIFY_IS_FALSE(history->FindMatchingCommand(L"NOTEPAD", 9, index, CommandHistory::MatchOptions::ExactMatch | CommandHistory::MatchOptions::JustLooking));
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"CD ..", 9, index, CommandHistory::MatchOptions::ExactMatch | CommandHistory::MatchOptions::JustLooking));
+        VERIFY_ARE_EQUAL(String(L"cd .."), String(history->GetNth(index).data()));
+    }
+
+    TEST_METHOD(FindMatchingCommandFollowsSwapAndRemove)
+    {
+        auto history = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+
+        VERIFY_SUCCEEDED(history->Add(L"dir", false));
+        VERIFY_SUCCEEDED(history->Add(L"cd ..", false));
+        VERIFY_SUCCEEDED(history->Add(L"ping", false));
+
+        SHORT index;
+        history->Swap(0, 2);
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"dir", 2, index, CommandHistory::MatchOptions::JustLooking));
+        VERIFY_ARE_EQUAL(2, index);
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"ping", 2, index, CommandHistory::MatchOptions::JustLooking));
+        VERIFY_ARE_EQUAL(0, index);
+
+        VERIFY_ARE_EQUAL(String(L"cd .."), String(history->Remove(1).c_str()));
+        VERIFY_IS_FALSE(history->FindMatchingCommand(L"cd", 1, index, CommandHistory::MatchOptions::JustLooking));
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"dir", 1, index, CommandHistory::MatchOptions::JustLooking));
+        VERIFY_ARE_EQUAL(1, index);
+    }
+
 private:
     const std::array<std::wstring, 5> _manyApps = {
         L"foo.exe",
@@ -8,9 +8,36 @@
 
 #include "../../host/renderData.hpp"
 #include "../../renderer/base/renderer.hpp"
+#include "../../renderer/inc/BlinkingState.hpp"
 
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
+using namespace Microsoft::Console::Types;
+
+namespace
+{
+    // Records the invalidations requested of it, so tests can check what
+    // would have been repainted.
+    class RecordingRenderTarget final : public Microsoft::Console::Render::IRenderTarget
+    {
+    public:
+        void TriggerRedraw(const Viewport& region) override { regions.push_back(region); }
+        void TriggerRedraw(const COORD* const /*pcoord*/) override {}
+        void TriggerRedrawCursor(const COORD* const /*pcoord*/) override {}
+        void TriggerRedrawAll() override { redrawAllCount++; }
+        void TriggerTeardown() noexcept override {}
+        void TriggerSelection() override {}
+        void TriggerScroll() override {}
+        void TriggerScroll(const COORD* const /*pcoordDelta*/) override {}
+        void TriggerCircling() override {}
+        void TriggerTitleChange() override {}
+        void BeginInvalidationBatch() override {}
+        void EndInvalidationBatch() override {}
+
+        std::vector<Viewport> regions;
+        size_t redrawAllCount = 0;
+    };
+}
 
 class RendererTests
 {
@@ -68,4 +95,44 @@ class RendererTests
     {
         m_renderer->TriggerTitleChange();
     }
+
+    TEST_METHOD(BlinkingInvalidatesOnlyBlinkingRuns)
+    {
+        Log::Comment(L"Toggling the blinking rendition should only invalidate the cells that are actually blinking.");
+
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        auto& si = gci.GetActiveOutputBuffer();
+        auto& textBuffer = si.GetTextBuffer();
+        const auto viewport = si.GetViewport();
+        const auto row = gsl::narrow<SHORT>(viewport.Top() + 2);
+
+        auto& attrRow = textBuffer.GetRowByOffset(row).GetAttrRow();
+        const auto originalAttr = attrRow.GetAttrByColumn(0);
+        auto blinkingAttr = originalAttr;
+        blinkingAttr.SetBlinking(true);
+        attrRow.Replace(3, 6, blinkingAttr);
+        auto restoreAttrs = wil::scope_exit([&]() { attrRow.Replace(3, 6, originalAttr); });
+
+        Microsoft::Console::Render::BlinkingState blinkingState;
+        RecordingRenderTarget renderTarget;
+
+        // The first paint records that blinking is in use. The rendition only
+        // changes every second tick, so nothing is invalidated on the first.
+        blinkingState.RecordBlinkingUsage(blinkingAttr);
+        blinkingState.ToggleBlinkingRendition(renderTarget, textBuffer, viewport);
+        VERIFY_ARE_EQUAL(0u, renderTarget.regions.size());
+
+        blinkingState.ToggleBlinkingRendition(renderTarget, textBuffer, viewport);
+        VERIFY_IS_TRUE(blinkingState.IsBlinkingFaint());
+        VERIFY_ARE_EQUAL(0u, renderTarget.redrawAllCount);
+        VERIFY_ARE_EQUAL(1u, renderTarget.regions.size());
+        const auto expected = Viewport::FromExclusive({ 3, row, 6, gsl::narrow<SHORT>(row + 1) });
+        VERIFY_ARE_EQUAL(expected.ToExclusive(), renderTarget.regions[0].ToExclusive());
+
+        Log::Comment(L"Without any blinking cells painted since, the next change shouldn't invalidate anything.");
+        renderTarget.regions.clear();
+        blinkingState.ToggleBlinkingRendition(renderTarget, textBuffer, viewport);
+        blinkingState.ToggleBlinkingRendition(renderTarget, textBuffer, viewport);
+        VERIFY_ARE_EQUAL(0u, renderTarget.regions.size());
+    }
 };
@@ -149,13 +149,21 @@ class TextBufferTests
     void WriteLinesToBuffer(const std::vector<std::wstring>& text, TextBuffer& buffer);
     TEST_METHOD(GetWordBoundaries);
     TEST_METHOD(MoveByWord);
+    TEST_METHOD(WordBoundariesFollowBufferChanges);
     TEST_METHOD(GetGlyphBoundaries);
 
     TEST_METHOD(GetTextRects);
     TEST_METHOD(GetText);
+    TEST_METHOD(GetTextRuns);
+    TEST_METHOD(RowTextViewFollowsWrites);
+    TEST_METHOD(GetPlainText);
+    TEST_METHOD(SerializeSelection);
+    TEST_METHOD(SerializeSelectionFixedOutput);
 
     TEST_METHOD(HyperlinkTrim);
     TEST_METHOD(NoHyperlinkTrim);
+
+    TEST_METHOD(WriteAndReadCharInfoLine);
 };
 
 void TextBufferTests::TestBufferCreate()
@@ -2214,6 +2222,49 @@ void TextBufferTests::MoveByWord()
     }
 }
 
+void TextBufferTests::WordBoundariesFollowBufferChanges()
+{
+    COORD bufferSize{ 80, 9001 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    // Setup: Write lines of text to the buffer
+    const std::vector<std::wstring> text = { L"word other",
+                                             L"  more   words" };
+    WriteLinesToBuffer(text, *_buffer);
+
+    Log::Comment(L"Rows cache their delimiter classes. Populate the cache of the second row.");
+    VERIFY_ARE_EQUAL((COORD{ 6, 1 }), _buffer->GetWordStart({ 7, 1 }, L" "));
+    VERIFY_ARE_EQUAL((COORD{ 8, 1 }), _buffer->GetWordEnd({ 7, 1 }, L" "));
+
+    Log::Comment(L"Overwriting the delimiters between the words must invalidate that cache.");
+    OutputCellIterator iter{ L"xxx" };
+    _buffer->Write(iter, { 6, 1 });
+    VERIFY_ARE_EQUAL((COORD{ 2, 1 }), _buffer->GetWordStart({ 7, 1 }, L" "));
+    VERIFY_ARE_EQUAL((COORD{ 13, 1 }), _buffer->GetWordEnd({ 7, 1 }, L" "));
+
+    Log::Comment(L"Switching between sets of delimiters must not use stale classes.");
+    VERIFY_ARE_EQUAL((COORD{ 2, 1 }), _buffer->GetWordStart({ 10, 1 }, L" "));
+    VERIFY_ARE_EQUAL((COORD{ 9, 1 }), _buffer->GetWordStart({ 10, 1 }, L" x"));
+    VERIFY_ARE_EQUAL((COORD{ 2, 1 }), _buffer->GetWordStart({ 10, 1 }, L" "));
+
+    Log::Comment(L"Moving by word must skip over blank rows.");
+    iter = OutputCellIterator{ L"far" };
+    _buffer->Write(iter, { 3, 500 });
+    const COORD lastCharPos = _buffer->GetLastNonSpaceCharacter();
+    VERIFY_ARE_EQUAL((COORD{ 5, 500 }), lastCharPos);
+
+    COORD pos{ 9, 1 };
+    VERIFY_IS_TRUE(_buffer->MoveToNextWord(pos, L" ", lastCharPos));
+    VERIFY_ARE_EQUAL((COORD{ 3, 500 }), pos);
+    VERIFY_IS_FALSE(_buffer->MoveToNextWord(pos, L" ", lastCharPos));
+    VERIFY_ARE_EQUAL((COORD{ 3, 500 }), pos);
+
+    VERIFY_IS_TRUE(_buffer->MoveToPreviousWord(pos, L" "));
+    VERIFY_ARE_EQUAL((COORD{ 2, 1 }), pos);
+}
+
 void TextBufferTests::GetGlyphBoundaries()
 {
     struct ExpectedResult
@@ -2580,6 +2631,323 @@ void TextBufferTests::GetText()
     }
 }
 
+void TextBufferTests::GetTextRuns()
+{
+    // GetText() collects the colors of the text as runs, and should only
+    // need to look up the colors of each attribute run of a row once.
+
+    COORD bufferSize{ 10, 20 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    TextAttribute boldAttr{ 0x1e };
+    boldAttr.SetBold(true);
+    _buffer->Write(OutputCellIterator{ L"abc", TextAttribute{ 0x1e } }, { 0, 0 }, false);
+    _buffer->Write(OutputCellIterator{ L"def", TextAttribute{ 0x2c } }, { 3, 0 }, false);
+    _buffer->Write(OutputCellIterator{ L"gh", boldAttr }, { 0, 1 }, false);
+
+    size_t lookups = 0;
+    const auto GetAttributeColors = [&](const TextAttribute& attr) {
+        lookups++;
+        const auto legacy = attr.GetLegacyAttributes();
+        return std::pair<COLORREF, COLORREF>{ RGB(legacy & 0x0f, 0, 0), RGB(0, (legacy >> 4) & 0x0f, 0) };
+    };
+
+    const auto textRects = _buffer->GetTextRects({ 0, 0 }, { 9, 1 }, false, true);
+    const auto textData = _buffer->GetText(true, true, textRects, GetAttributeColors);
+
+    Log::Comment(L"One lookup per attribute run: 3 in the first row, 2 in the second.");
+    VERIFY_ARE_EQUAL(5u, lookups);
+
+    VERIFY_ARE_EQUAL(2u, textData.text.size());
+    VERIFY_ARE_EQUAL(2u, textData.runs.size());
+    VERIFY_ARE_EQUAL(L"abcdef\r\n", textData.text.at(0));
+    VERIFY_ARE_EQUAL(L"gh", textData.text.at(1));
+
+    Log::Comment(L"The trailing whitespace was trimmed from the runs, and the line break got a run of its own.");
+    const auto& firstRow = textData.runs.at(0);
+    VERIFY_ARE_EQUAL(3u, firstRow.size());
+    VERIFY_ARE_EQUAL(3u, firstRow.at(0).length);
+    VERIFY_ARE_EQUAL(RGB(0x0e, 0, 0), firstRow.at(0).foreground);
+    VERIFY_ARE_EQUAL(RGB(0, 0x01, 0), firstRow.at(0).background);
+    VERIFY_ARE_EQUAL(3u, firstRow.at(1).length);
+    VERIFY_ARE_EQUAL(RGB(0x0c, 0, 0), firstRow.at(1).foreground);
+    VERIFY_ARE_EQUAL(RGB(0, 0x02, 0), firstRow.at(1).background);
+    VERIFY_ARE_EQUAL(2u, firstRow.at(2).length);
+    VERIFY_ARE_EQUAL(RGB(0, 0, 0), firstRow.at(2).foreground);
+    VERIFY_ARE_EQUAL(RGB(0, 0, 0), firstRow.at(2).background);
+
+    Log::Comment(L"The extended attributes are part of the runs.");
+    const auto& secondRow = textData.runs.at(1);
+    VERIFY_ARE_EQUAL(1u, secondRow.size());
+    VERIFY_ARE_EQUAL(2u, secondRow.at(0).length);
+    VERIFY_ARE_EQUAL(RGB(0x0e, 0, 0), secondRow.at(0).foreground);
+    VERIFY_IS_TRUE(WI_IsFlagSet(secondRow.at(0).flags, ExtendedAttributes::Bold));
+}
+
+void TextBufferTests::RowTextViewFollowsWrites()
+{
+    COORD bufferSize{ 10, 5 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    _buffer->Write(OutputCellIterator{ L"ab\x30a2" L"cd" }, { 0, 0 }, false);
+
+    const auto& charRow = _buffer->GetRowByOffset(0).GetCharRow();
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"ab\x30a2" L"cd    " }, charRow.GetTextView());
+    VERIFY_ARE_EQUAL(std::wstring_view{ charRow.GetText() }, charRow.GetTextView());
+
+    Log::Comment(L"The trailing half of the wide glyph starts right after the glyph.");
+    VERIFY_ARE_EQUAL(2u, charRow.GetTextOffset(2));
+    VERIFY_ARE_EQUAL(3u, charRow.GetTextOffset(3));
+    VERIFY_ARE_EQUAL(3u, charRow.GetTextOffset(4));
+    VERIFY_ARE_EQUAL(9u, charRow.GetTextOffset(10));
+
+    Log::Comment(L"AppendText copies the same text out of the cache.");
+    std::wstring appended{ L">" };
+    charRow.AppendText(appended, 1, 4);
+    VERIFY_ARE_EQUAL(std::wstring_view{ L">b\x30a2" }, std::wstring_view{ appended });
+
+    Log::Comment(L"Writing to the row must invalidate the cached text.");
+    _buffer->Write(OutputCellIterator{ L"xy\xD83D\xDE00" }, { 5, 0 }, false);
+
+    Log::Comment(L"AppendText reads the cells when there's no cache.");
+    appended.clear();
+    charRow.AppendText(appended, 3, 8);
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"cxy\xD83D\xDE00" }, std::wstring_view{ appended });
+
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"ab\x30a2" L"cxy\xD83D\xDE00 " }, charRow.GetTextView());
+    VERIFY_ARE_EQUAL(6u, charRow.GetTextOffset(7));
+    VERIFY_ARE_EQUAL(8u, charRow.GetTextOffset(8));
+
+    Log::Comment(L"So must clearing it.");
+    _buffer->GetRowByOffset(0).Reset(attr);
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"          " }, charRow.GetTextView());
+}
+
+void TextBufferTests::GetPlainText()
+{
+    // GetPlainText() is used by UiaTextRange to stream the text of a range
+    // without going through GetTextRects and GetText. The two need to agree.
+
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"Data:blockSelection", L"{false, true}")
+    END_TEST_METHOD_PROPERTIES();
+
+    bool blockSelection;
+    VERIFY_SUCCEEDED(TestData::TryGetValue(L"blockSelection", blockSelection), L"Get 'blockSelection' variant");
+
+    COORD bufferSize{ 5, 20 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    // Setup: Write lines of text to the buffer, with the first and fourth
+    // rows wrapping onto the next one.
+    const std::vector<std::wstring> bufferText = { L"1234567",
+                                                   L"",
+                                                   L"  345",
+                                                   L"123    ",
+                                                   L"" };
+    WriteLinesToBuffer(bufferText, *_buffer);
+
+    const COORD start{ 1, 0 };
+    const COORD end{ 3, 5 };
+
+    std::wstring expectedText;
+    const auto textRects = _buffer->GetTextRects(start, end, blockSelection, true);
+    for (const auto& text : _buffer->GetText(true, false, textRects).text)
+    {
+        expectedText += text;
+    }
+
+    Log::Comment(L"Without a limit, the whole range should be returned.");
+    VERIFY_ARE_EQUAL(expectedText, _buffer->GetPlainText(start, end, blockSelection, true));
+
+    Log::Comment(L"The order of the endpoints shouldn't matter.");
+    VERIFY_ARE_EQUAL(expectedText, _buffer->GetPlainText(end, start, blockSelection, true));
+
+    Log::Comment(L"With a limit, the text should be truncated, even within a line break.");
+    for (size_t maxLength = 0; maxLength <= expectedText.size() + 1; maxLength++)
+    {
+        const auto expectedPrefix = expectedText.substr(0, maxLength);
+        VERIFY_ARE_EQUAL(expectedPrefix, _buffer->GetPlainText(start, end, blockSelection, true, maxLength));
+    }
+}
+
+void TextBufferTests::SerializeSelection()
+{
+    // SerializeSelection() is used to copy text to the clipboard in one pass.
+    // It needs to produce the same output as GetText, GenHTML and GenRTF.
+
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"Data:blockSelection", L"{false, true}")
+        TEST_METHOD_PROPERTY(L"Data:includeCRLF", L"{false, true}")
+        TEST_METHOD_PROPERTY(L"Data:trimTrailingWhitespace", L"{false, true}")
+    END_TEST_METHOD_PROPERTIES();
+
+    bool blockSelection;
+    bool includeCRLF;
+    bool trimTrailingWhitespace;
+    VERIFY_SUCCEEDED(TestData::TryGetValue(L"blockSelection", blockSelection), L"Get 'blockSelection' variant");
+    VERIFY_SUCCEEDED(TestData::TryGetValue(L"includeCRLF", includeCRLF), L"Get 'includeCRLF' variant");
+    VERIFY_SUCCEEDED(TestData::TryGetValue(L"trimTrailingWhitespace", trimTrailingWhitespace), L"Get 'trimTrailingWhitespace' variant");
+
+    COORD bufferSize{ 10, 20 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    // Setup: Write text in a few colors to the buffer, including characters
+    // that need escaping, non-ASCII characters and a wide glyph. The first
+    // row wraps onto the next one.
+    _buffer->Write(OutputCellIterator{ L"<a&b>{c}\\d\u00e9f", TextAttribute{ 0x1e } }, { 0, 0 });
+    _buffer->Write(OutputCellIterator{ L"  \u30a2 ", TextAttribute{ 0x2c } }, { 0, 2 });
+    _buffer->Write(OutputCellIterator{ L"x  ", TextAttribute{ 0x1e } }, { 5, 2 });
+    _buffer->Write(OutputCellIterator{ L"blue", TextAttribute{ 0x09 } }, { 2, 3 });
+
+    const auto GetAttributeColors = [](const TextAttribute& attr) {
+        const auto legacy = attr.GetLegacyAttributes();
+        return std::pair<COLORREF, COLORREF>{ RGB(legacy & 0x0f, 0, 0), RGB(0, (legacy >> 4) & 0x0f, 0) };
+    };
+    const auto fontHeightPoints = 12;
+    const std::wstring_view fontFaceName = L"Cascadia {Mono}";
+    const COLORREF backgroundColor = RGB(12, 34, 56);
+
+    const auto textRects = _buffer->GetTextRects({ 1, 0 }, { 7, 4 }, blockSelection, true);
+    const auto textData = _buffer->GetText(includeCRLF, trimTrailingWhitespace, textRects, GetAttributeColors);
+
+    std::wstring expectedText;
+    for (const auto& text : textData.text)
+    {
+        expectedText += text;
+    }
+    const auto expectedHTML = TextBuffer::GenHTML(textData, fontHeightPoints, fontFaceName, backgroundColor);
+    const auto expectedRTF = TextBuffer::GenRTF(textData, fontHeightPoints, fontFaceName, backgroundColor);
+
+    Log::Comment(L"All formats at once.");
+    const auto data = _buffer->SerializeSelection(includeCRLF,
+                                                  trimTrailingWhitespace,
+                                                  textRects,
+                                                  GetAttributeColors,
+                                                  false,
+                                                  true,
+                                                  true,
+                                                  fontHeightPoints,
+                                                  fontFaceName,
+                                                  backgroundColor);
+    VERIFY_ARE_EQUAL(expectedText, data.text);
+    VERIFY_ARE_EQUAL(std::string_view{ expectedHTML }, std::string_view{ data.html });
+    VERIFY_ARE_EQUAL(std::string_view{ expectedRTF }, std::string_view{ data.rtf });
+
+    Log::Comment(L"Only the formats that were asked for.");
+    const auto htmlOnly = _buffer->SerializeSelection(includeCRLF,
+                                                      trimTrailingWhitespace,
+                                                      textRects,
+                                                      GetAttributeColors,
+                                                      false,
+                                                      true,
+                                                      false,
+                                                      fontHeightPoints,
+                                                      fontFaceName,
+                                                      backgroundColor);
+    VERIFY_ARE_EQUAL(expectedText, htmlOnly.text);
+    VERIFY_ARE_EQUAL(std::string_view{ expectedHTML }, std::string_view{ htmlOnly.html });
+    VERIFY_IS_TRUE(htmlOnly.rtf.empty());
+
+    Log::Comment(L"Without a color mapping, only text can be generated.");
+    const auto textOnly = _buffer->SerializeSelection(includeCRLF,
+                                                      trimTrailingWhitespace,
+                                                      textRects,
+                                                      nullptr,
+                                                      false,
+                                                      true,
+                                                      true,
+                                                      fontHeightPoints,
+                                                      fontFaceName,
+                                                      backgroundColor);
+    VERIFY_ARE_EQUAL(expectedText, textOnly.text);
+    VERIFY_IS_TRUE(textOnly.html.empty());
+    VERIFY_IS_TRUE(textOnly.rtf.empty());
+}
+
+void TextBufferTests::SerializeSelectionFixedOutput()
+{
+    // SerializeSelection() compares against GenHTML and GenRTF above, which
+    // share its writers. This pins all of them to the exact documents the
+    // original GenHTML and GenRTF produced for the same selection: the
+    // CF_HTML offsets, a span (or RTF color pair) for every color change,
+    // the RTF color table and the escaping.
+
+    COORD bufferSize{ 8, 20 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    // Setup: Two rows in three colors, with characters that need escaping,
+    // a non-ASCII character and trailing whitespace (the rest of each row).
+    _buffer->Write(OutputCellIterator{ L"a<\u00e9", TextAttribute{ 0x1e } }, { 0, 0 });
+    _buffer->Write(OutputCellIterator{ L"{x}", TextAttribute{ 0x2c } }, { 3, 0 });
+    _buffer->Write(OutputCellIterator{ L"\\b&", TextAttribute{ 0x09 } }, { 0, 1 });
+
+    const auto GetAttributeColors = [](const TextAttribute& attr) {
+        const auto legacy = attr.GetLegacyAttributes();
+        return std::pair<COLORREF, COLORREF>{ RGB(legacy & 0x0f, 0, 0), RGB(0, (legacy >> 4) & 0x0f, 0) };
+    };
+    const auto fontHeightPoints = 12;
+    const std::wstring_view fontFaceName = L"Consolas";
+    const COLORREF backgroundColor = RGB(12, 34, 56);
+
+    const std::wstring_view expectedText{ L"a<\u00e9{x}\r\n\\b&" };
+    const std::string_view expectedHTML{
+        "Version:0.9\r\n"
+        "StartHTML:0000000157\r\n"
+        "EndHTML:0000000592\r\n"
+        "StartFragment:0000000192\r\n"
+        "EndFragment:0000000578\r\n"
+        "StartSelection:0000000192\r\n"
+        "EndSelection:0000000578\r\n"
+        "<!DOCTYPE><HTML><HEAD></HEAD><BODY><!--StartFragment -->"
+        "<DIV STYLE=\"display:inline-block;white-space:pre;background-color:#0C2238;font-family:'Consolas',monospace;font-size:12pt;padding:4px;\">"
+        "<SPAN STYLE=\"color:#0E0000;background-color:#000100;\">a&lt;\xc3\xa9</SPAN>"
+        "<SPAN STYLE=\"color:#0C0000;background-color:#000200;\">{x}<BR></SPAN>"
+        "<SPAN STYLE=\"color:#090000;background-color:#000000;\">\\b&amp;</SPAN>"
+        "</DIV><!--EndFragment --></BODY></HTML>"
+    };
+    const std::string_view expectedRTF{
+        "{\\rtf1\\ansi\\ansicpg1252\\deff0\\nouicompat"
+        "{\\fonttbl{\\f0\\fmodern\\fcharset0 Consolas;}}"
+        "{\\colortbl ;\\red12\\green34\\blue56;\\red0\\green1\\blue0;\\red14\\green0\\blue0;\\red0\\green2\\blue0;\\red12\\green0\\blue0;\\red0\\green0\\blue0;\\red9\\green0\\blue0;}"
+        "\\viewkind4\\uc4\\pard\\slmult1\\f0\\fs24\\highlight1 "
+        "\\highlight2\\cf3 a<\xc3\xa9"
+        "\\highlight4\\cf5 \\{x\\}"
+        "\\line \\highlight6\\cf7 \\\\b&"
+        "}"
+    };
+
+    const auto textRects = _buffer->GetTextRects({ 0, 0 }, { 7, 1 }, false, true);
+
+    const auto data = _buffer->SerializeSelection(true,
+                                                  true,
+                                                  textRects,
+                                                  GetAttributeColors,
+                                                  false,
+                                                  true,
+                                                  true,
+                                                  fontHeightPoints,
+                                                  fontFaceName,
+                                                  backgroundColor);
+    VERIFY_ARE_EQUAL(expectedText, std::wstring_view{ data.text });
+    VERIFY_ARE_EQUAL(expectedHTML, std::string_view{ data.html });
+    VERIFY_ARE_EQUAL(expectedRTF, std::string_view{ data.rtf });
+
+    const auto textData = _buffer->GetText(true, true, textRects, GetAttributeColors);
+    VERIFY_ARE_EQUAL(expectedHTML, std::string_view{ TextBuffer::GenHTML(textData, fontHeightPoints, fontFaceName, backgroundColor) });
+    VERIFY_ARE_EQUAL(expectedRTF, std::string_view{ TextBuffer::GenRTF(textData, fontHeightPoints, fontFaceName, backgroundColor) });
+}
+
 // This tests that when we increment the circular buffer, obsolete hyperlink references
 // are removed from the hyperlink map
 void TextBufferTests::HyperlinkTrim()
@@ -2660,3 +3028,60 @@ void TextBufferTests::NoHyperlinkTrim()
     VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(id), url);
     VERIFY_ARE_EQUAL(_buffer->_hyperlinkCustomIdMap[finalCustomId], id);
 }
+
+void TextBufferTests::WriteAndReadCharInfoLine()
+{
+    const COORD bufferSize{ 20, 3 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    constexpr WORD red = FOREGROUND_RED;
+    constexpr WORD blue = FOREGROUND_BLUE | BACKGROUND_GREEN;
+    const std::vector<CHAR_INFO> plain{
+        { L'a', red },
+        { L'b', red },
+        { L'c', blue },
+        { L'd', red },
+    };
+
+    Log::Comment(L"Plain single-width text is written directly.");
+    VERIFY_IS_TRUE(_buffer->WriteCharInfoLine(plain, { 3, 1 }));
+
+    const auto& row = _buffer->GetRowByOffset(1);
+    VERIFY_ARE_EQUAL(L"   abcd", row.GetText().substr(0, 7));
+    VERIFY_ARE_EQUAL(attr, row.GetAttrRow().GetAttrByColumn(2));
+    VERIFY_ARE_EQUAL(TextAttribute{ red }, row.GetAttrRow().GetAttrByColumn(4));
+    VERIFY_ARE_EQUAL(TextAttribute{ blue }, row.GetAttrRow().GetAttrByColumn(5));
+    VERIFY_ARE_EQUAL(TextAttribute{ red }, row.GetAttrRow().GetAttrByColumn(6));
+    VERIFY_ARE_EQUAL(attr, row.GetAttrRow().GetAttrByColumn(7));
+
+    Log::Comment(L"Reading it back must yield the same cells.");
+    std::vector<CHAR_INFO> readBack(plain.size());
+    _buffer->ReadCharInfoLine(readBack, { 3, 1 });
+    for (size_t i = 0; i < plain.size(); ++i)
+    {
+        VERIFY_ARE_EQUAL(plain[i], readBack[i]);
+    }
+
+    Log::Comment(L"Rows with DBCS or surrogate cells are left to the iterator based path.");
+    const std::vector<CHAR_INFO> dbcs{
+        { L'\x3042', static_cast<WORD>(red | COMMON_LVB_LEADING_BYTE) },
+        { L'\x3042', static_cast<WORD>(red | COMMON_LVB_TRAILING_BYTE) },
+    };
+    VERIFY_IS_FALSE(_buffer->WriteCharInfoLine(dbcs, { 0, 2 }));
+    const std::vector<CHAR_INFO> surrogate{
+        { L'\xD83D', red },
+        { L'\xDE00', red },
+    };
+    VERIFY_IS_FALSE(_buffer->WriteCharInfoLine(surrogate, { 0, 2 }));
+    VERIFY_ARE_EQUAL(L' ', _buffer->GetRowByOffset(2).GetText().front());
+
+    Log::Comment(L"Lead/trailing byte flags are reported on read.");
+    OutputCellIterator it{ gsl::span<const CHAR_INFO>{ dbcs } };
+    _buffer->WriteLine(it, { 0, 2 });
+    _buffer->ReadCharInfoLine(readBack, { 0, 2 });
+    VERIFY_ARE_EQUAL(dbcs[0], readBack[0]);
+    VERIFY_ARE_EQUAL(dbcs[1], readBack[1]);
+}
+
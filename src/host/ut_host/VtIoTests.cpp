@@ -9,6 +9,7 @@
 #include "../../renderer/vt/Xterm256Engine.hpp"
 #include "../../renderer/vt/XtermEngine.hpp"
 #include "../../renderer/base/Renderer.hpp"
+#include "../../renderer/base/PooledRenderThread.hpp"
 #include "../Settings.hpp"
 #include "../VtIo.hpp"
 
@@ -38,6 +39,12 @@ class Microsoft::Console::VirtualTerminal::VtIoTests
 
     TEST_METHOD(RendererDtorAndThread);
 
+    TEST_METHOD(RendererDtorAndPooledThread);
+
+    BEGIN_TEST_METHOD(RendererThreadFrameLatency)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD()
+
 #ifndef __INSIDE_WINDOWS
     TEST_METHOD(RendererDtorAndThreadAndDx);
 #endif
@@ -408,6 +415,54 @@ public:
     }
 };
 
+// Forwards everything to a Renderer, but counts the frames the render thread
+// asks for, so that tests can tell when the thread has stopped painting.
+// Unlike the Renderer and its thread, it can outlive both of them.
+class PaintCountingRenderer final : public IRenderer
+{
+public:
+    PaintCountingRenderer(IRenderer* renderer) noexcept :
+        _renderer{ renderer }
+    {
+    }
+
+    size_t GetPaintCount() const noexcept
+    {
+        return _paintCount.load();
+    }
+
+    [[nodiscard]] HRESULT PaintFrame() override
+    {
+        ++_paintCount;
+        return _renderer->PaintFrame();
+    }
+
+    void TriggerSystemRedraw(const RECT* const prcDirtyClient) override { _renderer->TriggerSystemRedraw(prcDirtyClient); }
+    void TriggerRedraw(const Viewport& region) override { _renderer->TriggerRedraw(region); }
+    void TriggerRedraw(const COORD* const pcoord) override { _renderer->TriggerRedraw(pcoord); }
+    void TriggerRedrawCursor(const COORD* const pcoord) override { _renderer->TriggerRedrawCursor(pcoord); }
+    void TriggerRedrawAll() override { _renderer->TriggerRedrawAll(); }
+    void TriggerTeardown() noexcept override { _renderer->TriggerTeardown(); }
+    void TriggerSelection() override { _renderer->TriggerSelection(); }
+    void TriggerScroll() override { _renderer->TriggerScroll(); }
+    void TriggerScroll(const COORD* const pcoordDelta) override { _renderer->TriggerScroll(pcoordDelta); }
+    void TriggerCircling() override { _renderer->TriggerCircling(); }
+    void TriggerTitleChange() override { _renderer->TriggerTitleChange(); }
+    void TriggerFontChange(const int iDpi, const FontInfoDesired& fontInfoDesired, _Out_ FontInfo& fontInfo) override { _renderer->TriggerFontChange(iDpi, fontInfoDesired, fontInfo); }
+    [[nodiscard]] HRESULT GetProposedFont(const int iDpi, const FontInfoDesired& fontInfoDesired, _Out_ FontInfo& fontInfo) override { return _renderer->GetProposedFont(iDpi, fontInfoDesired, fontInfo); }
+    bool IsGlyphWideByFont(const std::wstring_view glyph) override { return _renderer->IsGlyphWideByFont(glyph); }
+    void EnablePainting() override { _renderer->EnablePainting(); }
+    void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) override { _renderer->WaitForPaintCompletionAndDisable(dwTimeoutMs); }
+    void WaitUntilCanRender() override { _renderer->WaitUntilCanRender(); }
+    void AddRenderEngine(_In_ IRenderEngine* const pEngine) override { _renderer->AddRenderEngine(pEngine); }
+    void BeginInvalidationBatch() override { _renderer->BeginInvalidationBatch(); }
+    void EndInvalidationBatch() override { _renderer->EndInvalidationBatch(); }
+
+private:
+    IRenderer* _renderer; // Non-ownership pointer
+    std::atomic<size_t> _paintCount{ 0 };
+};
+
 void VtIoTests::RendererDtorAndThread()
 {
     Log::Comment(NoThrowString().Format(
@@ -433,6 +488,137 @@ void VtIoTests::RendererDtorAndThread()
     }
 }
 
+void VtIoTests::RendererDtorAndPooledThread()
+{
+    Log::Comment(NoThrowString().Format(
+        L"Test deleting a bunch of Renderers sharing the thread pool while they're painting"));
+
+    std::vector<std::unique_ptr<MockRenderData>> data;
+    std::vector<std::unique_ptr<PaintCountingRenderer>> counters;
+    std::vector<std::unique_ptr<Microsoft::Console::Render::Renderer>> renderers;
+    for (int i = 0; i < 16; ++i)
+    {
+        data.emplace_back(std::make_unique<MockRenderData>());
+        auto thread = std::make_unique<Microsoft::Console::Render::PooledRenderThread>();
+        auto* pThread = thread.get();
+        auto pRenderer = std::make_unique<Microsoft::Console::Render::Renderer>(data.back().get(), nullptr, 0, std::move(thread));
+        counters.emplace_back(std::make_unique<PaintCountingRenderer>(pRenderer.get()));
+        VERIFY_SUCCEEDED(pThread->Initialize(counters.back().get()));
+
+        // Request a frame before painting is enabled, to make sure it isn't lost.
+        pRenderer->TriggerRedrawAll();
+        pThread->EnablePainting();
+        renderers.emplace_back(std::move(pRenderer));
+    }
+
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        for (auto& pRenderer : renderers)
+        {
+            pRenderer->TriggerRedrawAll();
+        }
+    }
+
+    Log::Comment(L"Every renderer should get painted by the pool.");
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 5 };
+    for (const auto& counter : counters)
+    {
+        while (counter->GetPaintCount() == 0 && std::chrono::steady_clock::now() < deadline)
+        {
+            Sleep(1);
+        }
+        VERIFY_ARE_NOT_EQUAL(size_t{ 0 }, counter->GetPaintCount());
+    }
+
+    // Keep requesting frames until the very end, so that there are callbacks
+    // queued or running while the renderers are destroyed.
+    for (auto& pRenderer : renderers)
+    {
+        pRenderer->TriggerRedrawAll();
+    }
+
+    for (auto& pRenderer : renderers)
+    {
+        pRenderer->TriggerTeardown();
+        pRenderer.reset();
+    }
+
+    Log::Comment(L"No frames should be painted once a renderer is gone.");
+    std::vector<size_t> paintCounts;
+    for (const auto& counter : counters)
+    {
+        paintCounts.emplace_back(counter->GetPaintCount());
+    }
+
+    // Longer than the frame budget, so a pending timer would have fired.
+    Sleep(100);
+
+    for (size_t i = 0; i < counters.size(); ++i)
+    {
+        VERIFY_ARE_EQUAL(paintCounts.at(i), counters.at(i)->GetPaintCount());
+    }
+}
+
+void VtIoTests::RendererThreadFrameLatency()
+{
+    Log::Comment(NoThrowString().Format(
+        L"Measure how long it takes a Renderer to paint after being invalidated"));
+
+    auto data = std::make_unique<MockRenderData>();
+    auto thread = std::make_unique<Microsoft::Console::Render::RenderThread>();
+    auto* pThread = thread.get();
+    auto pRenderer = std::make_unique<Microsoft::Console::Render::Renderer>(data.get(), nullptr, 0, std::move(thread));
+    VERIFY_SUCCEEDED(pThread->Initialize(pRenderer.get()));
+    pThread->EnablePainting();
+
+    const auto waitForFrames = [&](const uint64_t frames) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 5 };
+        while (pThread->GetFrameStatistics().frames < frames && std::chrono::steady_clock::now() < deadline)
+        {
+            Sleep(1);
+        }
+        return pThread->GetFrameStatistics();
+    };
+
+    Log::Comment(L"Invalidations after an idle period should be painted right away.");
+    static constexpr uint64_t idleFrames = 20;
+    for (uint64_t i = 1; i <= idleFrames; ++i)
+    {
+        Sleep(50);
+        pRenderer->TriggerRedrawAll();
+        waitForFrames(i);
+    }
+
+    const auto idle = pThread->GetFrameStatistics();
+    VERIFY_ARE_EQUAL(idleFrames, idle.frames);
+    Log::Comment(NoThrowString().Format(L"Idle: %llu frames, average latency %lldus, max latency %lldus, average paint time %lldus",
+                                        idle.frames,
+                                        idle.totalLatency.count() / gsl::narrow_cast<long long>(idle.frames),
+                                        idle.maxLatency.count(),
+                                        idle.totalPaintTime.count() / gsl::narrow_cast<long long>(idle.frames)));
+
+    Log::Comment(L"A flood of invalidations should be coalesced into fewer frames.");
+    static constexpr uint64_t floodRequests = 10000;
+    const auto floodStart = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < floodRequests; ++i)
+    {
+        pRenderer->TriggerRedrawAll();
+    }
+    const auto floodTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - floodStart);
+
+    const auto flood = waitForFrames(idle.frames + 1);
+    const auto floodFrames = flood.frames - idle.frames;
+    VERIFY_IS_LESS_THAN(floodFrames, floodRequests);
+    Log::Comment(NoThrowString().Format(L"Flood: %llu requests over %lldms were painted in %llu frames, max latency %lldus",
+                                        floodRequests,
+                                        floodTime.count(),
+                                        floodFrames,
+                                        flood.maxLatency.count()));
+
+    pRenderer->TriggerTeardown();
+    pRenderer.reset();
+}
+
 #ifndef __INSIDE_WINDOWS
 void VtIoTests::RendererDtorAndThreadAndDx()
 {
@@ -51,39 +51,46 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
         {
             try
             {
-                size_t capacity{};
-                RETURN_HR_IF(E_ABORT, !base::CheckAdd(in.length(), _partialsLen).AssignIfValid(&capacity));
-
-                _buffer.clear();
-                _buffer.reserve(capacity);
+                // Without cached partials there's nothing to prepend, so we can refer to
+                // the input directly instead of copying it into _buffer first.
+                // NOTE: In that case `out` is only valid as long as `in` is.
+                std::basic_string_view<T> source{ in };
 
-                // copy UTF-8 code units that were remaining from the previous call (if any)
                 if (_partialsLen != 0u)
                 {
+                    size_t capacity{};
+                    RETURN_HR_IF(E_ABORT, !base::CheckAdd(in.length(), _partialsLen).AssignIfValid(&capacity));
+
+                    _buffer.clear();
+                    _buffer.reserve(capacity);
+
+                    // copy UTF-8 code units that were remaining from the previous call
                     _buffer.assign(_utfPartials.cbegin(), _utfPartials.cbegin() + _partialsLen);
                     _partialsLen = 0u;
-                }
 
-                if (in.empty())
-                {
-                    out = _buffer;
-                    if (_buffer.empty())
+                    if (in.empty())
                     {
-                        return S_OK;
+                        out = _buffer;
+                        return S_FALSE; // the partial is populated
                     }
 
-                    return S_FALSE; // the partial is populated
+                    _buffer.append(in);
+                    source = _buffer;
+                }
+                else if (in.empty())
+                {
+                    out = {};
+                    return S_OK;
                 }
 
-                _buffer.append(in);
-                size_t remainingLength{ _buffer.length() };
+                size_t remainingLength{ source.length() };
 
-                auto backIter = _buffer.end();
+                auto backIter = source.end();
                 // If the last byte in the string was a byte belonging to a UTF-8 multi-byte character
                 if ((*(backIter - 1) & _Utf8BitMasks::MaskAsciiByte) > _Utf8BitMasks::IsAsciiByte)
                 {
                     // Check only up to 3 last bytes, if no Lead Byte was found then the byte before must be the Lead Byte and no partials are in the string
-                    const size_t stopLen{ std::min(_buffer.length(), gsl::narrow_cast<size_t>(3u)) };
+                    const size_t stopLen{ std::min(source.length(), gsl::narrow_cast<size_t>(3u)) };
                     for (size_t sequenceLen{ 1u }; sequenceLen <= stopLen; ++sequenceLen)
                     {
                         --backIter;
@@ -96,7 +103,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                             //  sequence is a complete UTF-8 code point and the whole string is ready for the conversion into a UTF-16 string.
                             if ((*backIter & _cmpMasks.at(sequenceLen)) != _cmpOperands.at(sequenceLen))
                             {
-                                std::move(backIter, _buffer.end(), _utfPartials.begin());
+                                std::copy(backIter, source.end(), _utfPartials.begin());
                                 remainingLength -= sequenceLen;
                                 _partialsLen = sequenceLen;
                             }
@@ -107,7 +114,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 }
 
                 // populate the part of the string that contains complete code points only
-                out = { _buffer.data(), remainingLength };
+                out = source.substr(0, remainingLength);
 
                 return S_OK;
             }
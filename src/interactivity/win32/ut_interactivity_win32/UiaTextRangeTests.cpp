@@ -1346,4 +1346,76 @@ class UiaTextRangeTests
             VERIFY_SUCCEEDED(utr->ScrollIntoView(alignToTop));
         }
     }
+
+    TEST_METHOD(GetTextPadsToMaxLength)
+    {
+        const auto bufferSize{ _pTextBuffer->GetSize() };
+        const COORD origin{ bufferSize.Origin() };
+
+        _pTextBuffer->Write({ L"abc" }, origin);
+
+        Microsoft::WRL::ComPtr<UiaTextRange> utr;
+        THROW_IF_FAILED(Microsoft::WRL::MakeAndInitialize<UiaTextRange>(&utr, _pUiaData, &_dummyProvider, origin, COORD{ 3, 0 }));
+
+        Log::Comment(L"Text longer than maxLength is truncated");
+        wil::unique_bstr text;
+        THROW_IF_FAILED(utr->GetText(2, &text));
+        VERIFY_ARE_EQUAL(L"ab", std::wstring_view(text.get(), SysStringLen(text.get())));
+
+        Log::Comment(L"Text shorter than maxLength is padded with NULs");
+        THROW_IF_FAILED(utr->GetText(5, &text));
+        VERIFY_ARE_EQUAL((std::wstring_view{ L"abc\0\0", 5 }), std::wstring_view(text.get(), SysStringLen(text.get())));
+
+        Log::Comment(L"A degenerate range is all NULs");
+        THROW_IF_FAILED(Microsoft::WRL::MakeAndInitialize<UiaTextRange>(&utr, _pUiaData, &_dummyProvider, origin, origin));
+        THROW_IF_FAILED(utr->GetText(2, &text));
+        VERIFY_ARE_EQUAL((std::wstring_view{ L"\0\0", 2 }), std::wstring_view(text.get(), SysStringLen(text.get())));
+    }
+
+    TEST_METHOD(GetTextOfFullBufferPerf)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES();
+
+        // Screen readers ask for a few characters of the whole document all
+        // the time. Make sure that's cheap even when the buffer is as large
+        // as the default 9001 line scrollback.
+        constexpr short bufferWidth = 120;
+        constexpr short bufferHeight = 9001;
+        constexpr auto iterations = 100;
+
+        _state->CleanupNewTextBufferInfo();
+        _state->PrepareNewTextBufferInfo(false, bufferWidth, bufferHeight);
+        _pTextBuffer = &_pScreenInfo->GetTextBuffer();
+
+        for (UINT i = 0; i < _pTextBuffer->TotalRowCount(); ++i)
+        {
+            auto& charRow = _pTextBuffer->GetRowByOffset(i).GetCharRow();
+            for (auto& cell : charRow)
+            {
+                cell.Char() = gsl::narrow_cast<wchar_t>(L'a' + i % 26);
+            }
+        }
+
+        const auto bufferSize = _pTextBuffer->GetSize();
+        Microsoft::WRL::ComPtr<UiaTextRange> utr;
+        THROW_IF_FAILED(Microsoft::WRL::MakeAndInitialize<UiaTextRange>(&utr, _pUiaData, &_dummyProvider, bufferSize.Origin(), bufferSize.EndExclusive()));
+
+        const auto measure = [&](const int maxLength, const size_t expectedLength) {
+            const auto start = std::chrono::steady_clock::now();
+            for (auto i = 0; i < iterations; i++)
+            {
+                wil::unique_bstr text;
+                VERIFY_SUCCEEDED(utr->GetText(maxLength, &text));
+                VERIFY_ARE_EQUAL(expectedLength, SysStringLen(text.get()));
+            }
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            const auto average = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / iterations;
+            Log::Comment(NoThrowString().Format(L"GetText(%d) took %lld us on average", maxLength, average));
+        };
+
+        measure(100, 100u);
+        measure(-1, bufferWidth * bufferHeight + (bufferHeight - 1) * 2u);
+    }
 };
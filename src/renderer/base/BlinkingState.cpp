@@ -4,8 +4,10 @@
 #include "precomp.h"
 
 #include "../inc/BlinkingState.hpp"
+#include "../../buffer/out/textBuffer.hpp"
 
 using namespace Microsoft::Console::Render;
+using namespace Microsoft::Console::Types;
 
 // Method Description:
 // - Updates the flag indicating whether cells with the blinking attribute
@@ -54,9 +56,13 @@ bool BlinkingState::IsBlinkingFaint() const noexcept
 //   the given render target if there are blinking cells currently in view.
 // Arguments:
 // - renderTarget: the render target that will be redrawn.
+// - buffer: the text buffer being rendered.
+// - viewport: the visible region of the buffer, in buffer coordinates.
 // Return Value:
 // - <none>
-void BlinkingState::ToggleBlinkingRendition(IRenderTarget& renderTarget) noexcept
+void BlinkingState::ToggleBlinkingRendition(IRenderTarget& renderTarget,
+                                            const TextBuffer& buffer,
+                                            const Viewport& viewport) noexcept
 try
 {
     if (_blinkingAllowed)
@@ -73,9 +79,54 @@ try
         {
             // We reset the _blinkingIsInUse flag before redrawing, so we can
             // get a fresh assessment of the current blinking attribute usage.
+            // Repainting the blinking runs will set it again if they're
+            // still in view.
             _blinkingIsInUse = false;
-            renderTarget.TriggerRedrawAll();
+            _InvalidateBlinkingRuns(renderTarget, buffer, viewport);
         }
     }
 }
 CATCH_LOG()
+
+// Routine Description:
+// - Invalidates the cells of every blinking run in the visible rows of the
+//   buffer, rather than the whole viewport. Only the visible rows are scanned,
+//   and a row is usually made of a handful of attribute runs, so this is much
+//   cheaper than repainting (and with conpty, retransmitting) the whole screen.
+// Arguments:
+// - renderTarget: the render target that will be redrawn.
+// - buffer: the text buffer being rendered.
+// - viewport: the visible region of the buffer, in buffer coordinates.
+// Return Value:
+// - <none>
+void BlinkingState::_InvalidateBlinkingRuns(IRenderTarget& renderTarget,
+                                            const TextBuffer& buffer,
+                                            const Viewport& viewport)
+{
+    const auto left = viewport.Left();
+    const auto right = viewport.RightExclusive();
+
+    renderTarget.BeginInvalidationBatch();
+    auto endBatch = wil::scope_exit([&]() noexcept { renderTarget.EndInvalidationBatch(); });
+
+    for (auto y = viewport.Top(); y < viewport.BottomExclusive(); y++)
+    {
+        SHORT x = 0;
+        for (const auto& run : buffer.GetRowByOffset(y).GetAttrRow().Runs())
+        {
+            const auto runLeft = x;
+            x = gsl::narrow_cast<SHORT>(x + run.length);
+            if (!run.value.IsBlinking())
+            {
+                continue;
+            }
+
+            const auto spanLeft = std::max(runLeft, left);
+            const auto spanRight = std::min(x, right);
+            if (spanLeft < spanRight)
+            {
+                renderTarget.TriggerRedraw(Viewport::FromExclusive({ spanLeft, y, spanRight, gsl::narrow_cast<SHORT>(y + 1) }));
+            }
+        }
+    }
+}
@@ -0,0 +1,188 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "PooledRenderThread.hpp"
+
+#pragma hdrstop
+
+using namespace Microsoft::Console::Render;
+
+PooledRenderThread::PooledRenderThread() :
+    _pRenderer(nullptr),
+    _enabled(false),
+    _frameRequested(false),
+    _scheduled(false),
+    _frameInterval(0),
+    _nextFrameTime()
+{
+    SetMaximumFrameRate(s_DefaultMaximumFrameRate);
+}
+
+PooledRenderThread::~PooledRenderThread()
+{
+    // Any callback that runs from now on returns without painting or arming
+    // the timer. The Renderer is already being destructed at this point, so
+    // there's no last frame to get out either.
+    _enabled.store(false, std::memory_order_release);
+
+    // A running callback might still arm the timer, so wait for the work
+    // callbacks first and only then stop the timer.
+    if (_work)
+    {
+        WaitForThreadpoolWorkCallbacks(_work.get(), TRUE);
+    }
+    if (_timer)
+    {
+        SetThreadpoolTimer(_timer.get(), nullptr, 0, 0);
+        WaitForThreadpoolTimerCallbacks(_timer.get(), TRUE);
+    }
+}
+
+// Method Description:
+// - Create the thread pool objects we'll be painting from.
+// Arguments:
+// - pRendererParent: the IRenderer that owns this object, and which we should
+//      trigger frames for.
+// Return Value:
+// - S_OK if we succeeded, else an HRESULT corresponding to a failure to create
+//      an Event or thread pool object.
+[[nodiscard]] HRESULT PooledRenderThread::Initialize(IRenderer* const pRendererParent) noexcept
+{
+    _pRenderer = pRendererParent;
+
+    _paintCompletedEvent.reset(CreateEventW(nullptr,
+                                            TRUE, // manual reset event
+                                            TRUE, // initially signaled
+                                            nullptr));
+    RETURN_LAST_ERROR_IF(!_paintCompletedEvent);
+
+    // Passing no environment puts the callbacks on the default process thread
+    // pool, which is shared with every other PooledRenderThread.
+    _work.reset(CreateThreadpoolWork(s_WorkCallback, this, nullptr));
+    RETURN_LAST_ERROR_IF(!_work);
+
+    _timer.reset(CreateThreadpoolTimer(s_TimerCallback, this, nullptr));
+    RETURN_LAST_ERROR_IF(!_timer);
+
+    return S_OK;
+}
+
+void CALLBACK PooledRenderThread::s_WorkCallback(PTP_CALLBACK_INSTANCE /*instance*/, PVOID context, PTP_WORK /*work*/) noexcept
+{
+    static_cast<PooledRenderThread*>(context)->_Tick();
+}
+
+void CALLBACK PooledRenderThread::s_TimerCallback(PTP_CALLBACK_INSTANCE /*instance*/, PVOID context, PTP_TIMER /*timer*/) noexcept
+{
+    static_cast<PooledRenderThread*>(context)->_Tick();
+}
+
+// Method Description:
+// - Queues a callback to paint the next frame, unless there already is one.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void PooledRenderThread::_Schedule() noexcept
+{
+    if (_enabled.load(std::memory_order_acquire) && !_scheduled.exchange(true, std::memory_order_acq_rel))
+    {
+        SubmitThreadpoolWork(_work.get());
+    }
+}
+
+// Method Description:
+// - Paints a frame if we're allowed to. If frames are coming in faster than
+//   the maximum frame rate, the timer is armed to call us again once the next
+//   frame is due instead.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void PooledRenderThread::_Tick() noexcept
+{
+    if (!_enabled.load(std::memory_order_acquire))
+    {
+        _scheduled.store(false, std::memory_order_release);
+        // EnablePainting might have been called after we checked _enabled
+        // but before we cleared _scheduled, in which case it didn't schedule.
+        if (_frameRequested.load(std::memory_order_acquire))
+        {
+            _Schedule();
+        }
+        return;
+    }
+
+    const std::chrono::steady_clock::duration interval{ _frameInterval.load(std::memory_order_relaxed) };
+    const auto allowedAt = _nextFrameTime - interval * (s_FrameBurst - 1);
+    const auto now = std::chrono::steady_clock::now();
+    if (now < allowedAt)
+    {
+        // Relative due times are negative multiples of 100ns.
+        const auto wait = std::chrono::ceil<std::chrono::duration<int64_t, std::ratio<1, 10'000'000>>>(allowedAt - now);
+        ULARGE_INTEGER dueTime;
+        dueTime.QuadPart = static_cast<ULONGLONG>(-wait.count());
+        FILETIME dueFileTime{ dueTime.LowPart, dueTime.HighPart };
+        SetThreadpoolTimer(_timer.get(), &dueFileTime, 0, 0);
+        return;
+    }
+
+    _nextFrameTime = std::max(now, _nextFrameTime) + interval;
+
+    _frameRequested.store(false, std::memory_order_release);
+    _paintCompletedEvent.ResetEvent();
+
+    _pRenderer->WaitUntilCanRender();
+    LOG_IF_FAILED(_pRenderer->PaintFrame());
+
+    _paintCompletedEvent.SetEvent();
+
+    // Anything that came in while we were painting needs another frame.
+    _scheduled.store(false, std::memory_order_release);
+    if (_frameRequested.load(std::memory_order_acquire))
+    {
+        _Schedule();
+    }
+}
+
+void PooledRenderThread::NotifyPaint()
+{
+    _frameRequested.store(true, std::memory_order_release);
+    _Schedule();
+}
+
+void PooledRenderThread::EnablePainting()
+{
+    _enabled.store(true, std::memory_order_release);
+    if (_frameRequested.load(std::memory_order_acquire))
+    {
+        _Schedule();
+    }
+}
+
+void PooledRenderThread::DisablePainting()
+{
+    _enabled.store(false, std::memory_order_release);
+}
+
+void PooledRenderThread::WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs)
+{
+    // See RenderThread::WaitForPaintCompletionAndDisable.
+    _enabled.store(false, std::memory_order_release);
+    WaitForSingleObject(_paintCompletedEvent.get(), dwTimeoutMs);
+}
+
+// Method Description:
+// - Sets the maximum number of frames per second that we'll paint while
+//   there's a steady stream of invalidations.
+// Arguments:
+// - framesPerSecond: the new maximum frame rate. 0 removes the limit.
+// Return Value:
+// - <none>
+void PooledRenderThread::SetMaximumFrameRate(const unsigned int framesPerSecond) noexcept
+{
+    const auto interval = framesPerSecond == 0 ? std::chrono::steady_clock::duration::zero() : std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds{ 1 }) / framesPerSecond;
+    _frameInterval.store(interval.count(), std::memory_order_relaxed);
+}
@@ -0,0 +1,70 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- PooledRenderThread.hpp
+
+Abstract:
+- An IRenderThread that doesn't own a thread. Frames are painted by callbacks
+  on the process-wide thread pool, which all renderers using this class share.
+  A renderer that has nothing to paint (like one in a background tab) doesn't
+  cost a thread or any wakeups.
+- Like RenderThread, it paints right away after idle periods and holds back
+  frames that are requested faster than the maximum frame rate.
+
+--*/
+
+#pragma once
+
+#include "../inc/IRenderer.hpp"
+#include "../inc/IRenderThread.hpp"
+
+namespace Microsoft::Console::Render
+{
+    class PooledRenderThread final : public IRenderThread
+    {
+    public:
+        PooledRenderThread();
+        virtual ~PooledRenderThread() override;
+
+        [[nodiscard]] HRESULT Initialize(_In_ IRenderer* const pRendererParent) noexcept;
+
+        void NotifyPaint() override;
+
+        void EnablePainting() override;
+        void DisablePainting() override;
+        void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) override;
+
+        void SetMaximumFrameRate(const unsigned int framesPerSecond) noexcept;
+
+    private:
+        static void CALLBACK s_WorkCallback(PTP_CALLBACK_INSTANCE instance, PVOID context, PTP_WORK work) noexcept;
+        static void CALLBACK s_TimerCallback(PTP_CALLBACK_INSTANCE instance, PVOID context, PTP_TIMER timer) noexcept;
+
+        void _Schedule() noexcept;
+        void _Tick() noexcept;
+
+        // One frame every 8ms, like RenderThread.
+        static constexpr unsigned int s_DefaultMaximumFrameRate = 125;
+        static constexpr unsigned int s_FrameBurst = 2;
+
+        IRenderer* _pRenderer; // Non-ownership pointer
+
+        wil::unique_threadpool_work _work;
+        wil::unique_threadpool_timer _timer;
+        wil::unique_event _paintCompletedEvent;
+
+        std::atomic<bool> _enabled;
+        // Set by NotifyPaint, cleared right before a frame is painted.
+        std::atomic<bool> _frameRequested;
+        // True while a callback is queued, running, or waiting on the timer.
+        // There's at most one of those at any time, so a renderer is never
+        // painted by two pool threads at once.
+        std::atomic<bool> _scheduled;
+
+        // See RenderThread::_WaitForFrameBudget. Only touched by callbacks.
+        std::atomic<std::chrono::steady_clock::rep> _frameInterval;
+        std::chrono::steady_clock::time_point _nextFrameTime;
+    };
+}
@@ -235,6 +235,13 @@ void Renderer::TriggerRedraw(const Viewport& region)
     if (view.TrimToViewport(&srUpdateRegion))
     {
         view.ConvertToOrigin(&srUpdateRegion);
+
+        if (_batchDepth != 0)
+        {
+            _BatchInvalidation(srUpdateRegion);
+            return;
+        }
+
         std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
             LOG_IF_FAILED(pEngine->Invalidate(&srUpdateRegion));
         });
@@ -431,6 +438,9 @@ bool Renderer::_CheckViewportAndScroll()
 // - <none>
 void Renderer::TriggerScroll()
 {
+    // Batched invalidations are relative to the viewport they were made in.
+    _FlushInvalidationBatch();
+
     if (_CheckViewportAndScroll())
     {
         _NotifyPaintFrame();
@@ -448,6 +458,9 @@ void Renderer::TriggerScroll()
 // - <none>
 void Renderer::TriggerScroll(const COORD* const pcoordDelta)
 {
+    // The engines need to scroll anything invalidated so far along with the text.
+    _FlushInvalidationBatch();
+
     std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
         LOG_IF_FAILED(pEngine->InvalidateScroll(pcoordDelta));
     });
@@ -466,6 +479,9 @@ void Renderer::TriggerScroll(const COORD* const pcoordDelta)
 // - <none>
 void Renderer::TriggerCircling()
 {
+    // The engines may paint right away, so they need to know what's dirty.
+    _FlushInvalidationBatch();
+
     for (IRenderEngine* const pEngine : _rgpEngines)
     {
         bool fEngineRequestsRepaint = false;
@@ -479,6 +495,100 @@ void Renderer::TriggerCircling()
     }
 }
 
+// Routine Description:
+// - Starts collecting the regions passed to TriggerRedraw instead of passing
+//      them on to the engines one by one. Writing text to the buffer triggers
+//      a redraw for every single run of text (or even character), and the
+//      engines don't need to know about any of them until we're done writing.
+// - Batches may be nested. Only the end of the outermost one flushes them.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::BeginInvalidationBatch()
+{
+    _batchDepth++;
+}
+
+// Routine Description:
+// - Ends a batch started with BeginInvalidationBatch. If it was the outermost
+//      one, the collected regions are passed on to the engines.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::EndInvalidationBatch()
+{
+    FAIL_FAST_IF(_batchDepth == 0);
+    if (--_batchDepth == 0)
+    {
+        _FlushInvalidationBatch();
+    }
+}
+
+// Routine Description:
+// - Adds a region to the current batch of invalidations.
+// Arguments:
+// - region: the dirty region, relative to the viewport origin, exclusive.
+// Return Value:
+// - <none>
+void Renderer::_BatchInvalidation(const SMALL_RECT& region)
+{
+    if (_batchedRows.size() < gsl::narrow_cast<size_t>(region.Bottom))
+    {
+        _batchedRows.resize(region.Bottom, { SHRT_MAX, SHRT_MIN });
+    }
+
+    for (auto row = region.Top; row < region.Bottom; row++)
+    {
+        auto& span = _batchedRows.at(row);
+        span.first = std::min(span.first, region.Left);
+        span.second = std::max(span.second, region.Right);
+    }
+
+    _batchedTop = std::min(_batchedTop, region.Top);
+    _batchedBottom = std::max(_batchedBottom, region.Bottom);
+}
+
+// Routine Description:
+// - Passes all invalidations collected so far on to the engines, merging
+//      consecutive rows with the same dirty columns into a single rectangle.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::_FlushInvalidationBatch()
+{
+    if (_batchedTop >= _batchedBottom)
+    {
+        return;
+    }
+
+    auto spanTop = _batchedTop;
+    for (auto row = _batchedTop; row <= _batchedBottom; row++)
+    {
+        if (row == _batchedBottom || _batchedRows.at(row) != _batchedRows.at(spanTop))
+        {
+            const auto& span = _batchedRows.at(spanTop);
+            if (span.first < span.second)
+            {
+                const SMALL_RECT region{ span.first, spanTop, span.second, row };
+                for (IRenderEngine* const pEngine : _rgpEngines)
+                {
+                    LOG_IF_FAILED(pEngine->Invalidate(&region));
+                }
+            }
+            spanTop = row;
+        }
+    }
+
+    std::fill(_batchedRows.begin() + _batchedTop, _batchedRows.begin() + _batchedBottom, std::pair<SHORT, SHORT>{ SHRT_MAX, SHRT_MIN });
+    _batchedTop = SHRT_MAX;
+    _batchedBottom = 0;
+
+    _NotifyPaintFrame();
+}
+
 // Routine Description:
 // - Called when the title of the console window has changed. Indicates that we
 //      should update the title on the next frame.
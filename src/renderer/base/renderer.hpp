@@ -61,6 +61,9 @@ namespace Microsoft::Console::Render
         void TriggerCircling() override;
         void TriggerTitleChange() override;
 
+        void BeginInvalidationBatch() override;
+        void EndInvalidationBatch() override;
+
         void TriggerFontChange(const int iDpi,
                                const FontInfoDesired& FontInfoDesired,
                                _Out_ FontInfo& FontInfo) override;
@@ -94,6 +97,17 @@ namespace Microsoft::Console::Render
 
         void _NotifyPaintFrame();
 
+        void _BatchInvalidation(const SMALL_RECT& region);
+        void _FlushInvalidationBatch();
+
+        // The invalidations collected by the current batch, as the dirty
+        // [left, right) column range of every row of the viewport, and the
+        // [top, bottom) range of rows that have any.
+        size_t _batchDepth = 0;
+        std::vector<std::pair<SHORT, SHORT>> _batchedRows;
+        SHORT _batchedTop = SHRT_MAX;
+        SHORT _batchedBottom = 0;
+
         [[nodiscard]] HRESULT _PaintFrameForEngine(_In_ IRenderEngine* const pEngine) noexcept;
 
         bool _CheckViewportAndScroll();
@@ -17,8 +17,13 @@ RenderThread::RenderThread() :
     _fKeepRunning(true),
     _hPaintEnabledEvent(nullptr),
     _fNextFrameRequested(false),
-    _fWaiting(false)
+    _fWaiting(false),
+    _frameInterval(0),
+    _nextFrameTime(),
+    _pendingSince(0),
+    _statistics()
 {
+    SetMaximumFrameRate(s_DefaultMaximumFrameRate);
 }
 
 RenderThread::~RenderThread()
@@ -200,25 +205,99 @@ DWORD WINAPI RenderThread::_ThreadProc()
             ResetEvent(_hEvent);
         }
 
+        // Rather than sleeping for a fixed amount of time after every frame,
+        // we only hold back frames that come in faster than the maximum frame
+        // rate. Invalidations keep piling up while we wait, so floods of
+        // output still get coalesced into fewer frames.
+        if (_fKeepRunning)
+        {
+            _WaitForFrameBudget();
+        }
+
         ResetEvent(_hPaintCompletedEvent);
 
+        const std::chrono::steady_clock::time_point requested{ std::chrono::steady_clock::duration{ _pendingSince.exchange(0, std::memory_order_acq_rel) } };
+        const auto paintStart = std::chrono::steady_clock::now();
+
         _pRenderer->WaitUntilCanRender();
         LOG_IF_FAILED(_pRenderer->PaintFrame());
 
-        SetEvent(_hPaintCompletedEvent);
+        _RecordFrame(requested, paintStart, std::chrono::steady_clock::now());
 
-        // extra check before we sleep since it's a "long" activity, relatively speaking.
-        if (_fKeepRunning)
-        {
-            Sleep(s_FrameLimitMilliseconds);
-        }
+        SetEvent(_hPaintCompletedEvent);
     }
 
     return S_OK;
 }
 
+// Method Description:
+// - Blocks until we're allowed to paint the next frame. This is a "generic
+//   cell rate" style limiter: after an idle period we may paint up to
+//   s_FrameBurst frames right away, which keeps the latency of things like
+//   echoing a keystroke low. Sustained requests are held to one frame per
+//   _frameInterval.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void RenderThread::_WaitForFrameBudget() noexcept
+{
+    const std::chrono::steady_clock::duration interval{ _frameInterval.load(std::memory_order_relaxed) };
+    const auto allowedAt = _nextFrameTime - interval * (s_FrameBurst - 1);
+
+    auto now = std::chrono::steady_clock::now();
+    if (now < allowedAt)
+    {
+        const auto wait = std::chrono::ceil<std::chrono::milliseconds>(allowedAt - now);
+        Sleep(gsl::narrow_cast<DWORD>(wait.count()));
+        now = std::chrono::steady_clock::now();
+    }
+
+    _nextFrameTime = std::max(now, _nextFrameTime) + interval;
+}
+
+// Method Description:
+// - Updates the frame statistics after a frame has been painted.
+// Arguments:
+// - requested: when the first request for this frame came in. Default
+//   constructed if we painted without anyone asking for it.
+// - paintStart: when we started painting the frame.
+// - paintEnd: when we were done painting the frame.
+// Return Value:
+// - <none>
+void RenderThread::_RecordFrame(const std::chrono::steady_clock::time_point requested,
+                                const std::chrono::steady_clock::time_point paintStart,
+                                const std::chrono::steady_clock::time_point paintEnd)
+{
+    const auto paintTime = std::chrono::duration_cast<std::chrono::microseconds>(paintEnd - paintStart);
+
+    std::lock_guard<std::mutex> lock{ _statisticsLock };
+
+    _statistics.frames++;
+    _statistics.lastPaintTime = paintTime;
+    _statistics.maxPaintTime = std::max(_statistics.maxPaintTime, paintTime);
+    _statistics.totalPaintTime += paintTime;
+
+    if (requested.time_since_epoch().count() != 0)
+    {
+        const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(paintEnd - requested);
+        _statistics.lastLatency = latency;
+        _statistics.maxLatency = std::max(_statistics.maxLatency, latency);
+        _statistics.totalLatency += latency;
+    }
+}
+
 void RenderThread::NotifyPaint()
 {
+    // Remember when the first request for the upcoming frame came in. This is
+    // only used for the frame statistics, so we don't care which of several
+    // racing callers wins.
+    if (_pendingSince.load(std::memory_order_relaxed) == 0)
+    {
+        std::chrono::steady_clock::rep expected{ 0 };
+        _pendingSince.compare_exchange_strong(expected, std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
     if (_fWaiting.load(std::memory_order_acquire))
     {
         SetEvent(_hEvent);
@@ -229,6 +308,31 @@ void RenderThread::NotifyPaint()
     }
 }
 
+// Method Description:
+// - Sets the maximum number of frames per second that we'll paint while
+//   there's a steady stream of invalidations.
+// Arguments:
+// - framesPerSecond: the new maximum frame rate. 0 removes the limit.
+// Return Value:
+// - <none>
+void RenderThread::SetMaximumFrameRate(const unsigned int framesPerSecond) noexcept
+{
+    const auto interval = framesPerSecond == 0 ? std::chrono::steady_clock::duration::zero() : std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds{ 1 }) / framesPerSecond;
+    _frameInterval.store(interval.count(), std::memory_order_relaxed);
+}
+
+// Method Description:
+// - Returns a snapshot of the frame statistics.
+// Arguments:
+// - <none>
+// Return Value:
+// - The counters for all frames painted so far.
+RenderThread::FrameStatistics RenderThread::GetFrameStatistics() const
+{
+    std::lock_guard<std::mutex> lock{ _statisticsLock };
+    return _statistics;
+}
+
 void RenderThread::EnablePainting()
 {
     SetEvent(_hPaintEnabledEvent);
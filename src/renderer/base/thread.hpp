@@ -22,6 +22,20 @@ namespace Microsoft::Console::Render
     class RenderThread final : public IRenderThread
     {
     public:
+        // Counters describing how the frames painted so far were scheduled.
+        // The latency of a frame is the time between the first request for it
+        // (a NotifyPaint call) and the end of PaintFrame.
+        struct FrameStatistics
+        {
+            uint64_t frames{ 0 };
+            std::chrono::microseconds lastPaintTime{};
+            std::chrono::microseconds maxPaintTime{};
+            std::chrono::microseconds totalPaintTime{};
+            std::chrono::microseconds lastLatency{};
+            std::chrono::microseconds maxLatency{};
+            std::chrono::microseconds totalLatency{};
+        };
+
         RenderThread();
         virtual ~RenderThread() override;
 
@@ -33,11 +47,23 @@ namespace Microsoft::Console::Render
         void DisablePainting() override;
         void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) override;
 
+        void SetMaximumFrameRate(const unsigned int framesPerSecond) noexcept;
+        FrameStatistics GetFrameStatistics() const;
+
     private:
         static DWORD WINAPI s_ThreadProc(_In_ LPVOID lpParameter);
         DWORD WINAPI _ThreadProc();
 
-        static DWORD const s_FrameLimitMilliseconds = 8;
+        void _WaitForFrameBudget() noexcept;
+        void _RecordFrame(const std::chrono::steady_clock::time_point requested,
+                          const std::chrono::steady_clock::time_point paintStart,
+                          const std::chrono::steady_clock::time_point paintEnd);
+
+        // One frame every 8ms.
+        static constexpr unsigned int s_DefaultMaximumFrameRate = 125;
+        // How many frames may be painted back to back after an idle period,
+        // before we start holding them back to the maximum frame rate.
+        static constexpr unsigned int s_FrameBurst = 2;
 
         HANDLE _hThread;
         HANDLE _hEvent;
@@ -50,5 +76,17 @@ namespace Microsoft::Console::Render
         bool _fKeepRunning;
         std::atomic<bool> _fNextFrameRequested;
         std::atomic<bool> _fWaiting;
+
+        // The minimum time between two frames, in steady_clock ticks.
+        std::atomic<std::chrono::steady_clock::rep> _frameInterval;
+        // The earliest time the next frame may be painted at once the burst
+        // allowance has been used up. Only touched by the render thread.
+        std::chrono::steady_clock::time_point _nextFrameTime;
+        // When the first NotifyPaint() for the upcoming frame happened, as
+        // steady_clock ticks since its epoch, or 0 if there wasn't one yet.
+        std::atomic<std::chrono::steady_clock::rep> _pendingSince;
+
+        mutable std::mutex _statisticsLock;
+        FrameStatistics _statistics;
     };
 }
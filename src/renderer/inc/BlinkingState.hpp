@@ -11,13 +11,16 @@ Abstract:
 - It tracks the position in the blinking cycle, which determines whether any
   blinking cells should be rendered as on or off/faint. It also records whether
   blinking attributes are actually in use or not, so we can decide whether the
-  screen needs to be refreshed when the blinking cycle changes.
+  screen needs to be refreshed when the blinking cycle changes. When it does,
+  only the blinking runs of the visible rows are invalidated.
 --*/
 
 #pragma once
 
 #include "IRenderTarget.hpp"
 
+class TextBuffer;
+
 namespace Microsoft::Console::Render
 {
     class BlinkingState
@@ -26,9 +29,15 @@ namespace Microsoft::Console::Render
         void SetBlinkingAllowed(const bool blinkingAllowed) noexcept;
         void RecordBlinkingUsage(const TextAttribute& attr) noexcept;
         bool IsBlinkingFaint() const noexcept;
-        void ToggleBlinkingRendition(IRenderTarget& renderTarget) noexcept;
+        void ToggleBlinkingRendition(IRenderTarget& renderTarget,
+                                     const TextBuffer& buffer,
+                                     const Microsoft::Console::Types::Viewport& viewport) noexcept;
 
     private:
+        static void _InvalidateBlinkingRuns(IRenderTarget& renderTarget,
+                                            const TextBuffer& buffer,
+                                            const Microsoft::Console::Types::Viewport& viewport);
+
         bool _blinkingAllowed = true;
         size_t _blinkingCycle = 0;
         bool _blinkingIsInUse = false;
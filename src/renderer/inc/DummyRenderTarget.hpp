@@ -31,4 +31,6 @@ public:
     void TriggerScroll(const COORD* const /*pcoordDelta*/) override {}
     void TriggerCircling() override {}
     void TriggerTitleChange() override {}
+    void BeginInvalidationBatch() override {}
+    void EndInvalidationBatch() override {}
 };
@@ -45,6 +45,11 @@ namespace Microsoft::Console::Render
         virtual void TriggerScroll(const COORD* const pcoordDelta) = 0;
         virtual void TriggerCircling() = 0;
         virtual void TriggerTitleChange() = 0;
+
+        // Calls to TriggerRedraw between these two are collected and turned
+        // into as few invalidations as possible once the outermost batch ends.
+        virtual void BeginInvalidationBatch() = 0;
+        virtual void EndInvalidationBatch() = 0;
     };
 
     inline Microsoft::Console::Render::IRenderTarget::~IRenderTarget() {}
@@ -651,4 +651,37 @@ public:
         mouseInput->EnableAlternateScroll(true);
         VERIFY_IS_FALSE(mouseInput->HandleMouse({ 0, 0 }, WM_MOUSEWHEEL, noModifierKeys, WHEEL_DELTA, {}));
     }
+
+    TEST_METHOD(StringOutputTests)
+    {
+        Log::Comment(L"Starting test...");
+        std::vector<std::wstring> sequences;
+        auto mouseInput = std::make_unique<TerminalInput>([&](std::wstring_view sequence) {
+            sequences.emplace_back(sequence);
+        });
+        const short noModifierKeys = 0;
+
+        Log::Comment(L"Test a default encoded button press");
+        mouseInput->EnableDefaultTracking(true);
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 1, 1 }, WM_LBUTTONDOWN, noModifierKeys, 0, {}));
+
+        Log::Comment(L"Test SGR encoded hovers with any-event tracking");
+        mouseInput->SetSGRExtendedMode(true);
+        mouseInput->EnableAnyEventTracking(true);
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 2, 3 }, WM_MOUSEMOVE, noModifierKeys, 0, {}));
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 126, 200 }, WM_MOUSEMOVE, noModifierKeys, 0, {}));
+
+        Log::Comment(L"Test alternate scrolling");
+        mouseInput->EnableAnyEventTracking(false);
+        mouseInput->UseAlternateScreenBuffer();
+        mouseInput->EnableAlternateScroll(true);
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 0, 0 }, WM_MOUSEWHEEL, noModifierKeys, WHEEL_DELTA, {}));
+
+        Log::Comment(L"Each sequence should have been delivered as a single string");
+        VERIFY_ARE_EQUAL(4u, sequences.size());
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"\x1b[M \"\"" }, std::wstring_view{ sequences.at(0) });
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"\x1b[<35;3;4m" }, std::wstring_view{ sequences.at(1) });
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"\x1b[<35;127;201m" }, std::wstring_view{ sequences.at(2) });
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"\x1b[A" }, std::wstring_view{ sequences.at(3) });
+    }
 };
@@ -25,6 +25,18 @@ TerminalInput::TerminalInput(_In_ std::function<void(std::deque<std::unique_ptr<
     _pfnWriteEvents = pfn;
 }
 
+// Routine Description:
+// - Creates a TerminalInput that delivers the generated sequences as strings,
+//   instead of converting every character into a key event first.
+// Arguments:
+// - pfn - Called with every sequence. The string is only valid for the
+//         duration of the call.
+TerminalInput::TerminalInput(_In_ std::function<void(std::wstring_view)> pfn) :
+    _pfnWriteString{ std::move(pfn) },
+    _leadingSurrogate{}
+{
+}
+
 struct TermKeyMap
 {
     const WORD vkey;
@@ -532,8 +544,9 @@ bool TerminalInput::HandleKey(const IInputEvent* const pInEvent)
     // Only do this if win32-input-mode support isn't manually disabled.
     if (_win32InputMode && !_forceDisableWin32InputMode)
     {
-        const auto seq = _GenerateWin32KeySequence(keyEvent);
-        _SendInputSequence(seq);
+        SequenceBuffer seq;
+        _GenerateWin32KeySequence(seq, keyEvent);
+        _SendInputSequence({ seq.data(), seq.size() });
         return true;
     }
 
@@ -713,6 +726,13 @@ void TerminalInput::_SendEscapedInputSequence(const wchar_t wch) const
 {
     try
     {
+        if (_pfnWriteString)
+        {
+            const std::array<wchar_t, 2> wstr{ { L'\x1b', wch } };
+            _pfnWriteString({ wstr.data(), wstr.size() });
+            return;
+        }
+
         std::deque<std::unique_ptr<IInputEvent>> inputEvents;
         inputEvents.push_back(std::make_unique<KeyEvent>(true, 1ui16, 0ui16, 0ui16, L'\x1b', 0));
         inputEvents.push_back(std::make_unique<KeyEvent>(true, 1ui16, 0ui16, 0ui16, wch, 0));
@@ -728,6 +748,14 @@ void TerminalInput::_SendNullInputSequence(const DWORD controlKeyState) const
 {
     try
     {
+        if (_pfnWriteString)
+        {
+            // A string can't carry the modifier keys, only the NUL itself.
+            const wchar_t wch = UNICODE_NULL;
+            _pfnWriteString({ &wch, 1 });
+            return;
+        }
+
         std::deque<std::unique_ptr<IInputEvent>> inputEvents;
         inputEvents.push_back(std::make_unique<KeyEvent>(true,
                                                          1ui16,
@@ -749,6 +777,12 @@ void TerminalInput::_SendInputSequence(const std::wstring_view sequence) const n
     {
         try
         {
+            if (_pfnWriteString)
+            {
+                _pfnWriteString(sequence);
+                return;
+            }
+
             std::deque<std::unique_ptr<IInputEvent>> inputEvents;
             for (const auto& wch : sequence)
             {
@@ -766,10 +800,11 @@ void TerminalInput::_SendInputSequence(const std::wstring_view sequence) const n
 // Method Description:
 // - Synthesize a win32-input-mode sequence for the given keyevent.
 // Arguments:
+// - sequence: receives the formatted string representation of this key
 // - key: the KeyEvent to serialize.
 // Return Value:
-// - the formatted string representation of this key
-std::wstring TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key)
+// - <none>
+void TerminalInput::_GenerateWin32KeySequence(SequenceBuffer& sequence, const KeyEvent& key)
 {
     // Sequences are formatted as follows:
     //
@@ -782,11 +817,12 @@ std::wstring TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key)
     //      Kd: the value of bKeyDown - either a '0' or '1'. If omitted, defaults to '0'.
     //      Cs: the value of dwControlKeyState - any number. If omitted, defaults to '0'.
     //      Rc: the value of wRepeatCount - any number. If omitted, defaults to '1'.
-    return fmt::format(FMT_COMPILE(L"\x1b[{};{};{};{};{};{}_"),
-                       key.GetVirtualKeyCode(),
-                       key.GetVirtualScanCode(),
-                       static_cast<int>(key.GetCharData()),
-                       key.IsKeyDown() ? 1 : 0,
-                       key.GetActiveModifierKeys(),
-                       key.GetRepeatCount());
+    fmt::format_to(std::back_inserter(sequence),
+                   FMT_COMPILE(L"\x1b[{};{};{};{};{};{}_"),
+                   key.GetVirtualKeyCode(),
+                   key.GetVirtualScanCode(),
+                   static_cast<int>(key.GetCharData()),
+                   key.IsKeyDown() ? 1 : 0,
+                   key.GetActiveModifierKeys(),
+                   key.GetRepeatCount());
 }
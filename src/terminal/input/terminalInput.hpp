@@ -23,6 +23,7 @@ namespace Microsoft::Console::VirtualTerminal
     {
     public:
         TerminalInput(_In_ std::function<void(std::deque<std::unique_ptr<IInputEvent>>&)> pfn);
+        TerminalInput(_In_ std::function<void(std::wstring_view)> pfn);
 
         TerminalInput() = delete;
         TerminalInput(const TerminalInput& old) = default;
@@ -75,7 +76,14 @@ namespace Microsoft::Console::VirtualTerminal
 #pragma endregion
 
     private:
+        // Sequences are delivered either as key events (for conhost, which
+        // needs INPUT_RECORDs) or, when _pfnWriteString is set, as a string.
         std::function<void(std::deque<std::unique_ptr<IInputEvent>>&)> _pfnWriteEvents;
+        std::function<void(std::wstring_view)> _pfnWriteString;
+
+        // Mouse and win32-input-mode sequences are short enough to be
+        // formatted on the stack, without any heap allocation.
+        using SequenceBuffer = fmt::basic_memory_buffer<wchar_t, 64>;
 
         // storage location for the leading surrogate of a utf-16 surrogate pair
         std::optional<wchar_t> _leadingSurrogate;
@@ -90,7 +98,7 @@ namespace Microsoft::Console::VirtualTerminal
         void _SendNullInputSequence(const DWORD dwControlKeyState) const;
         void _SendInputSequence(const std::wstring_view sequence) const noexcept;
         void _SendEscapedInputSequence(const wchar_t wch) const;
-        static std::wstring _GenerateWin32KeySequence(const KeyEvent& key);
+        static void _GenerateWin32KeySequence(SequenceBuffer& sequence, const KeyEvent& key);
 
 #pragma region MouseInputState Management
         // These methods are defined in mouseInputState.cpp
@@ -125,22 +133,25 @@ namespace Microsoft::Console::VirtualTerminal
 #pragma endregion
 
 #pragma region MouseInput
-        static std::wstring _GenerateDefaultSequence(const COORD position,
-                                                     const unsigned int button,
-                                                     const bool isHover,
-                                                     const short modifierKeyState,
-                                                     const short delta);
-        static std::wstring _GenerateUtf8Sequence(const COORD position,
-                                                  const unsigned int button,
-                                                  const bool isHover,
-                                                  const short modifierKeyState,
-                                                  const short delta);
-        static std::wstring _GenerateSGRSequence(const COORD position,
-                                                 const unsigned int button,
-                                                 const bool isDown,
-                                                 const bool isHover,
-                                                 const short modifierKeyState,
-                                                 const short delta);
+        static void _GenerateDefaultSequence(SequenceBuffer& sequence,
+                                             const COORD position,
+                                             const unsigned int button,
+                                             const bool isHover,
+                                             const short modifierKeyState,
+                                             const short delta);
+        static void _GenerateUtf8Sequence(SequenceBuffer& sequence,
+                                          const COORD position,
+                                          const unsigned int button,
+                                          const bool isHover,
+                                          const short modifierKeyState,
+                                          const short delta);
+        static void _GenerateSGRSequence(SequenceBuffer& sequence,
+                                         const COORD position,
+                                         const unsigned int button,
+                                         const bool isDown,
+                                         const bool isHover,
+                                         const short modifierKeyState,
+                                         const short delta);
 
         bool _ShouldSendAlternateScroll(const unsigned int button, const short delta) const noexcept;
         bool _SendAlternateScroll(const short delta) const noexcept;
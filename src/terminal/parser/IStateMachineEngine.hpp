@@ -20,7 +20,10 @@ namespace Microsoft::Console::VirtualTerminal
     class IStateMachineEngine
     {
     public:
-        using StringHandler = std::function<bool(const wchar_t)>;
+        // Receives the data string of a DCS sequence. Long runs of data are
+        // delivered in as few calls as possible, so a single call may contain
+        // anything from one character to the whole string.
+        using StringHandler = std::function<bool(const std::wstring_view)>;
 
         virtual ~IStateMachineEngine() = 0;
         IStateMachineEngine(const IStateMachineEngine&) = default;
@@ -44,6 +47,10 @@ namespace Microsoft::Console::VirtualTerminal
 
         virtual bool ActionIgnore() = 0;
 
+        // Called when the string of an OSC sequence begins. If the engine
+        // returns a handler, the string is streamed to it as it's parsed, and
+        // ActionOscDispatch receives an empty string instead.
+        virtual StringHandler ActionOscStringStart(const size_t parameter) = 0;
         virtual bool ActionOscDispatch(const wchar_t wch,
                                        const size_t parameter,
                                        const std::wstring_view string) = 0;
@@ -464,6 +464,19 @@ IStateMachineEngine::StringHandler InputStateMachineEngine::ActionDcsDispatch(co
     return nullptr;
 }
 
+// Routine Description:
+// - Called when the string of an OSC sequence begins. Returns the handler that
+//      is to be used to process the string, if it should be streamed rather
+//      than collected.
+// Arguments:
+// - parameter - identifier of the OSC action.
+// Return Value:
+// - nullptr, so that the string is collected and passed to ActionOscDispatch.
+IStateMachineEngine::StringHandler InputStateMachineEngine::ActionOscStringStart(const size_t /*parameter*/) noexcept
+{
+    return nullptr;
+}
+
 // Routine Description:
 // - Triggers the Ss3Dispatch action to indicate that the listener should handle
 //      a control sequence. These sequences perform various API-type commands
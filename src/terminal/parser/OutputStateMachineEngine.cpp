@@ -21,7 +21,11 @@ OutputStateMachineEngine::OutputStateMachineEngine(std::unique_ptr<ITermDispatch
     _dispatch(std::move(pDispatch)),
     _pfnFlushToTerminal(nullptr),
     _pTtyConnection(nullptr),
-    _lastPrintedChar(AsciiChars::NUL)
+    _lastPrintedChar(AsciiChars::NUL),
+    _clipboardStringPart(ClipboardStringPart::None),
+    _clipboardDataLength(0),
+    _clipboardQuery(false),
+    _clipboardDecoder(MaxClipboardSize)
 {
     THROW_HR_IF_NULL(E_INVALIDARG, _dispatch.get());
 }
@@ -656,14 +660,21 @@ IStateMachineEngine::StringHandler OutputStateMachineEngine::ActionDcsDispatch(c
 
 // Routine Description:
 // - Triggers the Clear action to indicate that the state machine should erase
-//      all internal state.
+//      all internal state. This is also how we learn that an OSC 52 string
+//      was abandoned before it was terminated.
 // Arguments:
 // - <none>
 // Return Value:
 // - <none>
 bool OutputStateMachineEngine::ActionClear() noexcept
 {
-    // do nothing.
+    // Don't hold on to the contents of an abandoned OSC 52 string, and don't
+    // let them leak into the next one.
+    if (_clipboardStringPart != ClipboardStringPart::None)
+    {
+        _clipboardStringPart = ClipboardStringPart::None;
+        _clipboardDecoder.Reset();
+    }
     return true;
 }
 
@@ -680,13 +691,33 @@ bool OutputStateMachineEngine::ActionIgnore() noexcept
     return true;
 }
 
+// Routine Description:
+// - Called when the string of an OSC sequence begins. Clipboard contents
+//      (OSC 52) are streamed into a base64 decoder while they are parsed, all
+//      other strings are collected and handled in ActionOscDispatch.
+// Arguments:
+// - parameter - identifier of the OSC action.
+// Return Value:
+// - the string handler function or nullptr if the string should be collected.
+IStateMachineEngine::StringHandler OutputStateMachineEngine::ActionOscStringStart(const size_t parameter) noexcept
+{
+    if (parameter != OscActionCodes::SetClipboard)
+    {
+        return nullptr;
+    }
+
+    _StartOscSetClipboard();
+    return [this](const std::wstring_view string) { return _PutOscSetClipboard(string); };
+}
+
 // Routine Description:
 // - Triggers the OscDispatch action to indicate that the listener should handle a control sequence.
 //   These sequences perform various API-type commands that can include many parameters.
 // Arguments:
 // - wch - Character to dispatch. This will be a BEL or ST char.
 // - parameter - identifier of the OSC action to perform
-// - string - OSC string we've collected. NOT null terminated.
+// - string - OSC string we've collected. NOT null terminated. Empty if the
+//      string was streamed to the handler returned by ActionOscStringStart.
 // Return Value:
 // - true if we handled the dispatch.
 bool OutputStateMachineEngine::ActionOscDispatch(const wchar_t /*wch*/,
@@ -772,9 +803,17 @@ bool OutputStateMachineEngine::ActionOscDispatch(const wchar_t /*wch*/,
     }
     case OscActionCodes::SetClipboard:
     {
+        // The string is normally streamed to _PutOscSetClipboard while it's
+        // parsed, but it may have been collected like any other OSC string.
+        if (_clipboardStringPart == ClipboardStringPart::None)
+        {
+            _StartOscSetClipboard();
+            _PutOscSetClipboard(string);
+        }
+
         std::wstring setClipboardContent;
         bool queryClipboard = false;
-        success = _GetOscSetClipboard(string, setClipboardContent, queryClipboard);
+        success = _FinishOscSetClipboard(setClipboardContent, queryClipboard);
         if (success && !queryClipboard)
         {
             success = _dispatch->SetClipboard(setClipboardContent);
@@ -1069,34 +1108,80 @@ void OutputStateMachineEngine::SetTerminalConnection(ITerminalOutputConnection*
 }
 
 // Routine Description:
-// - Parse OscSetClipboard parameters with the format `Pc;Pd`. Currently the first parameter `Pc` is
-// ignored. The second parameter `Pd` should be a valid base64 string or character `?`.
+// - Prepares to parse a new OscSetClipboard string.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void OutputStateMachineEngine::_StartOscSetClipboard() noexcept
+{
+    _clipboardStringPart = ClipboardStringPart::Selection;
+    _clipboardDataLength = 0;
+    _clipboardQuery = false;
+    _clipboardDecoder.Reset();
+}
+
+// Routine Description:
+// - Parse the next piece of the OscSetClipboard parameters, with the format
+// `Pc;Pd`. Currently the first parameter `Pc` is ignored. The second parameter
+// `Pd` is decoded as it arrives.
+// Arguments:
+// - string - The next piece of the Osc String.
+// Return Value:
+// - true, so that the rest of the string is passed to us as well.
+bool OutputStateMachineEngine::_PutOscSetClipboard(std::wstring_view string) noexcept
+{
+    if (_clipboardStringPart == ClipboardStringPart::Selection)
+    {
+        const size_t pos = string.find(L';');
+        if (pos == std::wstring_view::npos)
+        {
+            return true;
+        }
+        string = string.substr(pos + 1);
+        _clipboardStringPart = ClipboardStringPart::Data;
+    }
+
+    if (!string.empty())
+    {
+        // A `Pd` of `?` is a query rather than base64 data.
+        _clipboardQuery = _clipboardDataLength == 0 && string.front() == L'?';
+        _clipboardDataLength += string.size();
+        // If the data is invalid, the decoder remembers that and the
+        // failure is reported once the string is complete.
+        _clipboardDecoder.Append(string);
+    }
+    return true;
+}
+
+// Routine Description:
+// - Completes the OscSetClipboard parameters. The second parameter `Pd` should
+// be a valid base64 string or character `?`.
 // Arguments:
-// - string - Osc String input.
 // - content - Content to set to clipboard.
 // - queryClipboard - Whether to get clipboard content and return it to terminal with base64 encoded.
 // Return Value:
 // - True if there was a valid base64 string or the passed parameter was `?`.
-bool OutputStateMachineEngine::_GetOscSetClipboard(const std::wstring_view string,
-                                                   std::wstring& content,
-                                                   bool& queryClipboard) const noexcept
+bool OutputStateMachineEngine::_FinishOscSetClipboard(std::wstring& content,
+                                                      bool& queryClipboard) noexcept
 {
-    const size_t pos = string.find(';');
-    if (pos != std::wstring_view::npos)
+    bool success = false;
+    if (_clipboardStringPart == ClipboardStringPart::Data)
     {
-        const std::wstring_view substr = string.substr(pos + 1);
-        if (substr == L"?")
+        if (_clipboardQuery && _clipboardDataLength == 1)
         {
             queryClipboard = true;
-            return true;
+            success = true;
         }
         else
         {
-            return Base64::s_Decode(substr, content);
+            success = _clipboardDecoder.Finish(content);
         }
     }
 
-    return false;
+    _clipboardStringPart = ClipboardStringPart::None;
+    _clipboardDecoder.Reset();
+    return success;
 }
 
 // Method Description:
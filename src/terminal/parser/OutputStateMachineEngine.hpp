@@ -15,6 +15,7 @@ Abstract:
 #include "../adapter/termDispatch.hpp"
 #include "telemetry.hpp"
 #include "IStateMachineEngine.hpp"
+#include "base64.hpp"
 #include "../../inc/ITerminalOutputConnection.hpp"
 
 namespace Microsoft::Console::VirtualTerminal
@@ -45,6 +46,8 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool ActionIgnore() noexcept override;
 
+        StringHandler ActionOscStringStart(const size_t parameter) noexcept override;
+
         bool ActionOscDispatch(const wchar_t wch,
                                const size_t parameter,
                                const std::wstring_view string) override;
@@ -68,6 +71,23 @@ namespace Microsoft::Console::VirtualTerminal
         std::function<bool()> _pfnFlushToTerminal;
         wchar_t _lastPrintedChar;
 
+        // OSC 52 payloads are decoded while they're being parsed, so that
+        // large clipboard contents aren't held in their encoded form too.
+        // Anything that decodes to more than this many bytes is dropped.
+        static constexpr size_t MaxClipboardSize = 64 * 1024 * 1024;
+
+        enum class ClipboardStringPart
+        {
+            None,
+            Selection,
+            Data
+        };
+
+        ClipboardStringPart _clipboardStringPart;
+        size_t _clipboardDataLength;
+        bool _clipboardQuery;
+        Base64Decoder _clipboardDecoder;
+
         enum EscActionCodes : uint64_t
         {
             DECSC_CursorSave = VTID("7"),
@@ -191,9 +211,10 @@ namespace Microsoft::Console::VirtualTerminal
         bool _GetOscSetColor(const std::wstring_view string,
                              std::vector<DWORD>& rgbs) const noexcept;
 
-        bool _GetOscSetClipboard(const std::wstring_view string,
-                                 std::wstring& content,
-                                 bool& queryClipboard) const noexcept;
+        void _StartOscSetClipboard() noexcept;
+        bool _PutOscSetClipboard(std::wstring_view string) noexcept;
+        bool _FinishOscSetClipboard(std::wstring& content,
+                                    bool& queryClipboard) noexcept;
 
         static constexpr std::wstring_view hyperlinkIDParameter{ L"id=" };
         bool _ParseHyperlink(const std::wstring_view string,
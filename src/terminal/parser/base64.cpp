@@ -6,11 +6,34 @@
 
 using namespace Microsoft::Console::VirtualTerminal;
 
-static const char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-static const char padChar = '=';
+static constexpr char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static constexpr char padChar = '=';
 
 #pragma warning(disable : 26446 26447 26482 26485 26493 26494)
 
+// Every character outside of the base64 alphabet decodes to a value with this
+// bit set, so that a whole quantum can be validated with a single test.
+static constexpr uint8_t invalidValue = 0x80;
+
+// Maps each ASCII character to its 6 bit base64 value.
+static constexpr auto base64Values = []() {
+    std::array<uint8_t, 128> values{};
+    for (auto& value : values)
+    {
+        value = invalidValue;
+    }
+    for (uint8_t i = 0; i < 64; i++)
+    {
+        values[base64Chars[i]] = i;
+    }
+    return values;
+}();
+
+static constexpr uint8_t _decodeBase64Char(const wchar_t ch) noexcept
+{
+    return ch < base64Values.size() ? base64Values[ch] : invalidValue;
+}
+
 // Routine Description:
 // - Encode a string using base64. When there are not enough characters
 //      for one quantum, paddings are added.
@@ -75,119 +98,276 @@ std::wstring Base64::s_Encode(const std::wstring_view src) noexcept
 // - true if decoding successfully, otherwise false.
 bool Base64::s_Decode(const std::wstring_view src, std::wstring& dst) noexcept
 {
-    std::string mbStr;
-    int state = 0;
-    char tmp;
+    Base64Decoder decoder;
+    return decoder.Append(src) && decoder.Finish(dst);
+}
 
-    const auto len = src.size() / 4 * 3;
-    if (len == 0)
+// Routine Description:
+// - Check if parameter is a base64 whitespace. Only carriage return or line feed
+//      is valid whitespace.
+// Arguments:
+// - ch - Character to check.
+// Return Value:
+// - true iff ch is a carriage return or line feed.
+constexpr bool Base64::s_IsSpace(const wchar_t ch) noexcept
+{
+    return ch == L'\r' || ch == L'\n';
+}
+
+// Routine Description:
+// - Creates a decoder for a new base64 string.
+// Arguments:
+// - maxSize - The maximum number of bytes the string may decode to. Decoding
+//      fails once the string grows beyond it.
+Base64Decoder::Base64Decoder(const size_t maxSize) noexcept :
+    _maxSize{ maxSize }
+{
+    Reset();
+}
+
+// Routine Description:
+// - Discards everything decoded so far, to start decoding a new string.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Base64Decoder::Reset() noexcept
+{
+    _inputSize = 0;
+    _decodedSize = 0;
+    _failed = false;
+    _state = 0;
+    _pending = 0;
+    _padding = Padding::None;
+    _bytes.clear();
+    // Don't hold on to the memory of a large string once we're done with it.
+    _result = std::wstring{};
+}
+
+// Routine Description:
+// - Decodes the next piece of the base64 string. Whitespace may appear
+//      anywhere, and a quantum may be split across pieces.
+// Arguments:
+// - src - The next characters of the string.
+// Return Value:
+// - false if the string is invalid so far, or exceeds the maximum size. All
+//      further calls will fail until the decoder is reset.
+bool Base64Decoder::Append(const std::wstring_view src) noexcept
+{
+    if (_failed)
     {
         return false;
     }
-    mbStr.reserve(len);
+
+    try
+    {
+        _bytes.reserve(_bytes.size() + src.size() / 4 * 3 + 3);
+    }
+    catch (...)
+    {
+        return _Fail();
+    }
+
+    _inputSize += src.size();
+    const auto decodedBefore = _bytes.size();
 
     auto iter = src.cbegin();
-    while (iter < src.cend())
+    const auto end = src.cend();
+    while (iter < end)
     {
-        if (s_IsSpace(*iter)) // Skip whitespace anywhere.
+        // The bulk of a string is made up of whole quanta without any
+        // whitespace, which we can decode four characters at a time.
+        if (_state == 0 && _padding == Padding::None)
+        {
+            while (end - iter >= 4)
+            {
+                const uint32_t a = _decodeBase64Char(iter[0]);
+                const uint32_t b = _decodeBase64Char(iter[1]);
+                const uint32_t c = _decodeBase64Char(iter[2]);
+                const uint32_t d = _decodeBase64Char(iter[3]);
+                if ((a | b | c | d) & invalidValue)
+                {
+                    // Whitespace, padding or an error. Let the loop below sort it out.
+                    break;
+                }
+
+                const auto quantum = a << 18 | b << 12 | c << 6 | d;
+                _bytes.push_back(static_cast<char>(quantum >> 16));
+                _bytes.push_back(static_cast<char>(quantum >> 8));
+                _bytes.push_back(static_cast<char>(quantum));
+                iter += 4;
+            }
+
+            if (iter == end)
+            {
+                break;
+            }
+        }
+
+        const auto ch = *iter++;
+        if (Base64::s_IsSpace(ch)) // Skip whitespace anywhere.
         {
-            iter++;
             continue;
         }
 
-        if (*iter == padChar)
+        if (_padding != Padding::None)
         {
-            break;
+            // After the padding there may only be whitespace, and the second
+            // padding character if the quantum needs two.
+            if (_padding == Padding::ExpectingSecond && ch == padChar)
+            {
+                _padding = Padding::Complete;
+                continue;
+            }
+            return _Fail();
+        }
+
+        if (ch == padChar)
+        {
+            switch (_state)
+            {
+            // Invalid when state is 0 or 1.
+            case 2:
+                _padding = Padding::ExpectingSecond;
+                break;
+            case 3:
+                _padding = Padding::Complete;
+                break;
+            default:
+                return _Fail();
+            }
+            continue;
         }
 
-        auto pos = strchr(base64Chars, *iter);
-        if (!pos) // A non-base64 character found.
+        const auto value = _decodeBase64Char(ch);
+        if (value & invalidValue) // A non-base64 character found.
         {
-            return false;
+            return _Fail();
         }
 
-        switch (state)
+        switch (_state)
         {
         case 0:
-            tmp = (char)(pos - base64Chars) << 2;
-            state = 1;
+            _pending = static_cast<char>(value << 2);
+            _state = 1;
             break;
         case 1:
-            tmp |= (char)(pos - base64Chars) >> 4;
-            mbStr += tmp;
-            tmp = (char)((pos - base64Chars) & 0x0f) << 4;
-            state = 2;
+            _bytes.push_back(static_cast<char>(_pending | (value >> 4)));
+            _pending = static_cast<char>((value & 0x0f) << 4);
+            _state = 2;
             break;
         case 2:
-            tmp |= (char)(pos - base64Chars) >> 2;
-            mbStr += tmp;
-            tmp = (char)((pos - base64Chars) & 0x03) << 6;
-            state = 3;
+            _bytes.push_back(static_cast<char>(_pending | (value >> 2)));
+            _pending = static_cast<char>((value & 0x03) << 6);
+            _state = 3;
             break;
         case 3:
-            tmp |= pos - base64Chars;
-            mbStr += tmp;
-            state = 0;
+            _bytes.push_back(static_cast<char>(_pending | value));
+            _state = 0;
             break;
         default:
             break;
         }
+    }
+
+    _decodedSize += _bytes.size() - decodedBefore;
+    if (_decodedSize > _maxSize)
+    {
+        return _Fail();
+    }
 
-        iter++;
+    return _Flush(false);
+}
+
+// Routine Description:
+// - Completes the string and hands over the decoded text. The decoder is
+//      reset afterwards, whether it succeeded or not.
+// Arguments:
+// - dst - Destination to move the decoded text into.
+// Return Value:
+// - true if the whole string was valid and properly padded, otherwise false.
+bool Base64Decoder::Finish(std::wstring& dst) noexcept
+{
+    // When no padding, we must be in state 0.
+    const auto complete = _padding == Padding::Complete || (_padding == Padding::None && _state == 0);
+    const auto success = !_failed && _inputSize >= 4 && complete && _Flush(true);
+    if (success)
+    {
+        dst = std::move(_result);
     }
 
-    if (iter < src.cend()) // Padding char is met.
+    Reset();
+    return success;
+}
+
+// Routine Description:
+// - Puts the decoder into the failed state.
+// Arguments:
+// - <none>
+// Return Value:
+// - false, always.
+bool Base64Decoder::_Fail() noexcept
+{
+    _failed = true;
+    _bytes.clear();
+    _result = std::wstring{};
+    return false;
+}
+
+// Routine Description:
+// - Converts the decoded UTF-8 bytes to UTF-16 and appends them to the result.
+// Arguments:
+// - final - If false, a UTF-8 sequence that is cut off at the end is kept
+//      until the next call, when the rest of it has been decoded.
+// Return Value:
+// - false if the conversion failed.
+bool Base64Decoder::_Flush(const bool final) noexcept
+try
+{
+    auto length = _bytes.size();
+    if (!final)
     {
-        iter++;
-        switch (state)
+        // Walk back over the trailing continuation bytes to the lead byte of
+        // the last sequence and check whether all of its bytes are there.
+        const auto maxTrail = std::min<size_t>(3, length);
+        for (size_t i = 1; i <= maxTrail; i++)
         {
-        // Invalid when state is 0 or 1.
-        case 0:
-        case 1:
-            return false;
-        case 2:
-            // Skip any number of spaces.
-            while (iter < src.cend() && s_IsSpace(*iter))
-            {
-                iter++;
-            }
-            // Make sure there is another trailing padding character.
-            if (iter == src.cend() || *iter != padChar)
+            const auto byte = static_cast<uint8_t>(_bytes[_bytes.size() - i]);
+            if ((byte & 0xC0) != 0x80)
             {
-                return false;
-            }
-            iter++; // Skip the padding character and fallthrough to "single trailing padding character" case.
-            [[fallthrough]];
-        case 3:
-            while (iter < src.cend())
-            {
-                if (!s_IsSpace(*iter))
+                const size_t sequenceLength = byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : byte >= 0xC0 ? 2 : 1;
+                if (sequenceLength > i)
                 {
-                    return false;
+                    length -= i;
                 }
-                iter++;
+                break;
             }
-            break;
-        default:
-            break;
         }
     }
-    else if (state != 0) // When no padding, we must be in state 0.
+
+    if (length != 0)
     {
-        return false;
+        // UTF-16 never needs more code units than UTF-8 does.
+        const auto offset = _result.size();
+        _result.resize(offset + length);
+        const auto written = MultiByteToWideChar(CP_UTF8,
+                                                 0,
+                                                 _bytes.data(),
+                                                 gsl::narrow<int>(length),
+                                                 _result.data() + offset,
+                                                 gsl::narrow<int>(length));
+        if (written == 0)
+        {
+            return _Fail();
+        }
+
+        _result.resize(offset + written);
+        _bytes.erase(0, length);
     }
 
-    return SUCCEEDED(til::u8u16(mbStr, dst));
+    return true;
 }
-
-// Routine Description:
-// - Check if parameter is a base64 whitespace. Only carriage return or line feed
-//      is valid whitespace.
-// Arguments:
-// - ch - Character to check.
-// Return Value:
-// - true iff ch is a carriage return or line feed.
-constexpr bool Base64::s_IsSpace(const wchar_t ch) noexcept
+catch (...)
 {
-    return ch == L'\r' || ch == L'\n';
+    return _Fail();
 }
@@ -21,5 +21,48 @@ namespace Microsoft::Console::VirtualTerminal
 
     private:
         static constexpr bool s_IsSpace(const wchar_t ch) noexcept;
+
+        friend class Base64Decoder;
+    };
+
+    // Decodes a base64 string that arrives in pieces, like the payload of an
+    // OSC 52 sequence while it's being parsed, so that the encoded form never
+    // has to be buffered. The decoded bytes are UTF-8, which is converted to
+    // UTF-16 as it arrives. It follows the same rules as Base64::s_Decode.
+    class Base64Decoder
+    {
+    public:
+        explicit Base64Decoder(const size_t maxSize = SIZE_MAX) noexcept;
+
+        void Reset() noexcept;
+        bool Append(const std::wstring_view src) noexcept;
+        bool Finish(std::wstring& dst) noexcept;
+
+    private:
+        enum class Padding
+        {
+            None,
+            ExpectingSecond,
+            Complete
+        };
+
+        bool _Fail() noexcept;
+        bool _Flush(const bool final) noexcept;
+
+        // The maximum number of decoded UTF-8 bytes.
+        size_t _maxSize;
+        size_t _inputSize{ 0 };
+        size_t _decodedSize{ 0 };
+        bool _failed{ false };
+
+        // The state of the current, incomplete base64 quantum.
+        int _state{ 0 };
+        char _pending{ 0 };
+        Padding _padding{ Padding::None };
+
+        // Decoded bytes that haven't been converted yet. Only an incomplete
+        // UTF-8 sequence is ever kept here between calls.
+        std::string _bytes;
+        std::wstring _result;
     };
 }
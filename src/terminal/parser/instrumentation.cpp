@@ -0,0 +1,327 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "instrumentation.hpp"
+
+using namespace Microsoft::Console::VirtualTerminal;
+
+std::atomic<bool> ParserInstrumentation::s_enabled{ false };
+
+namespace
+{
+    using Family = ParserInstrumentation::Family;
+    using Snapshot = ParserInstrumentation::Snapshot;
+    using Counter = std::atomic<uint64_t>;
+    using CounterHistogram = std::array<Counter, ParserInstrumentation::HistogramBuckets>;
+
+    // The counters of a single thread. Only the owning thread ever writes to
+    // them, so a relaxed load and store is enough to update them, and other
+    // threads can still read them safely while taking a snapshot.
+    struct ThreadCounters
+    {
+        struct FamilyCounters
+        {
+            Counter count{ 0 };
+            Counter nanoseconds{ 0 };
+            CounterHistogram durationHistogram{};
+        };
+
+        std::array<FamilyCounters, ParserInstrumentation::FamilyCount> families{};
+        Counter charactersParsed{ 0 };
+        Counter printRuns{ 0 };
+        Counter printedCharacters{ 0 };
+        CounterHistogram printRunHistogram{};
+    };
+
+    void _Add(Counter& counter, const uint64_t value) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    void _Accumulate(ParserInstrumentation::Histogram& total, const CounterHistogram& counters) noexcept
+    {
+        for (size_t i = 0; i < total.size(); i++)
+        {
+            total.at(i) += counters.at(i).load(std::memory_order_relaxed);
+        }
+    }
+
+    void _Accumulate(Snapshot& total, const ThreadCounters& counters) noexcept
+    {
+        for (size_t i = 0; i < total.families.size(); i++)
+        {
+            auto& family = total.families.at(i);
+            const auto& familyCounters = counters.families.at(i);
+            family.count += familyCounters.count.load(std::memory_order_relaxed);
+            family.nanoseconds += familyCounters.nanoseconds.load(std::memory_order_relaxed);
+            _Accumulate(family.durationHistogram, familyCounters.durationHistogram);
+        }
+        total.charactersParsed += counters.charactersParsed.load(std::memory_order_relaxed);
+        total.printRuns += counters.printRuns.load(std::memory_order_relaxed);
+        total.printedCharacters += counters.printedCharacters.load(std::memory_order_relaxed);
+        _Accumulate(total.printRunHistogram, counters.printRunHistogram);
+    }
+
+    void _Clear(CounterHistogram& counters) noexcept
+    {
+        for (auto& counter : counters)
+        {
+            counter.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void _Clear(ThreadCounters& counters) noexcept
+    {
+        for (auto& family : counters.families)
+        {
+            family.count.store(0, std::memory_order_relaxed);
+            family.nanoseconds.store(0, std::memory_order_relaxed);
+            _Clear(family.durationHistogram);
+        }
+        counters.charactersParsed.store(0, std::memory_order_relaxed);
+        counters.printRuns.store(0, std::memory_order_relaxed);
+        counters.printedCharacters.store(0, std::memory_order_relaxed);
+        _Clear(counters.printRunHistogram);
+    }
+
+    // Keeps track of the counters of every live thread, plus the totals of the
+    // threads that have already exited.
+    struct Registry
+    {
+        std::mutex lock;
+        std::vector<std::shared_ptr<ThreadCounters>> threads;
+        Snapshot retired;
+    };
+
+    Registry& _GetRegistry()
+    {
+        // This is intentionally leaked, so that threads exiting during process
+        // shutdown can still retire their counters.
+        static auto registry = new Registry();
+        return *registry;
+    }
+
+    // Registers the counters of the current thread on first use, and folds
+    // them into the retired totals when the thread exits.
+    struct ThreadSlot
+    {
+        ThreadSlot() :
+            counters{ std::make_shared<ThreadCounters>() }
+        {
+            auto& registry = _GetRegistry();
+            const std::lock_guard guard{ registry.lock };
+            registry.threads.emplace_back(counters);
+        }
+
+        ~ThreadSlot()
+        {
+            auto& registry = _GetRegistry();
+            const std::lock_guard guard{ registry.lock };
+            _Accumulate(registry.retired, *counters);
+            const auto it = std::find(registry.threads.begin(), registry.threads.end(), counters);
+            if (it != registry.threads.end())
+            {
+                registry.threads.erase(it);
+            }
+        }
+
+        ThreadSlot(const ThreadSlot&) = delete;
+        ThreadSlot(ThreadSlot&&) = delete;
+        ThreadSlot& operator=(const ThreadSlot&) = delete;
+        ThreadSlot& operator=(ThreadSlot&&) = delete;
+
+        std::shared_ptr<ThreadCounters> counters;
+    };
+
+    ThreadCounters& _GetThreadCounters()
+    {
+        static thread_local ThreadSlot slot;
+        return *slot.counters;
+    }
+}
+
+// Routine Description:
+// - Turns the collection of parser counters on or off for the whole process.
+//   Counters that were already collected are kept.
+// Arguments:
+// - enabled - true to start collecting counters.
+// Return Value:
+// - <none>
+void ParserInstrumentation::SetEnabled(const bool enabled) noexcept
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// Routine Description:
+// - Adds the given number of characters to the count of characters that were
+//   handed to the parser on this thread.
+// - Only called by RecordCharactersParsed, when instrumentation is enabled.
+// Arguments:
+// - count - The number of characters parsed.
+// Return Value:
+// - <none>
+void ParserInstrumentation::_RecordCharactersParsed(const size_t count) noexcept
+try
+{
+    _Add(_GetThreadCounters().charactersParsed, count);
+}
+CATCH_LOG()
+
+// Routine Description:
+// - Records a run of printable characters that was dispatched to the engine
+//   in one piece.
+// - Only called by RecordPrintRun, when instrumentation is enabled.
+// Arguments:
+// - length - The number of characters in the run.
+// Return Value:
+// - <none>
+void ParserInstrumentation::_RecordPrintRun(const size_t length) noexcept
+try
+{
+    auto& counters = _GetThreadCounters();
+    _Add(counters.printRuns, 1);
+    _Add(counters.printedCharacters, length);
+    _Add(counters.printRunHistogram.at(HistogramBucket(length)), 1);
+}
+CATCH_LOG()
+
+// Routine Description:
+// - Records a dispatch and the time it took.
+// - Only called by DispatchScope, when instrumentation was enabled at the
+//   start of the dispatch.
+// Arguments:
+// - family - The kind of action that was dispatched.
+// - elapsed - How long the dispatch took.
+// Return Value:
+// - <none>
+void ParserInstrumentation::_RecordDispatch(const Family family, const std::chrono::steady_clock::duration elapsed) noexcept
+try
+{
+    const auto nanoseconds = gsl::narrow_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    auto& counters = _GetThreadCounters().families.at(static_cast<size_t>(family));
+    _Add(counters.count, 1);
+    _Add(counters.nanoseconds, nanoseconds);
+    _Add(counters.durationHistogram.at(HistogramBucket(nanoseconds)), 1);
+}
+CATCH_LOG()
+
+// Routine Description:
+// - Merges the counters of every thread that has recorded any, including the
+//   ones that have since exited, into a single set of statistics.
+// - Threads may be recording while the snapshot is taken, so the numbers of
+//   different counters may be off by the few events that were in flight.
+// Arguments:
+// - <none>
+// Return Value:
+// - The statistics collected since the process started or since Reset.
+ParserInstrumentation::Snapshot ParserInstrumentation::GetSnapshot()
+{
+    auto& registry = _GetRegistry();
+    const std::lock_guard guard{ registry.lock };
+
+    auto snapshot = registry.retired;
+    for (const auto& counters : registry.threads)
+    {
+        _Accumulate(snapshot, *counters);
+    }
+    return snapshot;
+}
+
+// Routine Description:
+// - Clears the counters of every thread.
+// - Events that are recorded concurrently with the reset may survive it.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void ParserInstrumentation::Reset()
+{
+    auto& registry = _GetRegistry();
+    const std::lock_guard guard{ registry.lock };
+
+    registry.retired = {};
+    for (const auto& counters : registry.threads)
+    {
+        _Clear(*counters);
+    }
+}
+
+// Routine Description:
+// - Formats the given statistics as a human readable multi-line report.
+// Arguments:
+// - snapshot - The statistics to format.
+// Return Value:
+// - The report, with lines separated by CRLF.
+std::wstring ParserInstrumentation::FormatSnapshot(const Snapshot& snapshot)
+{
+    static constexpr std::array<std::wstring_view, FamilyCount> familyNames{
+        L"Execute",
+        L"Print",
+        L"PrintString",
+        L"Esc",
+        L"Vt52",
+        L"Csi",
+        L"Osc",
+        L"Ss3",
+        L"Dcs",
+        L"PassThrough",
+    };
+
+    const auto formatHistogram = [](fmt::wmemory_buffer& buffer, const Histogram& histogram) {
+        for (size_t i = 0; i < histogram.size(); i++)
+        {
+            if (histogram.at(i) != 0)
+            {
+                const uint64_t upper = i == 0 ? 0 : (1ull << i) - 1;
+                fmt::format_to(buffer, FMT_STRING(L" [<={}]={}"), upper, histogram.at(i));
+            }
+        }
+    };
+
+    fmt::wmemory_buffer buffer;
+    fmt::format_to(buffer,
+                   FMT_STRING(L"characters parsed: {}\r\nprint runs: {} ({} characters)\r\n  run lengths:"),
+                   snapshot.charactersParsed,
+                   snapshot.printRuns,
+                   snapshot.printedCharacters);
+    formatHistogram(buffer, snapshot.printRunHistogram);
+    fmt::format_to(buffer, FMT_STRING(L"\r\n"));
+
+    for (size_t i = 0; i < FamilyCount; i++)
+    {
+        const auto& family = snapshot.families.at(i);
+        if (family.count == 0)
+        {
+            continue;
+        }
+
+        fmt::format_to(buffer,
+                       FMT_STRING(L"{}: {} dispatches, {} ns total, {} ns average\r\n  durations (ns):"),
+                       familyNames.at(i),
+                       family.count,
+                       family.nanoseconds,
+                       family.nanoseconds / family.count);
+        formatHistogram(buffer, family.durationHistogram);
+        fmt::format_to(buffer, FMT_STRING(L"\r\n"));
+    }
+
+    return fmt::to_string(buffer);
+}
+
+// Routine Description:
+// - Finds the histogram bucket that counts the given value.
+// Arguments:
+// - value - The value to count.
+// Return Value:
+// - The index of the bucket: the number of significant bits of the value,
+//   capped to the last bucket.
+size_t ParserInstrumentation::HistogramBucket(const uint64_t value) noexcept
+{
+    size_t bits = 0;
+    for (auto remaining = value; remaining != 0 && bits < HistogramBuckets - 1; remaining >>= 1)
+    {
+        bits++;
+    }
+    return bits;
+}
@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+/*
+Module Name:
+- instrumentation.hpp
+
+Abstract:
+- This module collects performance counters for the virtual terminal parser:
+  how many sequences of each family were dispatched and how long they took,
+  how many characters were parsed and how long the print runs were.
+- Unlike the ETW events in tracing.hpp, these counters can be queried from
+  inside the process (for benchmarks, tests or a debug view).
+- Counters are kept per thread and are only merged when a snapshot is taken,
+  so recording never contends with other threads. While instrumentation is
+  disabled (the default) recording costs a single relaxed load.
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+
+namespace Microsoft::Console::VirtualTerminal
+{
+    class ParserInstrumentation sealed
+    {
+    public:
+        // The kinds of actions the state machine hands to its engine.
+        enum class Family : size_t
+        {
+            Execute = 0,
+            Print,
+            PrintString,
+            Esc,
+            Vt52,
+            Csi,
+            Osc,
+            Ss3,
+            Dcs,
+            PassThrough,
+            // Only use this last enum as a count of the number of families.
+            NUMBER_OF_FAMILIES
+        };
+
+        static constexpr size_t FamilyCount = static_cast<size_t>(Family::NUMBER_OF_FAMILIES);
+
+        // Histograms use power-of-two buckets: bucket 0 counts zeros, bucket
+        // N counts values in [2^(N-1), 2^N), and the last bucket also
+        // collects everything larger.
+        static constexpr size_t HistogramBuckets = 32;
+        using Histogram = std::array<uint64_t, HistogramBuckets>;
+
+        struct FamilyStatistics
+        {
+            uint64_t count = 0;
+            uint64_t nanoseconds = 0;
+            Histogram durationHistogram{};
+        };
+
+        struct Snapshot
+        {
+            std::array<FamilyStatistics, FamilyCount> families{};
+            uint64_t charactersParsed = 0;
+            uint64_t printRuns = 0;
+            uint64_t printedCharacters = 0;
+            Histogram printRunHistogram{};
+        };
+
+        // A DispatchScope measures a single dispatch to the engine, from its
+        // construction until its destruction.
+        class DispatchScope
+        {
+        public:
+            explicit DispatchScope(const Family family) noexcept :
+                _family{ family },
+                _enabled{ IsEnabled() }
+            {
+                if (_enabled)
+                {
+                    _start = std::chrono::steady_clock::now();
+                }
+            }
+
+            ~DispatchScope()
+            {
+                if (_enabled)
+                {
+                    _RecordDispatch(_family, std::chrono::steady_clock::now() - _start);
+                }
+            }
+
+            DispatchScope(const DispatchScope&) = delete;
+            DispatchScope(DispatchScope&&) = delete;
+            DispatchScope& operator=(const DispatchScope&) = delete;
+            DispatchScope& operator=(DispatchScope&&) = delete;
+
+        private:
+            const Family _family;
+            const bool _enabled;
+            std::chrono::steady_clock::time_point _start;
+        };
+
+        static void SetEnabled(const bool enabled) noexcept;
+        static bool IsEnabled() noexcept
+        {
+            return s_enabled.load(std::memory_order_relaxed);
+        }
+
+        // The Record* functions are called for every chunk of text the parser
+        // sees, so only the check whether they're enabled is inlined.
+        static void RecordCharactersParsed(const size_t count) noexcept
+        {
+            if (IsEnabled())
+            {
+                _RecordCharactersParsed(count);
+            }
+        }
+
+        static void RecordPrintRun(const size_t length) noexcept
+        {
+            if (IsEnabled())
+            {
+                _RecordPrintRun(length);
+            }
+        }
+
+        static Snapshot GetSnapshot();
+        static void Reset();
+        static std::wstring FormatSnapshot(const Snapshot& snapshot);
+
+        static size_t HistogramBucket(const uint64_t value) noexcept;
+
+    private:
+        static void _RecordCharactersParsed(const size_t count) noexcept;
+        static void _RecordPrintRun(const size_t length) noexcept;
+        static void _RecordDispatch(const Family family, const std::chrono::steady_clock::duration elapsed) noexcept;
+
+        static std::atomic<bool> s_enabled;
+    };
+}
@@ -6,6 +6,11 @@
 #include "stateMachine.hpp"
 
 #include "ascii.hpp"
+#include "instrumentation.hpp"
+
+#if defined(_M_IX86) || defined(_M_X64)
+#include <intrin.h>
+#endif
 
 using namespace Microsoft::Console::VirtualTerminal;
 
@@ -300,6 +305,59 @@ static constexpr bool _isOscTerminator(const wchar_t wch) noexcept
     return wch == AsciiChars::BEL; // Bell character
 }
 
+// Routine Description:
+// - Measures the run of characters at the start of a data string that can be
+//   collected without any further parsing. The run ends at the first
+//   character outside of [first, last] or at the first C1 control character,
+//   since those can terminate or interrupt the string.
+// - Data strings like OSC 52 clipboard contents can be megabytes long, so on
+//   x86/x64 the characters are checked 8 at a time with SSE2.
+// Arguments:
+// - string - The characters to scan.
+// - first - The lowest character that belongs to the run.
+// - last - The highest character that belongs to the run.
+// Return Value:
+// - The number of characters at the start of the string that belong to the run.
+static size_t _scanDataStringRun(const std::wstring_view string, const wchar_t first, const wchar_t last) noexcept
+{
+    const auto size = string.size();
+    size_t i = 0;
+
+#if defined(_M_IX86) || defined(_M_X64)
+    // A character is in [lo, lo + span] iff the saturating subtraction of the
+    // span from (ch - lo) is zero, with both operations done on unsigned shorts.
+    const auto zero = _mm_setzero_si128();
+    const auto runFirst = _mm_set1_epi16(static_cast<short>(first));
+    const auto runSpan = _mm_set1_epi16(static_cast<short>(last - first));
+    const auto c1First = _mm_set1_epi16(static_cast<short>(L'\x80'));
+    const auto c1Span = _mm_set1_epi16(static_cast<short>(L'\x9F' - L'\x80'));
+    for (; i + 8 <= size; i += 8)
+    {
+#pragma warning(suppress : 26490) // Don't use reinterpret_cast (type.1).
+        const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(string.data() + i));
+        const auto inRun = _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(chars, runFirst), runSpan), zero);
+        const auto isC1 = _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(chars, c1First), c1Span), zero);
+        const auto mask = static_cast<unsigned long>(_mm_movemask_epi8(_mm_andnot_si128(isC1, inRun)));
+        if (mask != 0xFFFF)
+        {
+            unsigned long index;
+            _BitScanForward(&index, ~mask);
+            return i + index / 2;
+        }
+    }
+#endif
+
+    for (; i < size; i++)
+    {
+        const auto wch = til::at(string, i);
+        if (wch < first || wch > last || _isC1ControlCharacter(wch))
+        {
+            break;
+        }
+    }
+    return i;
+}
+
 // Routine Description:
 // - Determines if a character is "device control string" beginning
 //      indicator.
@@ -383,6 +441,7 @@ static constexpr bool _isActionableFromGround(const wchar_t wch) noexcept
 void StateMachine::_ActionExecute(const wchar_t wch)
 {
     _trace.TraceOnExecute(wch);
+    const ParserInstrumentation::DispatchScope measure{ ParserInstrumentation::Family::Execute };
     const bool success = _engine->ActionExecute(wch);
 
     // Trace the result.
@@ -401,6 +460,7 @@ void StateMachine::_ActionExecuteFromEscape(const wchar_t wch)
 {
     _trace.TraceOnExecuteFromEscape(wch);
 
+    const ParserInstrumentation::DispatchScope measure{ ParserInstrumentation::Family::Execute };
     const bool success = _engine->ActionExecuteFromEscape(wch);
 
     // Trace the result.
@@ -417,6 +477,7 @@ void StateMachine::_ActionPrint(const wchar_t wch)
 {
     _trace.TraceOnAction(L"Print");
 
+    const ParserInstrumentation::DispatchScope measure{ ParserInstrumentation::Family::Print };
     const bool success = _engine->ActionPrint(wch);
 
     // Trace the result.
@@ -434,6 +495,7 @@ void StateMachine::_ActionEscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"EscDispatch");
 
+    const ParserInstrumentation::DispatchScope measure{ ParserInstrumentation::Family::Esc };
     const bool success = _engine->ActionEscDispatch(_identifier.Finalize(wch));
 
     // Trace the result.
@@ -457,6 +519,7 @@ void StateMachine::_ActionVt52EscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"Vt52EscDispatch");
 
+    const ParserInstrumentation::DispatchScope measure{ ParserInstrumentation::Family::Vt52 };
     const bool success = _engine->ActionVt52EscDispatch(_identifier.Finalize(wch),
                                                         { _parameters.data(), _parameters.size() });
 
@@ -481,6 +544,7 @@ void StateMachine::_ActionCsiDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"CsiDispatch");
 
+    const ParserInstrumentation::DispatchScope measure{ ParserInstrumentation::Family::Csi };
     const bool success = _engine->ActionCsiDispatch(_identifier.Finalize(wch),
                                                     { _parameters.data(), _parameters.size() });
 
@@ -575,6 +639,7 @@ void StateMachine::_ActionClear()
 
     _oscString.clear();
     _oscParameter = 0;
+    _oscStringHandler = nullptr;
 
     _dcsStringHandler = nullptr;
 
@@ -606,7 +671,8 @@ void StateMachine::_ActionInterrupt()
     if (_state == VTStates::DcsPassThrough)
     {
         // The ESC signals the end of the data string.
-        _dcsStringHandler(AsciiChars::ESC);
+        static constexpr wchar_t esc = AsciiChars::ESC;
+        _dcsStringHandler({ &esc, 1 });
         _dcsStringHandler = nullptr;
     }
 }
@@ -634,7 +700,14 @@ void StateMachine::_ActionOscPut(const wchar_t wch)
 {
     _trace.TraceOnAction(L"OscPut");
 
-    _oscString.push_back(wch);
+    if (_oscStringHandler)
+    {
+        _oscStringHandler({ &wch, 1 });
+    }
+    else
+    {
+        _oscString.push_back(wch);
+    }
 }
 
 // Routine Description:
@@ -648,7 +721,9 @@ void StateMachine::_ActionOscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"OscDispatch");
 
+    const ParserInstrumentation::DispatchScope measure{ ParserInstrumentation::Family::Osc };
     const bool success = _engine->ActionOscDispatch(wch, _oscParameter, _oscString);
+    _oscStringHandler = nullptr;
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -671,6 +746,7 @@ void StateMachine::_ActionSs3Dispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"Ss3Dispatch");
 
+    const ParserInstrumentation::DispatchScope measure{ ParserInstrumentation::Family::Ss3 };
     const bool success = _engine->ActionSs3Dispatch(wch, { _parameters.data(), _parameters.size() });
 
     // Trace the result.
@@ -694,6 +770,7 @@ void StateMachine::_ActionDcsDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"DcsDispatch");
 
+    const ParserInstrumentation::DispatchScope measure{ ParserInstrumentation::Family::Dcs };
     _dcsStringHandler = _engine->ActionDcsDispatch(_identifier.Finalize(wch),
                                                    { _parameters.data(), _parameters.size() });
 
@@ -729,6 +806,18 @@ void StateMachine::_EnterGround() noexcept
 {
     _state = VTStates::Ground;
     _cachedSequence.reset(); // entering ground means we've completed the pending sequence
+
+    // If the engine is still being handed an OSC string, that string was
+    // abandoned (by a CAN, SUB or ResetState). Let the engine drop it.
+    if (_oscStringHandler)
+    {
+        _oscStringHandler = nullptr;
+        try
+        {
+            _engine->ActionClear();
+        }
+        CATCH_LOG();
+    }
     _trace.TraceStateChange(L"Ground");
 }
 
@@ -1325,7 +1414,7 @@ void StateMachine::_EventCsiParam(const wchar_t wch)
 // - wch - Character that triggered the event
 // Return Value:
 // - <none>
-void StateMachine::_EventOscParam(const wchar_t wch) noexcept
+void StateMachine::_EventOscParam(const wchar_t wch)
 {
     _trace.TraceOnEvent(L"OscParam");
     if (_isOscTerminator(wch))
@@ -1339,6 +1428,9 @@ void StateMachine::_EventOscParam(const wchar_t wch) noexcept
     else if (_isOscDelimiter(wch))
     {
         _EnterOscString();
+        // The engine may want to consume the string as it arrives, rather than
+        // having us collect all of it first.
+        _oscStringHandler = _engine->ActionOscStringStart(_oscParameter);
     }
     else
     {
@@ -1678,7 +1770,7 @@ void StateMachine::_EventDcsPassThrough(const wchar_t wch)
     _trace.TraceOnEvent(L"DcsPassThrough");
     if (_isC0Code(wch) || _isDcsPassThroughValid(wch))
     {
-        if (!_dcsStringHandler(wch))
+        if (!_dcsStringHandler({ &wch, 1 }))
         {
             _EnterDcsIgnore();
         }
@@ -1703,6 +1795,59 @@ void StateMachine::_EventSosPmApcString(const wchar_t /*wch*/) noexcept
     _ActionIgnore();
 }
 
+// Routine Description:
+// - Handles the run of ordinary data characters at the start of the given
+//   string in one go, if the state machine is collecting an OSC, DCS or
+//   SOS/PM/APC data string. This is equivalent to passing every character to
+//   ProcessCharacter, but the OSC string is appended to and the DCS string
+//   handler is called once per run rather than once per character.
+// - The run stops before any control character, which is then left to the
+//   regular state machine.
+// Arguments:
+// - string - The remaining characters to process.
+// Return Value:
+// - The number of characters that were consumed. Zero if the state machine
+//   isn't collecting a data string, or the string starts with a control character.
+size_t StateMachine::_ProcessStringRun(const std::wstring_view string)
+{
+    size_t length = 0;
+    switch (_state)
+    {
+    case VTStates::OscString:
+        length = _scanDataStringRun(string, AsciiChars::SPC, L'\xFFFF');
+        if (length != 0)
+        {
+            _trace.TraceOnAction(L"OscPut");
+            if (_oscStringHandler)
+            {
+                _oscStringHandler(string.substr(0, length));
+            }
+            else
+            {
+                _oscString.append(string.substr(0, length));
+            }
+        }
+        break;
+    case VTStates::DcsPassThrough:
+        length = _scanDataStringRun(string, AsciiChars::SPC, L'\x7E');
+        if (length != 0 && !_dcsStringHandler(string.substr(0, length)))
+        {
+            _EnterDcsIgnore();
+        }
+        break;
+    case VTStates::SosPmApcString:
+        length = _scanDataStringRun(string, AsciiChars::SPC, L'\xFFFF');
+        if (length != 0)
+        {
+            _ActionIgnore();
+        }
+        break;
+    default:
+        break;
+    }
+    return length;
+}
+
 // Routine Description:
 // - Entry to the state machine. Takes characters one by one and processes them according to the state machine rules.
 // Arguments:
@@ -1808,6 +1953,7 @@ bool StateMachine::FlushToTerminal()
         // Flush the partial sequence to the terminal before we flush the rest of it.
         // We always want to clear the sequence, even if we failed, so we don't accumulate bad state
         // and dump it out elsewhere later.
+        const ParserInstrumentation::DispatchScope measure{ ParserInstrumentation::Family::PassThrough };
         success = _engine->ActionPassThroughString(*_cachedSequence);
         _cachedSequence.reset();
     }
@@ -1818,6 +1964,7 @@ bool StateMachine::FlushToTerminal()
         //      that pwchCurr was processed.
         // However, if we're here, then the processing of pwchChar triggered the
         //      engine to request the entire sequence get passed through, including pwchCurr.
+        const ParserInstrumentation::DispatchScope measure{ ParserInstrumentation::Family::PassThrough };
         success = _engine->ActionPassThroughString(_run);
     }
 
@@ -1835,6 +1982,8 @@ bool StateMachine::FlushToTerminal()
 // - <none>
 void StateMachine::ProcessString(const std::wstring_view string)
 {
+    ParserInstrumentation::RecordCharactersParsed(string.size());
+
     size_t start = 0;
     size_t current = start;
 
@@ -1847,6 +1996,15 @@ void StateMachine::ProcessString(const std::wstring_view string)
 
         if (_processingIndividually)
         {
+            // Data strings are collected a whole run at a time, rather than
+            // walking every character through the state machine.
+            const auto dataLength = _ProcessStringRun(string.substr(current));
+            if (dataLength != 0)
+            {
+                current += dataLength;
+                continue;
+            }
+
             // If we're processing characters individually, send it to the state machine.
             ProcessCharacter(string.at(current));
             ++current;
@@ -1867,6 +2025,8 @@ void StateMachine::ProcessString(const std::wstring_view string)
                     // and only pass through everything before it.
                     const auto allLeadingUpTo = _run.substr(0, _run.size() - 1);
 
+                    ParserInstrumentation::RecordPrintRun(allLeadingUpTo.size());
+                    const ParserInstrumentation::DispatchScope measure{ ParserInstrumentation::Family::PrintString };
                     _engine->ActionPrintString(allLeadingUpTo); // ... print all the chars leading up to it as part of the run...
                     _trace.DispatchPrintRunTrace(allLeadingUpTo);
                 }
@@ -1891,6 +2051,8 @@ void StateMachine::ProcessString(const std::wstring_view string)
     if (!_processingIndividually && !_run.empty())
     {
         // print the rest of the characters in the string
+        ParserInstrumentation::RecordPrintRun(_run.size());
+        const ParserInstrumentation::DispatchScope measure{ ParserInstrumentation::Family::PrintString };
         _engine->ActionPrintString(_run);
         _trace.DispatchPrintRunTrace(_run);
     }
@@ -1961,7 +2123,12 @@ void StateMachine::ProcessString(const std::wstring_view string)
             // If the engine doesn't require flushing at the end of the string, we
             // want to cache the partial sequence in case we have to flush the whole
             // thing to the terminal later.
-            _cachedSequence = _cachedSequence.value_or(std::wstring{}) + std::wstring{ _run };
+            // Append in place: a long OSC or DCS string can span many writes.
+            if (!_cachedSequence.has_value())
+            {
+                _cachedSequence.emplace();
+            }
+            _cachedSequence->append(_run);
         }
     }
 }
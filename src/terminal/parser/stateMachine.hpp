@@ -100,7 +100,7 @@ namespace Microsoft::Console::VirtualTerminal
         void _EventCsiIntermediate(const wchar_t wch);
         void _EventCsiIgnore(const wchar_t wch);
         void _EventCsiParam(const wchar_t wch);
-        void _EventOscParam(const wchar_t wch) noexcept;
+        void _EventOscParam(const wchar_t wch);
         void _EventOscString(const wchar_t wch);
         void _EventOscTermination(const wchar_t wch);
         void _EventSs3Entry(const wchar_t wch);
@@ -113,6 +113,8 @@ namespace Microsoft::Console::VirtualTerminal
         void _EventDcsPassThrough(const wchar_t wch);
         void _EventSosPmApcString(const wchar_t wch) noexcept;
 
+        size_t _ProcessStringRun(const std::wstring_view string);
+
         void _AccumulateTo(const wchar_t wch, size_t& value) noexcept;
 
         enum class VTStates
@@ -154,6 +156,7 @@ namespace Microsoft::Console::VirtualTerminal
 
         std::wstring _oscString;
         size_t _oscParameter;
+        IStateMachineEngine::StringHandler _oscStringHandler;
 
         IStateMachineEngine::StringHandler _dcsStringHandler;
 
@@ -7,6 +7,8 @@
 
 #include "base64.hpp"
 
+#include <chrono>
+
 using namespace WEX::Common;
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
@@ -98,4 +100,113 @@ class Microsoft::Console::VirtualTerminal::Base64Test
         VERIFY_ARE_EQUAL(true, success);
         VERIFY_ARE_EQUAL(L"👍👍🏻👍🏼👍🏽👍🏾👍🏿", result);
     }
+
+    TEST_METHOD(TestBase64DecoderSplitInput)
+    {
+        // U+306b U+307b U+3093 U+3054 U+6c49 U+8bed U+d55c U+ad6d, followed by a
+        // CRLF and padding, so that the input can be split inside a quantum, a
+        // UTF-8 sequence, the whitespace and the padding.
+        const std::wstring_view encoded{ L"44Gr44G744KT44GU5rGJ6K+t7ZWc6rWt\r\nZm9vYg==" };
+        const std::wstring_view expected{ L"にほんご汉语한국foob" };
+
+        Base64Decoder decoder;
+        for (size_t split = 0; split <= encoded.size(); split++)
+        {
+            std::wstring result;
+            VERIFY_IS_TRUE(decoder.Append(encoded.substr(0, split)));
+            VERIFY_IS_TRUE(decoder.Append(encoded.substr(split)));
+            VERIFY_IS_TRUE(decoder.Finish(result), NoThrowString().Format(L"split at %zu", split));
+            VERIFY_ARE_EQUAL(expected, std::wstring_view{ result });
+        }
+
+        Log::Comment(L"One character at a time should work as well.");
+        std::wstring result;
+        for (const auto ch : encoded)
+        {
+            VERIFY_IS_TRUE(decoder.Append({ &ch, 1 }));
+        }
+        VERIFY_IS_TRUE(decoder.Finish(result));
+        VERIFY_ARE_EQUAL(expected, std::wstring_view{ result });
+
+        Log::Comment(L"A missing padding character should be detected at the end.");
+        VERIFY_IS_TRUE(decoder.Append(L"Zm9vYg="));
+        VERIFY_IS_FALSE(decoder.Finish(result));
+
+        Log::Comment(L"Nothing but whitespace may follow the padding.");
+        VERIFY_IS_TRUE(decoder.Append(L"Zm9vYg=="));
+        VERIFY_IS_FALSE(decoder.Append(L"Zm9v"));
+        VERIFY_IS_FALSE(decoder.Finish(result));
+
+        Log::Comment(L"The decoder should be usable again after a failure.");
+        VERIFY_IS_TRUE(decoder.Append(L"Zm9v"));
+        VERIFY_IS_TRUE(decoder.Finish(result));
+        VERIFY_ARE_EQUAL(L"foo", result);
+    }
+
+    TEST_METHOD(TestBase64DecoderMaxSize)
+    {
+        std::wstring result;
+
+        Base64Decoder decoder{ 6 };
+        VERIFY_IS_TRUE(decoder.Append(L"Zm9v"));
+        VERIFY_IS_TRUE(decoder.Append(L"YmFy"));
+        VERIFY_IS_TRUE(decoder.Finish(result));
+        VERIFY_ARE_EQUAL(L"foobar", result);
+
+        VERIFY_IS_TRUE(decoder.Append(L"Zm9v"));
+        VERIFY_IS_TRUE(decoder.Append(L"YmFy"));
+        VERIFY_IS_FALSE(decoder.Append(L"Zg=="));
+        VERIFY_IS_FALSE(decoder.Finish(result));
+        VERIFY_ARE_EQUAL(L"foobar", result);
+    }
+
+    TEST_METHOD(TestBase64DecoderThroughput)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        // Encodes text the way an application would to copy a file with
+        // OSC 52, with a line break every 76 characters. A few MB are enough
+        // to see how the decoder scales, there's no need to go up to the
+        // 64MB limit of OSC 52.
+        static constexpr size_t maxSize = 4 * 1024 * 1024;
+        std::wstring encoded;
+        {
+            static constexpr std::wstring_view text{ L"The quick brown fox jumps over the lazy dog. " };
+            std::wstring line;
+            for (size_t i = 0; line.size() < 57; i++)
+            {
+                line.push_back(text.at(i % text.size()));
+            }
+            const auto encodedLine = Base64::s_Encode(line) + L"\r\n";
+            encoded.reserve(maxSize / 57 * encodedLine.size());
+            for (size_t size = 0; size < maxSize; size += line.size())
+            {
+                encoded.append(encodedLine);
+            }
+        }
+
+        for (size_t size = 1024; size <= maxSize; size *= 4)
+        {
+            const auto input = std::wstring_view{ encoded }.substr(0, size / 57 * 78);
+
+            // The payload is handed over in 4KB pieces, like the state machine would.
+            std::wstring result;
+            Base64Decoder decoder;
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t offset = 0; offset < input.size(); offset += 4096)
+            {
+                decoder.Append(input.substr(offset, 4096));
+            }
+            VERIFY_IS_TRUE(decoder.Finish(result));
+            const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            VERIFY_ARE_EQUAL(size / 57 * 57, result.size());
+            Log::Comment(NoThrowString().Format(L"%zu KB: %.3f ms (%.0f MB/s)",
+                                                size / 1024,
+                                                elapsed * 1000,
+                                                input.size() / 1048576.0 / elapsed));
+        }
+    }
 };
@@ -3287,6 +3287,45 @@ class StateMachineExternalTest final
         VERIFY_ARE_EQUAL(L"UNCHANGED", pDispatch->_copyContent);
 
         pDispatch->ClearState();
+
+        // The parameters are decoded as they arrive, so they may be split across writes anywhere.
+        mach.ProcessString(L"\x1b]52;s");
+        mach.ProcessString(L"0;Zm9vD");
+        mach.ProcessString(L"QpiYXI=\x1b");
+        mach.ProcessString(L"\\");
+        VERIFY_ARE_EQUAL(L"foo\r\nbar", pDispatch->_copyContent);
+
+        pDispatch->ClearState();
+    }
+
+    TEST_METHOD(TestAbandonedSetClipboard)
+    {
+        auto dispatch = std::make_unique<StatefulDispatch>();
+        auto pDispatch = dispatch.get();
+        auto engine = std::make_unique<OutputStateMachineEngine>(std::move(dispatch));
+        StateMachine mach(std::move(engine));
+
+        const auto abandon = [&](const std::wstring_view how, const auto& action) {
+            Log::Comment(NoThrowString().Format(L"Abandoning an OSC 52 sequence with %.*s", gsl::narrow_cast<int>(how.size()), how.data()));
+
+            pDispatch->_copyContent = L"UNCHANGED";
+            mach.ProcessString(L"\x1b]52;;Zm9v");
+            action();
+            VERIFY_ARE_EQUAL(L"UNCHANGED", pDispatch->_copyContent);
+
+            // Nothing of the abandoned string may end up in the next one.
+            mach.ProcessString(L"\x1b]52;c;\x07");
+            VERIFY_ARE_EQUAL(L"UNCHANGED", pDispatch->_copyContent);
+            mach.ProcessString(L"\x1b]52;c;YmFy\x07");
+            VERIFY_ARE_EQUAL(L"bar", pDispatch->_copyContent);
+        };
+
+        abandon(L"CAN", [&]() { mach.ProcessString(L"\x18"); });
+        abandon(L"SUB", [&]() { mach.ProcessString(L"\x1a"); });
+        abandon(L"ESC", [&]() { mach.ProcessString(L"\x1b[m"); });
+        abandon(L"ResetState", [&]() { mach.ResetState(); });
+
+        pDispatch->ClearState();
     }
 
     TEST_METHOD(TestAddHyperlink)
@@ -6,6 +6,7 @@
 #include "../../inc/consoletaeftemplates.hpp"
 
 #include "stateMachine.hpp"
+#include "instrumentation.hpp"
 
 using namespace WEX::Common;
 using namespace WEX::Logging;
@@ -38,6 +39,9 @@ public:
         dcsId = 0;
         dcsParams.clear();
         dcsDataString.clear();
+        dcsDataCalls = 0;
+        oscParameter = 0;
+        oscString.clear();
     }
 
     bool ActionExecute(const wchar_t wch) override
@@ -68,15 +72,19 @@ public:
 
     bool ActionIgnore() override { return true; };
 
+    IStateMachineEngine::StringHandler ActionOscStringStart(const size_t /* parameter */) override { return nullptr; };
+
     bool ActionOscDispatch(const wchar_t /* wch */,
-                           const size_t /* parameter */,
-                           const std::wstring_view /* string */) override
+                           const size_t parameter,
+                           const std::wstring_view string) override
     {
         if (pfnFlushToTerminal)
         {
             pfnFlushToTerminal();
             return true;
         }
+        oscParameter = parameter;
+        oscString = string;
         return true;
     };
 
@@ -115,7 +123,8 @@ public:
             dcsParams.push_back(parameters.at(i).value_or(0));
         }
         dcsDataString.clear();
-        return [=](const auto ch) { dcsDataString += ch; return true; };
+        dcsDataCalls = 0;
+        return [=](const auto data) { dcsDataString += data; dcsDataCalls++; return true; };
     }
 
     // These will only be populated if ActionCsiDispatch is called.
@@ -138,6 +147,11 @@ public:
     uint64_t dcsId = 0;
     std::vector<size_t> dcsParams;
     std::wstring dcsDataString;
+    size_t dcsDataCalls = 0;
+
+    // These will only be populated if ActionOscDispatch is called.
+    size_t oscParameter = 0;
+    std::wstring oscString;
 };
 
 class Microsoft::Console::VirtualTerminal::StateMachineTest
@@ -162,6 +176,13 @@ class Microsoft::Console::VirtualTerminal::StateMachineTest
     TEST_METHOD(PassThroughUnhandledSplitAcrossWrites);
 
     TEST_METHOD(DcsDataStringsReceivedByHandler);
+    TEST_METHOD(DataStringsCollectedInRuns);
+
+    BEGIN_TEST_METHOD(DataStringThroughput)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD()
+
+    TEST_METHOD(InstrumentationCountsDispatches);
 };
 
 void StateMachineTest::TwoStateMachinesDoNotInterfereWithEachother()
@@ -342,3 +363,154 @@ void StateMachineTest::DcsDataStringsReceivedByHandler()
     // Verify the control characters were executed (if expected).
     VERIFY_ARE_EQUAL(expectedExecuted, engine.executed);
 }
+
+void StateMachineTest::DataStringsCollectedInRuns()
+{
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    Log::Comment(L"An OSC string split across writes should be collected in full.");
+    machine.ProcessString(L"\x1b]52;c;SGVsbG8s");
+    machine.ProcessString(L"IFdvcmxkIQ==\x1b");
+    machine.ProcessString(L"\\after");
+    VERIFY_ARE_EQUAL(52u, engine.oscParameter);
+    VERIFY_ARE_EQUAL(L"c;SGVsbG8sIFdvcmxkIQ==", engine.oscString);
+    VERIFY_ARE_EQUAL(L"after", engine.printed);
+
+    Log::Comment(L"Invalid C0 controls inside an OSC string should still be dropped.");
+    engine.ResetTestState();
+    machine.ProcessString(L"\x1b]2;ab\x01cd\x7f\x00e9"
+                          L"f\x07");
+    VERIFY_ARE_EQUAL(2u, engine.oscParameter);
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"abcd\x7f\x00e9"
+                                        L"f" },
+                     std::wstring_view{ engine.oscString });
+
+    Log::Comment(L"A C1 control should terminate an OSC string.");
+    engine.ResetTestState();
+    machine.ProcessString(L"\x1b]0;title\x9c");
+    VERIFY_ARE_EQUAL(L"title", engine.oscString);
+
+    Log::Comment(L"A DCS data string should be handed over a run at a time.");
+    engine.ResetTestState();
+    machine.ProcessString(L"\x1bP1$r");
+    machine.ProcessString(L"first run\rsecond run\x1b\\");
+    VERIFY_ARE_EQUAL(VTID("$r"), engine.dcsId);
+    VERIFY_ARE_EQUAL(L"first run\rsecond run\x1b", engine.dcsDataString);
+    // "first run", "\r", "second run" and the terminating ESC.
+    VERIFY_ARE_EQUAL(4u, engine.dcsDataCalls);
+
+    Log::Comment(L"Characters outside of the DCS range should be ignored.");
+    engine.ResetTestState();
+    machine.ProcessString(L"\x1bPqab\x7f\x00e9"
+                          L"cd\x1b\\");
+    VERIFY_ARE_EQUAL(L"abcd\x1b", engine.dcsDataString);
+
+    Log::Comment(L"SOS, PM and APC strings should be ignored up to their terminator.");
+    engine.ResetTestState();
+    machine.ProcessString(L"\x1b_ignored\x1b[1mapc\x1b\\");
+    machine.ProcessString(L"\x1b^ignored\x18pm\x1bXignored\x9csos");
+    VERIFY_ARE_EQUAL(L"apcpmsos", engine.printed);
+    VERIFY_ARE_EQUAL(L"\x18", engine.executed);
+}
+
+void StateMachineTest::DataStringThroughput()
+{
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    // Sends the sequence through the state machine in 4KB writes, the way
+    // output arrives from a connection, and logs how long that took.
+    const auto measure = [&](const std::wstring_view name, const std::wstring_view sequence) {
+        static constexpr size_t writeSize = 4096;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t offset = 0; offset < sequence.size(); offset += writeSize)
+        {
+            machine.ProcessString(sequence.substr(offset, writeSize));
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const auto megabytes = sequence.size() * sizeof(wchar_t) / 1048576.0;
+        Log::Comment(NoThrowString().Format(L"%.*s: %.2f MB in %.2f ms (%.0f MB/s)",
+                                            gsl::narrow_cast<int>(name.size()),
+                                            name.data(),
+                                            megabytes,
+                                            elapsed * 1000,
+                                            megabytes / elapsed));
+    };
+
+    static constexpr size_t payloadSize = 4 * 1024 * 1024;
+    std::wstring payload;
+    payload.reserve(payloadSize);
+    static constexpr std::wstring_view base64Chars{ L"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/" };
+    for (size_t i = 0; i < payloadSize; i++)
+    {
+        payload.push_back(base64Chars.at(i % base64Chars.size()));
+    }
+
+    measure(L"OSC 52", L"\x1b]52;c;" + payload + L"\x1b\\");
+    VERIFY_ARE_EQUAL(52u, engine.oscParameter);
+    VERIFY_ARE_EQUAL(payloadSize + 2, engine.oscString.size());
+
+    measure(L"DCS", L"\x1bPq" + payload + L"\x1b\\");
+    VERIFY_ARE_EQUAL(payloadSize + 1, engine.dcsDataString.size());
+    // Every write should have been handed to the DCS handler in one call.
+    VERIFY_IS_LESS_THAN_OR_EQUAL(engine.dcsDataCalls, payloadSize / 4096 + 2);
+
+    measure(L"APC", L"\x1b_" + payload + L"\x1b\\");
+    VERIFY_ARE_EQUAL(L"", engine.printed);
+}
+
+void StateMachineTest::InstrumentationCountsDispatches()
+{
+    using Family = ParserInstrumentation::Family;
+
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    auto restoreEnabled = wil::scope_exit([wasEnabled = ParserInstrumentation::IsEnabled()]() {
+        ParserInstrumentation::SetEnabled(wasEnabled);
+    });
+
+    Log::Comment(L"Nothing should be recorded while instrumentation is disabled.");
+    ParserInstrumentation::SetEnabled(false);
+    ParserInstrumentation::Reset();
+    machine.ProcessString(L"Hello\x1b[1mWorld");
+    auto snapshot = ParserInstrumentation::GetSnapshot();
+    VERIFY_ARE_EQUAL(0u, snapshot.charactersParsed);
+    VERIFY_ARE_EQUAL(0u, snapshot.printRuns);
+
+    Log::Comment(L"Once enabled, every dispatch and print run should be counted.");
+    ParserInstrumentation::SetEnabled(true);
+    machine.ProcessString(L"Hello\x1b[1mWorld\r\n\x1b]0;title\x07");
+    snapshot = ParserInstrumentation::GetSnapshot();
+
+    VERIFY_ARE_EQUAL(L"HelloWorldHelloWorld", engine.printed);
+    VERIFY_ARE_EQUAL(26u, snapshot.charactersParsed);
+    VERIFY_ARE_EQUAL(2u, snapshot.printRuns);
+    VERIFY_ARE_EQUAL(10u, snapshot.printedCharacters);
+    // Both runs are 5 characters long, which lands them in the [4, 8) bucket.
+    VERIFY_ARE_EQUAL(2u, snapshot.printRunHistogram.at(3));
+
+    const auto familyCount = [&](const Family family) {
+        return snapshot.families.at(static_cast<size_t>(family)).count;
+    };
+    VERIFY_ARE_EQUAL(2u, familyCount(Family::PrintString));
+    VERIFY_ARE_EQUAL(1u, familyCount(Family::Csi));
+    VERIFY_ARE_EQUAL(1u, familyCount(Family::Osc));
+    VERIFY_ARE_EQUAL(2u, familyCount(Family::Execute));
+    VERIFY_ARE_EQUAL(0u, familyCount(Family::Dcs));
+
+    Log::Comment(L"Resetting should clear the counters.");
+    ParserInstrumentation::Reset();
+    snapshot = ParserInstrumentation::GetSnapshot();
+    VERIFY_ARE_EQUAL(0u, snapshot.charactersParsed);
+    VERIFY_ARE_EQUAL(0u, familyCount(Family::Csi));
+
+    Log::Comment(ParserInstrumentation::FormatSnapshot(snapshot).c_str());
+}
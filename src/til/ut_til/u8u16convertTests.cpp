@@ -17,6 +17,7 @@ class Utf8Utf16ConvertTests
     TEST_METHOD(TestU8ToU16Partials);
     TEST_METHOD(TestU16ToU8Partials);
     TEST_METHOD(TestU8ToU16OneByOne);
+    TEST_METHOD(TestU8StateRefersToInputWithoutPartials);
 };
 
 void Utf8Utf16ConvertTests::TestU8ToU16()
@@ -191,3 +192,34 @@ void Utf8Utf16ConvertTests::TestU8ToU16OneByOne()
     VERIFY_SUCCEEDED(til::u8u16(u8String1_4, u16Out1, state));
     VERIFY_ARE_EQUAL(u16StringComp1, u16Out1);
 }
+
+void Utf8Utf16ConvertTests::TestU8StateRefersToInputWithoutPartials()
+{
+    const std::string_view u8String1{
+        "\x41" // LATIN CAPITAL LETTER A
+        "\xE2" // WHITE SMILING FACE (lead byte)
+    };
+
+    const std::string_view u8String2{
+        "\x98\xBA" // WHITE SMILING FACE (complementary bytes)
+        "\x42" // LATIN CAPITAL LETTER B
+    };
+
+    til::u8state state{};
+    std::string_view out{};
+
+    Log::Comment(L"Without cached partials the result must refer to the input, minus the trailing partial.");
+    VERIFY_ARE_EQUAL(S_OK, state(u8String1, out));
+    VERIFY_IS_TRUE(u8String1.data() == out.data());
+    VERIFY_ARE_EQUAL(1u, out.size());
+
+    Log::Comment(L"With cached partials the result must be stitched together in the internal buffer.");
+    VERIFY_ARE_EQUAL(S_OK, state(u8String2, out));
+    VERIFY_IS_FALSE(u8String2.data() == out.data());
+    VERIFY_ARE_EQUAL(std::string_view{ "\xE2\x98\xBA\x42" }, out);
+
+    Log::Comment(L"Once the partials are consumed we must refer to the input again.");
+    VERIFY_ARE_EQUAL(S_OK, state(u8String2, out));
+    VERIFY_IS_TRUE(u8String2.data() == out.data());
+    VERIFY_ARE_EQUAL(u8String2.size(), out.size());
+}
@@ -555,19 +555,18 @@ std::wstring UiaTextRangeBase::_getTextValue(std::optional<unsigned int> maxLeng
         auto inclusiveEnd = _end;
         bufferSize.DecrementInBounds(inclusiveEnd, true);
 
-        const auto textRects = buffer.GetTextRects(_start, inclusiveEnd, _blockRange, true);
-        const auto bufferData = buffer.GetText(true,
-                                               false,
-                                               textRects);
-
-        const size_t textDataSize = base::ClampMul(bufferData.text.size(), bufferSize.Width());
-        textData.reserve(textDataSize);
-        for (const auto& text : bufferData.text)
-        {
-            textData += text;
-        }
+        // Screen readers frequently ask for the first few characters of huge
+        // ranges, so stream the text out of the buffer and stop at maxLength
+        // instead of materializing the whole range first.
+        textData = buffer.GetPlainText(_start,
+                                       inclusiveEnd,
+                                       _blockRange,
+                                       true,
+                                       maxLength.has_value() ? *maxLength : std::numeric_limits<size_t>::max());
     }
 
+    // Ranges shorter than maxLength have always been padded with NULs up to
+    // maxLength, and callers may rely on the length of the result.
     if (maxLength.has_value())
     {
         textData.resize(*maxLength);